@@ -22,8 +22,10 @@ import android.content.pm.PackageManager;
 import android.content.pm.PackageManager.NameNotFoundException;
 import android.graphics.Bitmap;
 import android.graphics.BitmapFactory;
+import android.graphics.Canvas;
 import android.graphics.Color;
 import android.graphics.Matrix;
+import android.graphics.Paint;
 import android.graphics.SurfaceTexture;
 import android.hardware.Sensor;
 import android.hardware.SensorEvent;
@@ -119,32 +121,47 @@ public class MainActivity extends AppCompatActivity {
   private final String FOV_SIDE_PACKET_TAG = "vertical_fov_radians";
   private final String ASPECT_RATIO_SIDE_PACKET_TAG = "aspect_ratio";
 
+  // Number of camera frames per frame analyzed for tracking. Analyzing every
+  // second or third frame saves tracking CPU, with stickers extrapolated in
+  // between.
+  private final int ANALYSIS_INTERVAL = 1;
+  private final String ANALYSIS_INTERVAL_SIDE_PACKET_TAG = "analysis_interval";
+
   private final String IMU_MATRIX_TAG = "imu_rotation_matrix";
   private final int SENSOR_SAMPLE_DELAY = SensorManager.SENSOR_DELAY_FASTEST;
   private float[] rotationMatrix = new float[9];
 
-  private final String STICKER_PROTO_TAG = "sticker_proto_string";
+  private final String STICKER_DELTA_TAG = "sticker_delta_string";
+  // Encodes only the sticker changes since the last frame for the graph
+  private final StickerDeltaEncoder stickerDeltaEncoder = new StickerDeltaEncoder();
   // Assets for object rendering
   // All animation assets and tags for the first asset (1)
-  // TODO: bitmaps are space heavy, try to use GpuBuffer directly with MediaPipe
-  private final String ASSET_3D_TEXTURE = "robot_texture.jpg";
-  private final String ASSET_3D_FILE = "robot.obj.uuu";
+  // The texture is ETC2 compressed at build time, and uploaded by the graph
+  private final String ASSET_3D_TEXTURE = "robot_texture.ktx";
+  private final String ASSET_3D_FILE = "robot.imta";
   private final String ASSET_3D_TEXTURE_TAG = "texture_3d";
   private final String ASSET_3D_TAG = "asset_3d";
-  private Bitmap asset3dTexture = null;
   // All GIF animation assets and tags
-  private final int GIF_FRAME_RATE = 20; // 20 FPS
   private final String GIF_ASPECT_RATIO_TAG = "gif_aspect_ratio";
   private final String DEFAULT_GIF_TEXTURE = "default_gif_texture.jpg";
-  private final String GIF_FILE = "gif.obj.uuu";
+  private final String GIF_FILE = "gif.imta";
   private final String GIF_TEXTURE_TAG = "gif_texture";
+  private final String GIF_TEXTURE_ATLAS_TAG = "gif_texture_atlas";
   private final String GIF_ASSET_TAG = "gif_asset_name";
+  // Largest GIF atlas dimension. This is the smallest GL_MAX_TEXTURE_SIZE that
+  // OpenGL ES 3.0 guarantees, which MediaPipe renders with where available.
+  // OpenGL ES 2.0 only guarantees 64, though 2048 is supported by practically
+  // every ES 2.0 device as well.
+  private final int MAX_GIF_ATLAS_SIZE = 2048;
   private GIFEditText editText;
-  private ArrayList<Bitmap> GIFBitmaps = new ArrayList<Bitmap>();
-  private int gifCurrentIndex = 0;
-  private long gifLastFrameUpdateMS = System.currentTimeMillis();
   private Bitmap defaultGIFTexture = null; // Texture sent if no gif available
-  private float gifAspectRatio = 1.0f; // GIF width:height
+  // GIF frames packed into a single texture, and their layout, waiting to be
+  // sent to the graph. The graph picks the frame to render by itself, so both
+  // are only sent when the GIF changes
+  private final Object gifLock = new Object();
+  private Bitmap pendingGIFTexture = null;
+  private StickerBuffer.TextureAtlas pendingGIFAtlas = null;
+  private volatile float gifAspectRatio = 1.0f; // GIF width:height
 
 
   @Override
@@ -203,7 +220,7 @@ public class MainActivity extends AppCompatActivity {
     // TODO: Should come from querying the video frame
     Map<String, Packet> inputSidePackets = new HashMap<>();
     inputSidePackets.put(ASSET_3D_TEXTURE_TAG,
-      packetCreator.createRgbaImageFrame(asset3dTexture));
+      packetCreator.createString(ASSET_3D_TEXTURE));
     inputSidePackets.put(ASSET_3D_TAG,
       packetCreator.createString(ASSET_3D_FILE));
     inputSidePackets.put(GIF_ASSET_TAG,
@@ -220,6 +237,9 @@ public class MainActivity extends AppCompatActivity {
         ASPECT_RATIO_SIDE_PACKET_TAG, packetCreator.createFloat32(ASPECT_RATIO));
     devicePropertiesSidePackets.put(
         FOV_SIDE_PACKET_TAG, packetCreator.createFloat32(VERTICAL_FOV_RADIANS));
+    devicePropertiesSidePackets.put(
+        ANALYSIS_INTERVAL_SIDE_PACKET_TAG,
+        packetCreator.createInt32(ANALYSIS_INTERVAL));
     processor.setInputSidePackets(devicePropertiesSidePackets);
 
     // Begin with 0 stickers in dataset
@@ -465,9 +485,8 @@ public class MainActivity extends AppCompatActivity {
     btn.setScaleType(ImageView.ScaleType.CENTER_INSIDE);
   }
 
-  // Used to set ArrayList of Bitmap frames
+  // Used to load the GIF frames into a texture atlas
   private void setGIFBitmaps(String gif_url) {
-    GIFBitmaps = new ArrayList<Bitmap>(); // Empty the bitmap array
     Glide.with(this)
         .asGif()
         .load(gif_url)
@@ -485,10 +504,7 @@ public class MainActivity extends AppCompatActivity {
                   Field decoder = frameLoader.getClass().getDeclaredField("gifDecoder");
                   decoder.setAccessible(true);
                   StandardGifDecoder GIFDecoder = (StandardGifDecoder) decoder.get(frameLoader);
-                  for (int i = 0; i < GIFDecoder.getFrameCount(); i++) {
-                    GIFDecoder.advance();
-                    GIFBitmaps.add(flipHorizontal(GIFDecoder.getNextFrame()));
-                  }
+                  setGIFAtlas(GIFDecoder);
                 } catch (Exception e) {
                   e.printStackTrace();
                 }
@@ -504,14 +520,52 @@ public class MainActivity extends AppCompatActivity {
     return Bitmap.createBitmap(bmp, 0, 0, bmp.getWidth(), bmp.getHeight(), matrix, true);
   }
 
-  // Function that is continuously called in order to time GIF frame updates
-  private void updateGIFFrame() {
-    long millisPerFrame = 1000 / GIF_FRAME_RATE;
-    if (System.currentTimeMillis() - gifLastFrameUpdateMS >= millisPerFrame) {
-      // Update GIF timestamp
-      gifLastFrameUpdateMS = System.currentTimeMillis();
-      // Cycle through every possible frame and avoid a divide by 0
-      gifCurrentIndex = (GIFBitmaps.size() == 0) ? 1 : (gifCurrentIndex + 1) % GIFBitmaps.size();
+  // Packs all GIF frames into a grid within a single bitmap, scaled down to fit
+  // in a texture if needed, along with their display durations
+  private void setGIFAtlas(StandardGifDecoder GIFDecoder) {
+    int frameCount = Math.max(GIFDecoder.getFrameCount(), 1);
+    int columns = (int) Math.ceil(Math.sqrt(frameCount));
+    int rows = (frameCount + columns - 1) / columns;
+    float scale =
+        Math.min(
+            1.0f,
+            Math.min(
+                (float) MAX_GIF_ATLAS_SIZE / (columns * GIFDecoder.getWidth()),
+                (float) MAX_GIF_ATLAS_SIZE / (rows * GIFDecoder.getHeight())));
+    int cellWidth = Math.max((int) (GIFDecoder.getWidth() * scale), 1);
+    int cellHeight = Math.max((int) (GIFDecoder.getHeight() * scale), 1);
+
+    Bitmap atlas =
+        Bitmap.createBitmap(columns * cellWidth, rows * cellHeight, Bitmap.Config.ARGB_8888);
+    Canvas canvas = new Canvas(atlas);
+    Paint paint = new Paint(Paint.FILTER_BITMAP_FLAG);
+    Matrix matrix = new Matrix();
+    StickerBuffer.TextureAtlas.Builder atlasBuilder =
+        StickerBuffer.TextureAtlas.newBuilder().setColumns(columns).setRows(rows);
+    for (int i = 0; i < GIFDecoder.getFrameCount(); i++) {
+      GIFDecoder.advance();
+      Bitmap frame = GIFDecoder.getNextFrame();
+      // Frames must be flipped horizontally due to native acquisition of frames
+      // from Android OS, which is done while drawing them into their cell
+      matrix.setScale(
+          -(float) cellWidth / frame.getWidth(), (float) cellHeight / frame.getHeight());
+      matrix.postTranslate((i % columns + 1) * cellWidth, (i / columns) * cellHeight);
+      canvas.drawBitmap(frame, matrix, paint);
+      atlasBuilder.addFrameDelayMs(GIFDecoder.getDelay(i));
+    }
+    setGIFTexture(
+        atlas,
+        atlasBuilder.build(),
+        (float) GIFDecoder.getWidth() / (float) GIFDecoder.getHeight());
+  }
+
+  // Queues a GIF texture and its atlas layout to be sent with the next frame
+  private void setGIFTexture(
+      Bitmap texture, StickerBuffer.TextureAtlas atlas, float aspectRatio) {
+    synchronized (gifLock) {
+      pendingGIFTexture = texture;
+      pendingGIFAtlas = atlas;
+      gifAspectRatio = aspectRatio;
     }
   }
 
@@ -626,15 +680,15 @@ public class MainActivity extends AppCompatActivity {
           flipHorizontal(
               BitmapFactory.decodeStream(inputStream, null /*outPadding*/, decodeOptions));
       inputStream.close();
-    } catch (Exception e) {
-      Log.e(TAG, "Error parsing object texture; error: " + e);
-      throw new IllegalStateException(e);
-    }
-
-    try {
-      InputStream inputStream = getAssets().open(ASSET_3D_TEXTURE);
-      asset3dTexture = BitmapFactory.decodeStream(inputStream, null /*outPadding*/, decodeOptions);
-      inputStream.close();
+      // A single frame atlas, shown until a GIF is loaded
+      setGIFTexture(
+          defaultGIFTexture,
+          StickerBuffer.TextureAtlas.newBuilder()
+              .setColumns(1)
+              .setRows(1)
+              .addFrameDelayMs(0)
+              .build(),
+          (float) defaultGIFTexture.getWidth() / (float) defaultGIFTexture.getHeight());
     } catch (Exception e) {
       Log.e(TAG, "Error parsing object texture; error: " + e);
       throw new IllegalStateException(e);
@@ -644,50 +698,58 @@ public class MainActivity extends AppCompatActivity {
   private class MediaPipePacketManager implements FrameProcessor.OnWillAddFrameListener {
     @Override
     public void onWillAddFrame(long timestamp) {
-      // set current GIF bitmap as default texture
-      Bitmap currentGIFBitmap = defaultGIFTexture;
-      // If current index is in bounds, display current frame
-      if (gifCurrentIndex <= GIFBitmaps.size() - 1)
-        currentGIFBitmap = GIFBitmaps.get(gifCurrentIndex);
-      // Update to next GIF frame based on timing and frame rate
-      updateGIFFrame();
-
-      // Calculate and set the aspect ratio of the GIF
-      gifAspectRatio = (float)currentGIFBitmap.getWidth() / (float)currentGIFBitmap.getHeight();
+      // Take the GIF texture atlas, if it changed since the last frame
+      Bitmap gifTexture;
+      StickerBuffer.TextureAtlas gifAtlas;
+      synchronized (gifLock) {
+        gifTexture = pendingGIFTexture;
+        gifAtlas = pendingGIFAtlas;
+        pendingGIFTexture = null;
+        pendingGIFAtlas = null;
+      }
 
       Packet stickerSentinelPacket = processor.getPacketCreator().createInt32(stickerSentinel);
       // Sticker sentinel value must be reset for next graph iteration
       stickerSentinel = -1;
-      // Initialize sticker data protobufferpacket information
-      Packet stickerProtoDataPacket =
+      // Initialize sticker delta protobuffer packet information
+      Packet stickerDeltaPacket =
           processor
               .getPacketCreator()
-              .createSerializedProto(Sticker.getMessageLiteData(stickerArrayList));
+              .createSerializedProto(stickerDeltaEncoder.getMessageLiteDelta(stickerArrayList));
       // Define and set the IMU sensory information float array
       Packet imuDataPacket = processor.getPacketCreator().createFloat32Array(rotationMatrix);
-      // Communicate GIF textures (dynamic texturing) to graph
-      Packet gifTexturePacket = processor.getPacketCreator().createRgbaImageFrame(currentGIFBitmap);
       Packet gifAspectRatioPacket = processor.getPacketCreator().createFloat32(gifAspectRatio);
       processor
           .getGraph()
           .addConsumablePacketToInputStream(STICKER_SENTINEL_TAG, stickerSentinelPacket, timestamp);
       processor
           .getGraph()
-          .addConsumablePacketToInputStream(STICKER_PROTO_TAG, stickerProtoDataPacket, timestamp);
+          .addConsumablePacketToInputStream(STICKER_DELTA_TAG, stickerDeltaPacket, timestamp);
       processor
           .getGraph()
           .addConsumablePacketToInputStream(IMU_MATRIX_TAG, imuDataPacket, timestamp);
-      processor
-          .getGraph()
-          .addConsumablePacketToInputStream(GIF_TEXTURE_TAG, gifTexturePacket, timestamp);
       processor
           .getGraph()
           .addConsumablePacketToInputStream(GIF_ASPECT_RATIO_TAG, gifAspectRatioPacket, timestamp);
       stickerSentinelPacket.release();
-      stickerProtoDataPacket.release();
+      stickerDeltaPacket.release();
       imuDataPacket.release();
-      gifTexturePacket.release();
       gifAspectRatioPacket.release();
+
+      // Communicate GIF textures (dynamic texturing) to graph, which animates
+      // them on its own
+      if (gifTexture != null) {
+        Packet gifTexturePacket = processor.getPacketCreator().createRgbaImageFrame(gifTexture);
+        Packet gifAtlasPacket = processor.getPacketCreator().createSerializedProto(gifAtlas);
+        processor
+            .getGraph()
+            .addConsumablePacketToInputStream(GIF_TEXTURE_TAG, gifTexturePacket, timestamp);
+        processor
+            .getGraph()
+            .addConsumablePacketToInputStream(GIF_TEXTURE_ATLAS_TAG, gifAtlasPacket, timestamp);
+        gifTexturePacket.release();
+        gifAtlasPacket.release();
+      }
     }
   }
 }
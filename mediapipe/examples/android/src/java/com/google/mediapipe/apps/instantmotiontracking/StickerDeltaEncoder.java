@@ -0,0 +1,102 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package com.google.mediapipe.apps.instantmotiontracking;
+
+import com.google.protobuf.MessageLite;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.Map;
+
+/**
+ * This class tracks the sticker data last sent to the MediaPipe graph and
+ * encodes only the changes since then as a StickerDelta protobuffer.
+ * <p>Every encoded delta carries the version of the sticker table it produces
+ * in the graph. The version is only incremented when a delta contains changes,
+ * so an empty delta can be sent on every frame at very little cost.
+ * <p>The full sticker set is sent every FULL_STATE_INTERVAL deltas, so that
+ * the graph recovers from a dropped or reordered delta within that many frames.
+ */
+public class StickerDeltaEncoder {
+
+  // Number of deltas between two full state deltas
+  private static final int FULL_STATE_INTERVAL = 30;
+
+  // Sticker data as of the last encoded delta, keyed by sticker ID
+  private final Map<Integer, StickerBuffer.Sticker> sentStickers =
+      new HashMap<Integer, StickerBuffer.Sticker>();
+  // Version of the sticker table as of the last encoded delta
+  private long version = 0;
+  // Number of deltas encoded since the last full state delta
+  private int deltasSinceFullState = FULL_STATE_INTERVAL;
+
+  /**
+   * This method compares an ArrayList of stickers with the sticker data that
+   * has already been sent and converts the differences to a MessageLite object
+   * which can be passed directly to the MediaPipe graph.
+   *
+   * @param stickerArrayList ArrayList of all current Sticker objects
+   * @return MessageLite protobuffer of all sticker changes
+   */
+  public MessageLite getMessageLiteDelta(ArrayList<Sticker> stickerArrayList) {
+    StickerBuffer.StickerDelta.Builder deltaBuilder =
+        StickerBuffer.StickerDelta.newBuilder();
+    Map<Integer, StickerBuffer.Sticker> currentStickers =
+        new HashMap<Integer, StickerBuffer.Sticker>();
+    for (final Sticker sticker : stickerArrayList) {
+      StickerBuffer.Sticker protoSticker =
+          StickerBuffer.Sticker.newBuilder()
+              .setId(sticker.getstickerId())
+              .setX(sticker.getAnchorX())
+              .setY(sticker.getAnchorY())
+              .setRotation(sticker.getRotation())
+              .setScale(sticker.getScaleFactor())
+              .setRenderID(sticker.getRender().ordinal())
+              .build();
+      currentStickers.put(protoSticker.getId(), protoSticker);
+      StickerBuffer.Sticker sentSticker = sentStickers.get(protoSticker.getId());
+      if (sentSticker == null) {
+        deltaBuilder.addAdded(protoSticker);
+      } else if (!sentSticker.equals(protoSticker)) {
+        deltaBuilder.addUpdated(protoSticker);
+      }
+    }
+    for (final int stickerId : sentStickers.keySet()) {
+      if (!currentStickers.containsKey(stickerId)) {
+        deltaBuilder.addRemovedId(stickerId);
+      }
+    }
+
+    if (++deltasSinceFullState >= FULL_STATE_INTERVAL) {
+      deltasSinceFullState = 0;
+      sentStickers.clear();
+      sentStickers.putAll(currentStickers);
+      return StickerBuffer.StickerDelta.newBuilder()
+          .setVersion(++version)
+          .setFullState(true)
+          .addAllAdded(currentStickers.values())
+          .build();
+    }
+
+    boolean hasChanges = deltaBuilder.getAddedCount() > 0
+        || deltaBuilder.getUpdatedCount() > 0
+        || deltaBuilder.getRemovedIdCount() > 0;
+    if (hasChanges) {
+      version++;
+      sentStickers.clear();
+      sentStickers.putAll(currentStickers);
+    }
+    return deltaBuilder.setVersion(version).build();
+  }
+}
@@ -0,0 +1,347 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/graphs/instantmotiontracking/calculators/animation_asset.h"
+
+#if defined(__ANDROID__)
+#include "mediapipe/util/android/asset_manager_util.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/port/singleton.h"
+
+namespace mediapipe {
+
+namespace {
+
+size_t AlignOffset(size_t offset) {
+  return (offset + kAnimationAssetAlignment - 1) /
+         kAnimationAssetAlignment * kAnimationAssetAlignment;
+}
+
+// Copies the next num_bytes of a legacy animation into output, if available.
+bool ReadLegacyBytes(const char* data, size_t size, size_t* offset,
+                     void* output, size_t num_bytes) {
+  if (size - *offset < num_bytes) {
+    return false;
+  }
+  std::memcpy(output, data + *offset, num_bytes);
+  *offset += num_bytes;
+  return true;
+}
+
+}  // namespace
+
+AssetFile::~AssetFile() {
+  if (release_) {
+    release_();
+  }
+}
+
+// static
+::mediapipe::StatusOr<std::unique_ptr<AssetFile>> AssetFile::Open(
+    const std::string& path) {
+  std::unique_ptr<AssetFile> file(new AssetFile());
+  file->path_ = path;
+#if defined(__ANDROID__)
+  AAssetManager* asset_manager =
+      Singleton<mediapipe::AssetManager>::get()->GetAssetManager();
+  if (!asset_manager) {
+    return ::mediapipe::InternalError(
+        "Failed to access Android asset manager.");
+  }
+  // AASSET_MODE_BUFFER memory-maps the asset if it is stored uncompressed.
+  AAsset* asset =
+      AAssetManager_open(asset_manager, path.c_str(), AASSET_MODE_BUFFER);
+  if (!asset) {
+    return ::mediapipe::NotFoundError(
+        absl::StrCat("Failed to open animation asset: ", path));
+  }
+  file->release_ = [asset]() { AAsset_close(asset); };
+  file->data_ = static_cast<const char*>(AAsset_getBuffer(asset));
+  file->size_ = AAsset_getLength(asset);
+  if (!file->data_) {
+    return ::mediapipe::InternalError(
+        absl::StrCat("Failed to read animation asset: ", path));
+  }
+#else
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return ::mediapipe::NotFoundError(
+        absl::StrCat("Failed to open animation asset: ", path));
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+    close(fd);
+    return ::mediapipe::InvalidArgumentError(
+        absl::StrCat("Empty or unreadable animation asset: ", path));
+  }
+  const size_t size = file_stat.st_size;
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    return ::mediapipe::InternalError(
+        absl::StrCat("Failed to map animation asset: ", path));
+  }
+  file->release_ = [mapping, size]() { munmap(mapping, size); };
+  file->data_ = static_cast<const char*>(mapping);
+  file->size_ = size;
+#endif
+  return file;
+}
+
+AnimationAsset::~AnimationAsset() {
+  if (release_) {
+    release_();
+  }
+}
+
+// static
+::mediapipe::StatusOr<std::unique_ptr<AnimationAsset>> AnimationAsset::Load(
+    const std::string& path) {
+  auto file = AssetFile::Open(path);
+  if (!file.ok()) {
+    return file.status();
+  }
+  return FromFile(std::move(file).ValueOrDie());
+}
+
+// static
+::mediapipe::StatusOr<std::unique_ptr<AnimationAsset>>
+AnimationAsset::FromFile(std::unique_ptr<AssetFile> file) {
+  const char* data = file->data();
+  const size_t size = file->size();
+  if (size >= sizeof(kAnimationAssetMagic) &&
+      std::memcmp(data, kAnimationAssetMagic, sizeof(kAnimationAssetMagic)) ==
+          0) {
+    AssetFile* mapped_file = file.release();
+    return FromBuffer(data, size, [mapped_file]() { delete mapped_file; });
+  }
+
+  // Not a binary asset, so fall back to converting a .obj.uuu animation.
+  LOG(WARNING) << "Converting legacy animation asset " << file->path()
+               << "; use animation_asset_converter to speed up loading.";
+  auto converted = ConvertLegacyAsset(data, size);
+  file.reset();
+  if (!converted.ok()) {
+    return converted.status();
+  }
+  auto* storage = new std::string(std::move(converted).ValueOrDie());
+  return FromBuffer(storage->data(), storage->size(),
+                    [storage]() { delete storage; });
+}
+
+// static
+::mediapipe::StatusOr<std::unique_ptr<AnimationAsset>>
+AnimationAsset::FromBuffer(const char* data, size_t size,
+                           std::function<void()> release) {
+  std::unique_ptr<AnimationAsset> asset(new AnimationAsset());
+  asset->data_ = data;
+  asset->size_ = size;
+  asset->release_ = std::move(release);
+
+  if (size < sizeof(AnimationAssetHeader) ||
+      std::memcmp(data, kAnimationAssetMagic, sizeof(kAnimationAssetMagic)) !=
+          0) {
+    return ::mediapipe::InvalidArgumentError("Not a binary animation asset.");
+  }
+  asset->header_ = reinterpret_cast<const AnimationAssetHeader*>(data);
+  const AnimationAssetHeader& header = *asset->header_;
+  if (header.version != kAnimationAssetVersion) {
+    return ::mediapipe::InvalidArgumentError(
+        absl::StrCat("Unsupported animation asset version ", header.version,
+                     "; expected ", kAnimationAssetVersion, "."));
+  }
+  if (header.frame_count == 0) {
+    return ::mediapipe::InvalidArgumentError(
+        "Animation asset contains no frames.");
+  }
+
+  // Make sure the frame table and all data referenced by it lie within the
+  // asset, so no further checks are needed while rendering.
+  const uint64 frames_end = sizeof(AnimationAssetHeader) +
+                            uint64{header.frame_count} *
+                                sizeof(AnimationAssetFrame);
+  const uint64 vertex_data_end =
+      header.vertex_data_offset +
+      uint64{header.vertex_count} * kAnimationVertexFloats * sizeof(float);
+  const uint64 index_data_end =
+      header.index_data_offset + uint64{header.index_count} * sizeof(uint16);
+  if (frames_end > header.vertex_data_offset ||
+      header.vertex_data_offset % kAnimationAssetAlignment != 0 ||
+      header.index_data_offset % kAnimationAssetAlignment != 0 ||
+      vertex_data_end > size || index_data_end > size) {
+    return ::mediapipe::InvalidArgumentError(
+        "Animation asset is truncated or corrupt.");
+  }
+  asset->frames_ = reinterpret_cast<const AnimationAssetFrame*>(
+      data + sizeof(AnimationAssetHeader));
+  const uint16* index_data = asset->index_data();
+  for (uint32 i = 0; i < header.frame_count; ++i) {
+    const AnimationAssetFrame& frame = asset->frames_[i];
+    if (uint64{frame.first_vertex} + frame.vertex_count > header.vertex_count ||
+        uint64{frame.first_index} + frame.index_count > header.index_count) {
+      return ::mediapipe::InvalidArgumentError(
+          absl::StrCat("Animation asset frame ", i, " is out of range."));
+    }
+    // Triangle indices are drawn relative to the frame's first vertex, so they
+    // must stay within its vertices too.
+    const uint16* frame_indices = index_data + frame.first_index;
+    for (uint32 j = 0; j < frame.index_count; ++j) {
+      if (frame_indices[j] >= frame.vertex_count) {
+        return ::mediapipe::InvalidArgumentError(absl::StrCat(
+            "Triangle index out of range in animation asset frame ", i, "."));
+      }
+    }
+  }
+  return asset;
+}
+
+// static
+::mediapipe::StatusOr<std::string> AnimationAsset::ConvertLegacyAsset(
+    const char* data, size_t size, NormalWeighting normal_weighting) {
+  std::vector<AnimationAssetFrame> frames;
+  std::vector<float> vertex_data;
+  std::vector<uint16> index_data;
+
+  std::vector<float> positions;
+  std::vector<float> texture_coords;
+  size_t offset = 0;
+  int32 lengths[3];
+  // Trailing bytes too short to hold another frame header are ignored, as they
+  // always have been.
+  while (ReadLegacyBytes(data, size, &offset, lengths, sizeof(lengths))) {
+    const int frame_index = frames.size();
+    if (lengths[0] < 0 || lengths[0] % 3 != 0 ||
+        lengths[1] != lengths[0] / 3 * 2 || lengths[2] < 0 ||
+        lengths[2] % 3 != 0) {
+      return ::mediapipe::InvalidArgumentError(
+          absl::StrCat("Invalid array sizes for frame ", frame_index));
+    }
+    AnimationAssetFrame frame;
+    frame.first_vertex = vertex_data.size() / kAnimationVertexFloats;
+    frame.vertex_count = lengths[0] / 3;
+    frame.first_index = index_data.size();
+    frame.index_count = lengths[2];
+
+    positions.resize(lengths[0]);
+    texture_coords.resize(lengths[1]);
+    index_data.resize(index_data.size() + lengths[2]);
+    if (!ReadLegacyBytes(data, size, &offset, positions.data(),
+                         sizeof(float) * lengths[0]) ||
+        !ReadLegacyBytes(data, size, &offset, texture_coords.data(),
+                         sizeof(float) * lengths[1]) ||
+        !ReadLegacyBytes(data, size, &offset, &index_data[frame.first_index],
+                         sizeof(uint16) * lengths[2])) {
+      return ::mediapipe::InvalidArgumentError(
+          absl::StrCat("Failed to read data for frame ", frame_index));
+    }
+    for (size_t i = frame.first_index; i < index_data.size(); ++i) {
+      if (index_data[i] >= frame.vertex_count) {
+        return ::mediapipe::InvalidArgumentError(absl::StrCat(
+            "Triangle index out of range in frame ", frame_index));
+      }
+    }
+
+    // Normals are filled in below, once all frames have been read.
+    vertex_data.resize(vertex_data.size() +
+                       frame.vertex_count * kAnimationVertexFloats);
+    float* vertex = &vertex_data[frame.first_vertex * kAnimationVertexFloats];
+    for (uint32 i = 0; i < frame.vertex_count;
+         ++i, vertex += kAnimationVertexFloats) {
+      for (int j = 0; j < 3; ++j) {
+        vertex[kAnimationVertexPositionOffset + j] = positions[i * 3 + j];
+      }
+      for (int j = 0; j < 2; ++j) {
+        vertex[kAnimationVertexTextureCoordOffset + j] =
+            texture_coords[i * 2 + j];
+      }
+    }
+    frames.push_back(frame);
+  }
+  if (frames.empty()) {
+    return ::mediapipe::InvalidArgumentError(
+        "No animation frames were parsed.");
+  }
+
+  // Compute the normals of all frames in parallel, straight into the
+  // interleaved vertex data.
+  std::vector<TriangleMeshView> meshes(frames.size());
+  for (size_t i = 0; i < frames.size(); ++i) {
+    float* first_vertex =
+        &vertex_data[frames[i].first_vertex * kAnimationVertexFloats];
+    TriangleMeshView& mesh = meshes[i];
+    mesh.positions = first_vertex + kAnimationVertexPositionOffset;
+    mesh.normals = first_vertex + kAnimationVertexNormalOffset;
+    mesh.vertex_count = frames[i].vertex_count;
+    mesh.vertex_stride = kAnimationVertexFloats;
+    mesh.indices = &index_data[frames[i].first_index];
+    mesh.index_count = frames[i].index_count;
+  }
+  ComputeVertexNormals(meshes, normal_weighting,
+                       std::max(1u, std::thread::hardware_concurrency()));
+
+  AnimationAssetHeader header;
+  std::memcpy(header.magic, kAnimationAssetMagic, sizeof(header.magic));
+  header.version = kAnimationAssetVersion;
+  header.frame_count = frames.size();
+  header.vertex_count = vertex_data.size() / kAnimationVertexFloats;
+  header.index_count = index_data.size();
+  header.vertex_data_offset =
+      AlignOffset(sizeof(AnimationAssetHeader) +
+                  frames.size() * sizeof(AnimationAssetFrame));
+  header.index_data_offset = AlignOffset(header.vertex_data_offset +
+                                         vertex_data.size() * sizeof(float));
+  header.reserved = 0;
+
+  std::string asset(
+      header.index_data_offset + index_data.size() * sizeof(uint16), '\0');
+  std::memcpy(&asset[0], &header, sizeof(header));
+  std::memcpy(&asset[sizeof(header)], frames.data(),
+              frames.size() * sizeof(AnimationAssetFrame));
+  std::memcpy(&asset[header.vertex_data_offset], vertex_data.data(),
+              vertex_data.size() * sizeof(float));
+  std::memcpy(&asset[header.index_data_offset], index_data.data(),
+              index_data.size() * sizeof(uint16));
+  return asset;
+}
+
+const float* AnimationAsset::vertex_data() const {
+  return reinterpret_cast<const float*>(data_ + header_->vertex_data_offset);
+}
+
+size_t AnimationAsset::vertex_data_size() const {
+  return header_->vertex_count * kAnimationVertexFloats * sizeof(float);
+}
+
+const uint16* AnimationAsset::index_data() const {
+  return reinterpret_cast<const uint16*>(data_ + header_->index_data_offset);
+}
+
+size_t AnimationAsset::index_data_size() const {
+  return header_->index_count * sizeof(uint16);
+}
+
+}  // namespace mediapipe
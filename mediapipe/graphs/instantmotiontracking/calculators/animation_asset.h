@@ -0,0 +1,149 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_ANIMATION_ASSET_H_
+#define MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_ANIMATION_ASSET_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "mediapipe/framework/port/integral_types.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/statusor.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/mesh_normals.h"
+
+namespace mediapipe {
+
+// Binary animation asset format, laid out so that it can be memory-mapped and
+// uploaded to the GPU without any parsing or copying. All values are stored
+// little-endian:
+//   AnimationAssetHeader
+//   AnimationAssetFrame[frame_count]
+//   Vertex data: vertex_count * kAnimationVertexFloats floats, interleaved per
+//     vertex as position (x, y, z), texture coordinate (u, v), normal (x, y, z)
+//   Index data: index_count uint16 triangle indices, relative to the first
+//     vertex of their frame
+// Vertex and index data both start on a kAnimationAssetAlignment boundary.
+// Assets are generated from .obj.uuu animations by animation_asset_converter.
+constexpr char kAnimationAssetMagic[4] = {'I', 'M', 'T', 'A'};
+constexpr uint32 kAnimationAssetVersion = 1;
+constexpr int kAnimationAssetAlignment = 16;
+
+// Interleaved vertex layout, in floats
+constexpr int kAnimationVertexPositionOffset = 0;
+constexpr int kAnimationVertexTextureCoordOffset = 3;
+constexpr int kAnimationVertexNormalOffset = 5;
+constexpr int kAnimationVertexFloats = 8;
+
+struct AnimationAssetHeader {
+  char magic[4];
+  uint32 version;
+  uint32 frame_count;
+  // Totals over all frames
+  uint32 vertex_count;
+  uint32 index_count;
+  // Byte offsets of the vertex and index data from the start of the asset
+  uint32 vertex_data_offset;
+  uint32 index_data_offset;
+  uint32 reserved;
+};
+
+struct AnimationAssetFrame {
+  uint32 first_vertex;
+  uint32 vertex_count;
+  uint32 first_index;
+  uint32 index_count;
+};
+
+// Read-only contents of an asset file, memory-mapped when possible.
+class AssetFile {
+ public:
+  ~AssetFile();
+
+  // Opens the file at path, which names an APK asset on Android.
+  static ::mediapipe::StatusOr<std::unique_ptr<AssetFile>> Open(
+      const std::string& path);
+
+  const std::string& path() const { return path_; }
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  AssetFile() = default;
+
+  std::string path_;
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  std::function<void()> release_;
+};
+
+// Read-only view of a binary animation asset. The frame table as well as the
+// vertex and index data point directly into the underlying storage, which is a
+// memory mapping of the file, or the asset buffer on Android, whenever the
+// asset is already in the binary format.
+class AnimationAsset {
+ public:
+  ~AnimationAsset();
+
+  // Loads the animation asset at path, which names an APK asset on Android.
+  // Animations still in the .obj.uuu format are detected and converted in
+  // memory, which is considerably slower.
+  static ::mediapipe::StatusOr<std::unique_ptr<AnimationAsset>> Load(
+      const std::string& path);
+
+  // Same as Load, for an already opened file. Binary assets keep referencing
+  // the file contents, while .obj.uuu animations are converted.
+  static ::mediapipe::StatusOr<std::unique_ptr<AnimationAsset>> FromFile(
+      std::unique_ptr<AssetFile> file);
+
+  // Wraps size bytes of a binary animation asset at data. release is called
+  // once the asset no longer references data, including on failure.
+  static ::mediapipe::StatusOr<std::unique_ptr<AnimationAsset>> FromBuffer(
+      const char* data, size_t size, std::function<void()> release);
+
+  // Converts the contents of a .obj.uuu animation into the binary format,
+  // computing smooth vertex normals for every frame in parallel. A .obj.uuu
+  // animation is a sequence of frames, each consisting of three int32 counts
+  // (vertex floats, texture coordinate floats and indices) followed by the
+  // float vertices, the float texture coordinates and the int16 triangle
+  // indices.
+  static ::mediapipe::StatusOr<std::string> ConvertLegacyAsset(
+      const char* data, size_t size,
+      NormalWeighting normal_weighting = NormalWeighting::kArea);
+
+  int frame_count() const { return header_->frame_count; }
+  const AnimationAssetFrame& frame(int i) const { return frames_[i]; }
+
+  // Interleaved vertex data of all frames, vertex_data_size() bytes long
+  const float* vertex_data() const;
+  size_t vertex_data_size() const;
+  // Triangle indices of all frames, index_data_size() bytes long
+  const uint16* index_data() const;
+  size_t index_data_size() const;
+
+ private:
+  AnimationAsset() = default;
+
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  const AnimationAssetHeader* header_ = nullptr;
+  const AnimationAssetFrame* frames_ = nullptr;
+  std::function<void()> release_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_ANIMATION_ASSET_H_
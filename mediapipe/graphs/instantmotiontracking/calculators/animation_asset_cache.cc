@@ -0,0 +1,193 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/graphs/instantmotiontracking/calculators/animation_asset_cache.h"
+
+#include <algorithm>
+
+#include "absl/hash/hash.h"
+#include "absl/strings/string_view.h"
+#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/port/status.h"
+
+namespace mediapipe {
+
+constexpr int64 AnimationAssetCache::kDefaultMemoryBudget;
+
+AnimationGpuBuffers::~AnimationGpuBuffers() {
+  std::shared_ptr<GlContext> context = context_.lock();
+  if (!context) {
+    return;
+  }
+  const GLuint buffers[] = {vertex_buffer_, index_buffer_};
+  context->Run([&buffers]() { glDeleteBuffers(2, buffers); });
+}
+
+::mediapipe::StatusOr<std::shared_ptr<const CachedAnimation>>
+AnimationAssetCache::Acquire(const std::string& path) {
+  auto file_or = AssetFile::Open(path);
+  if (!file_or.ok()) {
+    return file_or.status();
+  }
+  std::unique_ptr<AssetFile> file = std::move(file_or).ValueOrDie();
+  const size_t content_hash = absl::Hash<absl::string_view>()(
+      absl::string_view(file->data(), file->size()));
+
+  {
+    absl::MutexLock lock(&mutex_);
+    for (Entry& entry : entries_) {
+      if (entry.animation->path() == path &&
+          entry.animation->content_hash() == content_hash) {
+        entry.last_use = ++use_counter_;
+        return entry.animation;
+      }
+    }
+  }
+
+  // Loading can take a while for legacy assets, so it happens unlocked. Should
+  // two threads miss at once, the first one to finish wins.
+  auto asset_or = AnimationAsset::FromFile(std::move(file));
+  if (!asset_or.ok()) {
+    return asset_or.status();
+  }
+  auto animation = std::make_shared<const CachedAnimation>(
+      path, content_hash, std::move(asset_or).ValueOrDie());
+
+  std::vector<Entry> evicted;
+  absl::MutexLock lock(&mutex_);
+  for (Entry& entry : entries_) {
+    if (entry.animation->path() == path &&
+        entry.animation->content_hash() == content_hash) {
+      entry.last_use = ++use_counter_;
+      return entry.animation;
+    }
+  }
+  Entry entry;
+  entry.animation = animation;
+  entry.last_use = ++use_counter_;
+  entries_.push_back(std::move(entry));
+  TrimLocked(&evicted);
+  return animation;
+}
+
+::mediapipe::StatusOr<std::shared_ptr<const AnimationGpuBuffers>>
+AnimationAssetCache::GetBuffers(
+    const std::shared_ptr<const CachedAnimation>& animation,
+    GlContext* context) {
+  std::vector<Entry> evicted;
+  absl::MutexLock lock(&mutex_);
+  auto entry = std::find_if(entries_.begin(), entries_.end(),
+                            [&animation](const Entry& entry) {
+                              return entry.animation == animation;
+                            });
+  if (entry == entries_.end()) {
+    // Evicted in the meantime, which requires it to have been unused.
+    Entry new_entry;
+    new_entry.animation = animation;
+    entries_.push_back(std::move(new_entry));
+    entry = entries_.end() - 1;
+  }
+  entry->last_use = ++use_counter_;
+
+  // Buffers of destroyed contexts were deleted along with their context.
+  auto& gpu_buffers = entry->gpu_buffers;
+  gpu_buffers.erase(
+      std::remove_if(gpu_buffers.begin(), gpu_buffers.end(),
+                     [](const std::shared_ptr<const AnimationGpuBuffers>& b) {
+                       return b->context().expired();
+                     }),
+      gpu_buffers.end());
+  for (const auto& buffers : gpu_buffers) {
+    if (buffers->context().lock().get() == context) {
+      return buffers;
+    }
+  }
+
+  const AnimationAsset& asset = animation->asset();
+  GLuint buffer_names[2] = {0, 0};
+  glGenBuffers(2, buffer_names);
+  glBindBuffer(GL_ARRAY_BUFFER, buffer_names[0]);
+  glBufferData(GL_ARRAY_BUFFER, asset.vertex_data_size(), asset.vertex_data(),
+               GL_STATIC_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer_names[1]);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, asset.index_data_size(),
+               asset.index_data(), GL_STATIC_DRAW);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  if (!buffer_names[0] || !buffer_names[1]) {
+    glDeleteBuffers(2, buffer_names);
+    return ::mediapipe::InternalError("Problem creating animation buffers.");
+  }
+  auto buffers = std::make_shared<const AnimationGpuBuffers>(
+      context->shared_from_this(), buffer_names[0], buffer_names[1]);
+  gpu_buffers.push_back(buffers);
+  TrimLocked(&evicted);
+  return buffers;
+}
+
+void AnimationAssetCache::SetMemoryBudget(int64 bytes) {
+  std::vector<Entry> evicted;
+  absl::MutexLock lock(&mutex_);
+  memory_budget_ = bytes;
+  TrimLocked(&evicted);
+}
+
+void AnimationAssetCache::Trim() {
+  std::vector<Entry> evicted;
+  absl::MutexLock lock(&mutex_);
+  TrimLocked(&evicted);
+}
+
+// static
+size_t AnimationAssetCache::EntrySize(const Entry& entry) {
+  return entry.animation->data_size() * (1 + entry.gpu_buffers.size());
+}
+
+// static
+bool AnimationAssetCache::IsUnused(const Entry& entry) {
+  if (entry.animation.use_count() > 1) {
+    return false;
+  }
+  for (const auto& buffers : entry.gpu_buffers) {
+    if (buffers.use_count() > 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void AnimationAssetCache::TrimLocked(std::vector<Entry>* evicted) {
+  int64 total_size = 0;
+  for (const Entry& entry : entries_) {
+    total_size += EntrySize(entry);
+  }
+  while (total_size > memory_budget_) {
+    auto lru = entries_.end();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (IsUnused(*it) && (lru == entries_.end() ||
+                            it->last_use < lru->last_use)) {
+        lru = it;
+      }
+    }
+    if (lru == entries_.end()) {
+      break;
+    }
+    VLOG(1) << "Evicting animation asset " << lru->animation->path();
+    total_size -= EntrySize(*lru);
+    evicted->push_back(std::move(*lru));
+    entries_.erase(lru);
+  }
+}
+
+}  // namespace mediapipe
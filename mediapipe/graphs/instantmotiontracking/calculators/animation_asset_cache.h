@@ -0,0 +1,145 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_ANIMATION_ASSET_CACHE_H_
+#define MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_ANIMATION_ASSET_CACHE_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/port/integral_types.h"
+#include "mediapipe/framework/port/statusor.h"
+#include "mediapipe/gpu/gl_context.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/animation_asset.h"
+
+namespace mediapipe {
+
+// An animation asset loaded by the AnimationAssetCache.
+class CachedAnimation {
+ public:
+  CachedAnimation(std::string path, size_t content_hash,
+                  std::unique_ptr<AnimationAsset> asset)
+      : path_(std::move(path)),
+        content_hash_(content_hash),
+        asset_(std::move(asset)) {}
+
+  const std::string& path() const { return path_; }
+  // Hash of the file contents the asset was loaded from
+  size_t content_hash() const { return content_hash_; }
+  const AnimationAsset& asset() const { return *asset_; }
+  // Bytes of vertex and index data, both in memory and once uploaded
+  size_t data_size() const {
+    return asset_->vertex_data_size() + asset_->index_data_size();
+  }
+
+ private:
+  std::string path_;
+  size_t content_hash_;
+  std::unique_ptr<AnimationAsset> asset_;
+};
+
+// GPU vertex and index buffers holding all frames of a CachedAnimation, owned
+// by the GlContext they were uploaded in. They are deleted in that context on
+// destruction, unless the context is already gone along with its buffers.
+class AnimationGpuBuffers {
+ public:
+  AnimationGpuBuffers(std::weak_ptr<GlContext> context, GLuint vertex_buffer,
+                      GLuint index_buffer)
+      : context_(std::move(context)),
+        vertex_buffer_(vertex_buffer),
+        index_buffer_(index_buffer) {}
+  ~AnimationGpuBuffers();
+
+  AnimationGpuBuffers(const AnimationGpuBuffers&) = delete;
+  AnimationGpuBuffers& operator=(const AnimationGpuBuffers&) = delete;
+
+  const std::weak_ptr<GlContext>& context() const { return context_; }
+  GLuint vertex_buffer() const { return vertex_buffer_; }
+  GLuint index_buffer() const { return index_buffer_; }
+
+ private:
+  std::weak_ptr<GlContext> context_;
+  GLuint vertex_buffer_;
+  GLuint index_buffer_;
+};
+
+// Process-wide cache of animation assets and their GPU buffers, so that
+// calculator instances and graph runs using the same animation share a single
+// parsed copy, and a single upload per GlContext.
+//
+// Assets are keyed by path and content hash, so a file replaced on disk is
+// loaded again. Entries no longer referenced by anyone are kept around for
+// future graph runs, and evicted in least recently used order while the cache
+// holds more than its memory budget. Entries still in use are never evicted,
+// even if that exceeds the budget.
+//
+// Example usage:
+//   auto* cache = Singleton<AnimationAssetCache>::get();
+//   ASSIGN_OR_RETURN(auto animation, cache->Acquire(path));
+//   // Within the GlContext to render in:
+//   ASSIGN_OR_RETURN(auto buffers, cache->GetBuffers(animation, context));
+class AnimationAssetCache {
+ public:
+  static constexpr int64 kDefaultMemoryBudget = 64 << 20;
+
+  // Returns the animation at path, loading it on a cache miss. Opening the
+  // file and hashing its contents is all a cache hit costs.
+  ::mediapipe::StatusOr<std::shared_ptr<const CachedAnimation>> Acquire(
+      const std::string& path);
+
+  // Returns the GPU buffers of animation for context, which must be current,
+  // uploading them on a cache miss.
+  ::mediapipe::StatusOr<std::shared_ptr<const AnimationGpuBuffers>> GetBuffers(
+      const std::shared_ptr<const CachedAnimation>& animation,
+      GlContext* context);
+
+  // Sets the number of bytes of vertex and index data, in memory and on the
+  // GPU combined, that unused entries may keep, and evicts down to it.
+  void SetMemoryBudget(int64 bytes);
+
+  // Evicts unused entries while over the memory budget. Called whenever
+  // entries are added, and should be called after releasing them.
+  void Trim();
+
+ private:
+  struct Entry {
+    std::shared_ptr<const CachedAnimation> animation;
+    std::vector<std::shared_ptr<const AnimationGpuBuffers>> gpu_buffers;
+    int64 last_use = 0;
+  };
+
+  // Bytes held by entry, in memory and on the GPU
+  static size_t EntrySize(const Entry& entry);
+  // True if only the cache references entry
+  static bool IsUnused(const Entry& entry);
+
+  // Moves entries to evict out of the cache into evicted, so that they are
+  // destroyed once mutex_ is released. Deleting GPU buffers may need to wait
+  // for other GL threads, which in turn may be waiting for mutex_.
+  void TrimLocked(std::vector<Entry>* evicted)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  absl::Mutex mutex_;
+  std::vector<Entry> entries_ ABSL_GUARDED_BY(mutex_);
+  int64 memory_budget_ ABSL_GUARDED_BY(mutex_) = kDefaultMemoryBudget;
+  int64 use_counter_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_ANIMATION_ASSET_CACHE_H_
@@ -0,0 +1,57 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Converts a .obj.uuu animation into the binary animation asset format read by
+// GlAnimationOverlayCalculator, precomputing its vertex normals. Usage:
+//   animation_asset_converter --input_path=robot.obj.uuu
+//       --output_path=robot.imta
+
+#include <cstdlib>
+#include <string>
+
+#include "mediapipe/framework/port/commandlineflags.h"
+#include "mediapipe/framework/port/file_helpers.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/animation_asset.h"
+
+DEFINE_string(input_path, "", "Path of the .obj.uuu animation to convert.");
+DEFINE_string(output_path, "",
+              "Path to write the binary animation asset to.");
+DEFINE_bool(area_weighted_normals, true,
+            "Whether larger triangles contribute more to vertex normals.");
+
+::mediapipe::Status ConvertAnimationAsset() {
+  std::string legacy_contents;
+  MP_RETURN_IF_ERROR(
+      mediapipe::file::GetContents(FLAGS_input_path, &legacy_contents));
+  auto asset = mediapipe::AnimationAsset::ConvertLegacyAsset(
+      legacy_contents.data(), legacy_contents.size(),
+      FLAGS_area_weighted_normals ? mediapipe::NormalWeighting::kArea
+                                  : mediapipe::NormalWeighting::kUnweighted);
+  if (!asset.ok()) {
+    return asset.status();
+  }
+  return mediapipe::file::SetContents(FLAGS_output_path, asset.ValueOrDie());
+}
+
+int main(int argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  ::mediapipe::Status status = ConvertAnimationAsset();
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to convert animation asset: " << status.message();
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
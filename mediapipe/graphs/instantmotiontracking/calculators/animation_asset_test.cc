@@ -0,0 +1,107 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/graphs/instantmotiontracking/calculators/animation_asset.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/integral_types.h"
+
+namespace mediapipe {
+namespace {
+
+// Appends a .obj.uuu frame holding a single triangle with the given indices
+void AppendLegacyFrame(const std::vector<int16>& indices,
+                       std::string* legacy_asset) {
+  const int32 lengths[3] = {9, 6, static_cast<int32>(indices.size())};
+  const float positions[9] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+                              0.0f, 0.0f, 1.0f, 0.0f};
+  const float texture_coords[6] = {0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f};
+  legacy_asset->append(reinterpret_cast<const char*>(lengths),
+                       sizeof(lengths));
+  legacy_asset->append(reinterpret_cast<const char*>(positions),
+                       sizeof(positions));
+  legacy_asset->append(reinterpret_cast<const char*>(texture_coords),
+                       sizeof(texture_coords));
+  legacy_asset->append(reinterpret_cast<const char*>(indices.data()),
+                       indices.size() * sizeof(int16));
+}
+
+std::string ConvertTwoFrameAsset() {
+  std::string legacy_asset;
+  AppendLegacyFrame({0, 1, 2}, &legacy_asset);
+  AppendLegacyFrame({2, 1, 0}, &legacy_asset);
+  auto converted = AnimationAsset::ConvertLegacyAsset(legacy_asset.data(),
+                                                      legacy_asset.size());
+  EXPECT_TRUE(converted.ok()) << converted.status();
+  return std::move(converted).ValueOrDie();
+}
+
+TEST(AnimationAssetTest, LoadsConvertedAsset) {
+  const std::string buffer = ConvertTwoFrameAsset();
+  bool released = false;
+  auto asset = AnimationAsset::FromBuffer(buffer.data(), buffer.size(),
+                                          [&released]() { released = true; });
+  ASSERT_TRUE(asset.ok()) << asset.status();
+  {
+    std::unique_ptr<AnimationAsset> loaded = std::move(asset).ValueOrDie();
+    ASSERT_EQ(loaded->frame_count(), 2);
+    EXPECT_EQ(loaded->frame(1).first_vertex, 3u);
+    EXPECT_EQ(loaded->frame(1).vertex_count, 3u);
+    EXPECT_EQ(loaded->frame(1).first_index, 3u);
+    EXPECT_EQ(loaded->frame(1).index_count, 3u);
+    // Indices stay relative to the first vertex of their frame
+    EXPECT_EQ(loaded->index_data()[3], 2);
+    EXPECT_FALSE(released);
+  }
+  EXPECT_TRUE(released);
+}
+
+TEST(AnimationAssetTest, RejectsLegacyIndexOutOfRange) {
+  std::string legacy_asset;
+  AppendLegacyFrame({0, 1, 3}, &legacy_asset);
+  EXPECT_FALSE(AnimationAsset::ConvertLegacyAsset(legacy_asset.data(),
+                                                  legacy_asset.size())
+                   .ok());
+}
+
+TEST(AnimationAssetTest, RejectsBinaryIndexOutOfRange) {
+  std::string buffer = ConvertTwoFrameAsset();
+  AnimationAssetHeader header;
+  std::memcpy(&header, buffer.data(), sizeof(header));
+  // Points the first frame's last index at the first vertex of the second
+  // frame, which is within the asset's vertex data but past the vertices of
+  // the first frame.
+  const uint16 index = 3;
+  std::memcpy(&buffer[header.index_data_offset + 2 * sizeof(uint16)], &index,
+              sizeof(index));
+  bool released = false;
+  auto asset = AnimationAsset::FromBuffer(buffer.data(), buffer.size(),
+                                          [&released]() { released = true; });
+  EXPECT_FALSE(asset.ok());
+  EXPECT_TRUE(released);
+}
+
+TEST(AnimationAssetTest, RejectsTruncatedAsset) {
+  const std::string buffer = ConvertTwoFrameAsset();
+  auto asset = AnimationAsset::FromBuffer(buffer.data(), buffer.size() - 2,
+                                          []() {});
+  EXPECT_FALSE(asset.ok());
+}
+
+}  // namespace
+}  // namespace mediapipe
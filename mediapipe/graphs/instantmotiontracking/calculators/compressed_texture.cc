@@ -0,0 +1,674 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/graphs/instantmotiontracking/calculators/compressed_texture.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include "absl/strings/str_cat.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr uint8 kKtxIdentifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31,
+                                      0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+constexpr uint8 kKtx2Identifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                       0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+constexpr size_t kKtxHeaderSize = 64;
+constexpr uint32 kKtxEndianness = 0x04030201;
+// KTX2 header, followed by the index and the level index
+constexpr size_t kKtx2HeaderSize = 48;
+constexpr size_t kKtx2LevelIndexOffset = 80;
+constexpr size_t kKtx2LevelIndexEntrySize = 24;
+
+// Vulkan formats of KTX2 textures, sRGB variants being read as linear like
+// every other texture
+constexpr uint32 kVkFormatEtc2Rgb8Unorm = 147;
+constexpr uint32 kVkFormatEtc2Rgb8Srgb = 148;
+constexpr uint32 kVkFormatEtc2Rgba8Unorm = 151;
+constexpr uint32 kVkFormatEtc2Rgba8Srgb = 152;
+constexpr uint32 kVkFormatAstc4x4Unorm = 157;
+constexpr uint32 kVkFormatAstc12x12Srgb = 184;
+
+constexpr uint32 kGlRgb = 0x1907;
+constexpr uint32 kGlRgba = 0x1908;
+
+// Block dimensions of the ASTC formats, in OpenGL format order
+constexpr int kNumAstcFormats =
+    kGlCompressedRgbaAstc12x12 - kGlCompressedRgbaAstc4x4 + 1;
+constexpr int kAstcBlockWidths[kNumAstcFormats] = {4, 5, 5,  6,  6,  8,  8,
+                                                   8, 10, 10, 10, 10, 12, 12};
+constexpr int kAstcBlockHeights[kNumAstcFormats] = {4, 4, 5, 5, 6, 5, 6,
+                                                    8, 5, 6, 8, 10, 10, 12};
+
+// ETC blocks cover 4x4 pixels, indexed column by column
+constexpr int kEtcBlockSize = 4;
+constexpr int kEtcBlockPixels = 16;
+constexpr int kEtcColorBlockBytes = 8;
+constexpr int kEtcAlphaBlockBytes = 8;
+// Intensity modifiers of the individual and differential modes, as the
+// smaller and larger magnitude of each table. Pixel indices 0 to 3 select
+// +small, +large, -small and -large.
+constexpr int kEtcNumModifierTables = 8;
+constexpr int kEtcModifiers[kEtcNumModifierTables][2] = {
+    {2, 8},   {5, 17},  {9, 29},   {13, 42},
+    {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+// Distances of the T and H modes
+constexpr int kEtcDistances[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+// Alpha modifiers of EAC blocks, scaled by the block multiplier
+constexpr int kEacNumModifierTables = 16;
+constexpr int kEacModifiers[kEacNumModifierTables][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12}, {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11}, {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},  {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},  {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},  {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},   {-3, -5, -7, -9, 2, 4, 6, 8}};
+
+uint32 ReadLe32(const char* data) {
+  const uint8* bytes = reinterpret_cast<const uint8*>(data);
+  return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) |
+         (static_cast<uint32>(bytes[3]) << 24);
+}
+
+uint64 ReadLe64(const char* data) {
+  return ReadLe32(data) | (static_cast<uint64>(ReadLe32(data + 4)) << 32);
+}
+
+void AppendLe32(uint32 value, std::string* output) {
+  for (int i = 0; i < 4; ++i) {
+    output->push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+int Clamp255(int value) { return std::min(std::max(value, 0), 255); }
+
+int Extend4To8(int value) { return (value << 4) | value; }
+int Extend5To8(int value) { return (value << 3) | (value >> 2); }
+int Extend6To8(int value) { return (value << 2) | (value >> 4); }
+int Extend7To8(int value) { return (value << 1) | (value >> 6); }
+
+// Sign-extends the 3-bit differential color offset
+int SignExtend3(int value) { return (value & 0x4) ? value - 8 : value; }
+
+int EtcModifier(int table, int index) {
+  const int modifier = kEtcModifiers[table][index & 0x1];
+  return (index & 0x2) ? -modifier : modifier;
+}
+
+// Bytes per block and block dimensions of a compressed format, or false if
+// the format is not supported
+bool GetBlockLayout(uint32 gl_internal_format, int* block_bytes,
+                    int* block_width, int* block_height) {
+  if (gl_internal_format == kGlCompressedRgb8Etc2 ||
+      gl_internal_format == kGlCompressedRgba8Etc2Eac) {
+    *block_bytes = gl_internal_format == kGlCompressedRgb8Etc2
+                       ? kEtcColorBlockBytes
+                       : kEtcAlphaBlockBytes + kEtcColorBlockBytes;
+    *block_width = kEtcBlockSize;
+    *block_height = kEtcBlockSize;
+    return true;
+  }
+  if (gl_internal_format >= kGlCompressedRgbaAstc4x4 &&
+      gl_internal_format <= kGlCompressedRgbaAstc12x12) {
+    *block_bytes = 16;
+    *block_width = kAstcBlockWidths[gl_internal_format -
+                                    kGlCompressedRgbaAstc4x4];
+    *block_height = kAstcBlockHeights[gl_internal_format -
+                                      kGlCompressedRgbaAstc4x4];
+    return true;
+  }
+  return false;
+}
+
+uint32 GlFormatFromVkFormat(uint32 vk_format) {
+  if (vk_format == kVkFormatEtc2Rgb8Unorm ||
+      vk_format == kVkFormatEtc2Rgb8Srgb) {
+    return kGlCompressedRgb8Etc2;
+  }
+  if (vk_format == kVkFormatEtc2Rgba8Unorm ||
+      vk_format == kVkFormatEtc2Rgba8Srgb) {
+    return kGlCompressedRgba8Etc2Eac;
+  }
+  if (vk_format >= kVkFormatAstc4x4Unorm &&
+      vk_format <= kVkFormatAstc12x12Srgb) {
+    // Every block size comes as a UNORM and an sRGB format, in this order
+    return kGlCompressedRgbaAstc4x4 + (vk_format - kVkFormatAstc4x4Unorm) / 2;
+  }
+  return 0;
+}
+
+// Decodes the RGB of an ETC2 color block into the pixels of a 4x4 block,
+// indexed column by column
+void DecodeEtc2ColorBlock(const uint8* block, uint8 rgba[][4]) {
+  const uint32 msb_indices = (block[4] << 8) | block[5];
+  const uint32 lsb_indices = (block[6] << 8) | block[7];
+  const auto pixel_index = [msb_indices, lsb_indices](int k) {
+    return (((msb_indices >> k) & 0x1) << 1) | ((lsb_indices >> k) & 0x1);
+  };
+  const auto set_pixel = [rgba](int k, int r, int g, int b) {
+    rgba[k][0] = Clamp255(r);
+    rgba[k][1] = Clamp255(g);
+    rgba[k][2] = Clamp255(b);
+  };
+
+  const bool differential = block[3] & 0x2;
+  const bool flip = block[3] & 0x1;
+  int base_colors[2][3];
+  if (!differential) {
+    for (int c = 0; c < 3; ++c) {
+      base_colors[0][c] = Extend4To8(block[c] >> 4);
+      base_colors[1][c] = Extend4To8(block[c] & 0xF);
+    }
+  } else {
+    int colors[2][3];
+    bool overflow[3];
+    for (int c = 0; c < 3; ++c) {
+      colors[0][c] = block[c] >> 3;
+      colors[1][c] = colors[0][c] + SignExtend3(block[c] & 0x7);
+      overflow[c] = colors[1][c] < 0 || colors[1][c] > 31;
+    }
+
+    if (overflow[0]) {
+      // T mode
+      const int color1[3] = {
+          Extend4To8(((block[0] >> 1) & 0xC) | (block[0] & 0x3)),
+          Extend4To8(block[1] >> 4), Extend4To8(block[1] & 0xF)};
+      const int color2[3] = {Extend4To8(block[2] >> 4),
+                             Extend4To8(block[2] & 0xF),
+                             Extend4To8(block[3] >> 4)};
+      const int distance =
+          kEtcDistances[((block[3] >> 1) & 0x6) | (block[3] & 0x1)];
+      for (int k = 0; k < kEtcBlockPixels; ++k) {
+        const int index = pixel_index(k);
+        const int* color = index == 0 ? color1 : color2;
+        const int offset = index == 1 ? distance : index == 3 ? -distance : 0;
+        set_pixel(k, color[0] + offset, color[1] + offset, color[2] + offset);
+      }
+      return;
+    }
+
+    if (overflow[1]) {
+      // H mode
+      const int r1 = (block[0] >> 3) & 0xF;
+      const int g1 = ((block[0] & 0x7) << 1) | ((block[1] >> 4) & 0x1);
+      const int b1 = (block[1] & 0x8) | ((block[1] & 0x3) << 1) |
+                     (block[2] >> 7);
+      const int r2 = (block[2] >> 3) & 0xF;
+      const int g2 = ((block[2] & 0x7) << 1) | (block[3] >> 7);
+      const int b2 = (block[3] >> 3) & 0xF;
+      const int ordering =
+          ((r1 << 8) | (g1 << 4) | b1) >= ((r2 << 8) | (g2 << 4) | b2);
+      const int distance = kEtcDistances[(block[3] & 0x4) |
+                                         ((block[3] & 0x1) << 1) | ordering];
+      const int color1[3] = {Extend4To8(r1), Extend4To8(g1), Extend4To8(b1)};
+      const int color2[3] = {Extend4To8(r2), Extend4To8(g2), Extend4To8(b2)};
+      for (int k = 0; k < kEtcBlockPixels; ++k) {
+        const int index = pixel_index(k);
+        const int* color = index < 2 ? color1 : color2;
+        const int offset = (index & 0x1) ? -distance : distance;
+        set_pixel(k, color[0] + offset, color[1] + offset, color[2] + offset);
+      }
+      return;
+    }
+
+    if (overflow[2]) {
+      // Planar mode, interpolating the colors at the origin, the horizontal
+      // and the vertical corners of the block
+      const int origin[3] = {
+          Extend6To8((block[0] >> 1) & 0x3F),
+          Extend7To8(((block[0] & 0x1) << 6) | ((block[1] >> 1) & 0x3F)),
+          Extend6To8(((block[1] & 0x1) << 5) | (block[2] & 0x18) |
+                     ((block[2] & 0x3) << 1) | (block[3] >> 7))};
+      const int horizontal[3] = {
+          Extend6To8(((block[3] >> 1) & 0x3E) | (block[3] & 0x1)),
+          Extend7To8(block[4] >> 1),
+          Extend6To8(((block[4] & 0x1) << 5) | (block[5] >> 3))};
+      const int vertical[3] = {
+          Extend6To8(((block[5] & 0x7) << 3) | (block[6] >> 5)),
+          Extend7To8(((block[6] & 0x1F) << 2) | (block[7] >> 6)),
+          Extend6To8(block[7] & 0x3F)};
+      for (int x = 0; x < kEtcBlockSize; ++x) {
+        for (int y = 0; y < kEtcBlockSize; ++y) {
+          int color[3];
+          for (int c = 0; c < 3; ++c) {
+            color[c] = (x * (horizontal[c] - origin[c]) +
+                        y * (vertical[c] - origin[c]) + 4 * origin[c] + 2) >>
+                       2;
+          }
+          set_pixel(x * kEtcBlockSize + y, color[0], color[1], color[2]);
+        }
+      }
+      return;
+    }
+
+    for (int c = 0; c < 3; ++c) {
+      base_colors[0][c] = Extend5To8(colors[0][c]);
+      base_colors[1][c] = Extend5To8(colors[1][c]);
+    }
+  }
+
+  // Individual and differential modes share the subblock layout
+  const int tables[2] = {block[3] >> 5, (block[3] >> 2) & 0x7};
+  for (int x = 0; x < kEtcBlockSize; ++x) {
+    for (int y = 0; y < kEtcBlockSize; ++y) {
+      const int k = x * kEtcBlockSize + y;
+      const int subblock = flip ? (y >= 2) : (x >= 2);
+      const int modifier = EtcModifier(tables[subblock], pixel_index(k));
+      const int* color = base_colors[subblock];
+      set_pixel(k, color[0] + modifier, color[1] + modifier,
+                color[2] + modifier);
+    }
+  }
+}
+
+// Decodes an EAC alpha block into the pixels of a 4x4 block
+void DecodeEacAlphaBlock(const uint8* block, uint8 rgba[][4]) {
+  const int base = block[0];
+  const int multiplier = block[1] >> 4;
+  const int* modifiers = kEacModifiers[block[1] & 0xF];
+  uint64 indices = 0;
+  for (int i = 2; i < kEtcAlphaBlockBytes; ++i) {
+    indices = (indices << 8) | block[i];
+  }
+  for (int k = 0; k < kEtcBlockPixels; ++k) {
+    const int index = (indices >> (45 - 3 * k)) & 0x7;
+    rgba[k][3] = Clamp255(base + modifiers[index] * multiplier);
+  }
+}
+
+// Squared error of the RGB of a pixel against a color
+int ColorError(const uint8* pixel, int r, int g, int b) {
+  const int dr = pixel[0] - Clamp255(r);
+  const int dg = pixel[1] - Clamp255(g);
+  const int db = pixel[2] - Clamp255(b);
+  return dr * dr + dg * dg + db * db;
+}
+
+// Picks the modifier table and pixel indices best fitting the pixels of a
+// subblock to base_color, and returns their error
+int EncodeEtcSubblock(const uint8 pixels[][4], const int* ks, int num_pixels,
+                      const int base_color[3], int* table, int* indices) {
+  int best_error = std::numeric_limits<int>::max();
+  for (int t = 0; t < kEtcNumModifierTables; ++t) {
+    int error = 0;
+    int table_indices[kEtcBlockPixels / 2];
+    for (int i = 0; i < num_pixels; ++i) {
+      int best_pixel_error = std::numeric_limits<int>::max();
+      for (int index = 0; index < 4; ++index) {
+        const int modifier = EtcModifier(t, index);
+        const int pixel_error =
+            ColorError(pixels[ks[i]], base_color[0] + modifier,
+                       base_color[1] + modifier, base_color[2] + modifier);
+        if (pixel_error < best_pixel_error) {
+          best_pixel_error = pixel_error;
+          table_indices[i] = index;
+        }
+      }
+      error += best_pixel_error;
+    }
+    if (error < best_error) {
+      best_error = error;
+      *table = t;
+      std::copy(table_indices, table_indices + num_pixels, indices);
+    }
+  }
+  return best_error;
+}
+
+// Compresses the RGB of a 4x4 block into an ETC1 compatible ETC2 block, in
+// individual or differential mode, trying both subblock layouts
+void EncodeEtc2ColorBlock(const uint8 pixels[][4], uint8* block) {
+  int best_error = std::numeric_limits<int>::max();
+  for (int flip = 0; flip < 2; ++flip) {
+    int ks[2][kEtcBlockPixels / 2];
+    int num_pixels[2] = {0, 0};
+    float averages[2][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    for (int x = 0; x < kEtcBlockSize; ++x) {
+      for (int y = 0; y < kEtcBlockSize; ++y) {
+        const int k = x * kEtcBlockSize + y;
+        const int subblock = flip ? (y >= 2) : (x >= 2);
+        ks[subblock][num_pixels[subblock]++] = k;
+        for (int c = 0; c < 3; ++c) {
+          averages[subblock][c] += pixels[k][c] / 8.0f;
+        }
+      }
+    }
+
+    // Differential mode is more precise, as long as the averages are close
+    int quantized[2][3];
+    bool differential = true;
+    for (int c = 0; c < 3; ++c) {
+      quantized[0][c] = static_cast<int>(averages[0][c] * 31.0f / 255.0f + 0.5f);
+      quantized[1][c] = static_cast<int>(averages[1][c] * 31.0f / 255.0f + 0.5f);
+      const int difference = quantized[1][c] - quantized[0][c];
+      differential = differential && difference >= -4 && difference <= 3;
+    }
+    int base_colors[2][3];
+    for (int s = 0; s < 2; ++s) {
+      for (int c = 0; c < 3; ++c) {
+        if (!differential) {
+          quantized[s][c] =
+              static_cast<int>(averages[s][c] * 15.0f / 255.0f + 0.5f);
+        }
+        base_colors[s][c] = differential ? Extend5To8(quantized[s][c])
+                                         : Extend4To8(quantized[s][c]);
+      }
+    }
+
+    int tables[2];
+    int indices[2][kEtcBlockPixels / 2];
+    int error = 0;
+    for (int s = 0; s < 2; ++s) {
+      error += EncodeEtcSubblock(pixels, ks[s], num_pixels[s], base_colors[s],
+                                 &tables[s], indices[s]);
+    }
+    if (error >= best_error) {
+      continue;
+    }
+    best_error = error;
+
+    for (int c = 0; c < 3; ++c) {
+      block[c] = differential
+                     ? (quantized[0][c] << 3) |
+                           ((quantized[1][c] - quantized[0][c]) & 0x7)
+                     : (quantized[0][c] << 4) | quantized[1][c];
+    }
+    block[3] = (tables[0] << 5) | (tables[1] << 2) | (differential << 1) | flip;
+    uint32 msb_indices = 0;
+    uint32 lsb_indices = 0;
+    for (int s = 0; s < 2; ++s) {
+      for (int i = 0; i < num_pixels[s]; ++i) {
+        msb_indices |= ((indices[s][i] >> 1) & 0x1) << ks[s][i];
+        lsb_indices |= (indices[s][i] & 0x1) << ks[s][i];
+      }
+    }
+    block[4] = msb_indices >> 8;
+    block[5] = msb_indices & 0xFF;
+    block[6] = lsb_indices >> 8;
+    block[7] = lsb_indices & 0xFF;
+  }
+}
+
+// Compresses the alpha of a 4x4 block into an EAC block, fitting every
+// modifier table to the alpha range of the block
+void EncodeEacAlphaBlock(const uint8 pixels[][4], uint8* block) {
+  int min_alpha = 255;
+  int max_alpha = 0;
+  for (int k = 0; k < kEtcBlockPixels; ++k) {
+    min_alpha = std::min<int>(min_alpha, pixels[k][3]);
+    max_alpha = std::max<int>(max_alpha, pixels[k][3]);
+  }
+
+  int best_error = std::numeric_limits<int>::max();
+  for (int t = 0; t < kEacNumModifierTables; ++t) {
+    const int* modifiers = kEacModifiers[t];
+    const int min_modifier = *std::min_element(modifiers, modifiers + 8);
+    const int max_modifier = *std::max_element(modifiers, modifiers + 8);
+    const int fitted_multiplier =
+        (max_alpha - min_alpha + (max_modifier - min_modifier) / 2) /
+        (max_modifier - min_modifier);
+    for (int multiplier = std::max(fitted_multiplier - 1, 1);
+         multiplier <= std::min(fitted_multiplier + 1, 15); ++multiplier) {
+      const int base = Clamp255(
+          (min_alpha + max_alpha - (min_modifier + max_modifier) * multiplier +
+           1) /
+          2);
+      int error = 0;
+      uint64 indices = 0;
+      for (int k = 0; k < kEtcBlockPixels; ++k) {
+        int best_pixel_error = std::numeric_limits<int>::max();
+        int best_index = 0;
+        for (int index = 0; index < 8; ++index) {
+          const int difference =
+              pixels[k][3] - Clamp255(base + modifiers[index] * multiplier);
+          if (difference * difference < best_pixel_error) {
+            best_pixel_error = difference * difference;
+            best_index = index;
+          }
+        }
+        error += best_pixel_error;
+        indices |= static_cast<uint64>(best_index) << (45 - 3 * k);
+      }
+      if (error < best_error) {
+        best_error = error;
+        block[0] = base;
+        block[1] = (multiplier << 4) | t;
+        for (int i = 2; i < kEtcAlphaBlockBytes; ++i) {
+          block[i] = (indices >> (8 * (kEtcAlphaBlockBytes - 1 - i))) & 0xFF;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+// static
+::mediapipe::StatusOr<std::unique_ptr<CompressedTexture>>
+CompressedTexture::Load(const std::string& path) {
+  auto file = AssetFile::Open(path);
+  if (!file.ok()) {
+    return file.status();
+  }
+  return FromFile(std::move(file).ValueOrDie());
+}
+
+// static
+::mediapipe::StatusOr<std::unique_ptr<CompressedTexture>>
+CompressedTexture::FromFile(std::unique_ptr<AssetFile> file) {
+  std::unique_ptr<CompressedTexture> texture(new CompressedTexture());
+  const char* data = file->data();
+  const size_t size = file->size();
+  uint64 level_offset = 0;
+  uint64 level_size = 0;
+  uint32 depth = 0;
+  uint32 num_layers = 0;
+  uint32 num_faces = 0;
+  if (size >= kKtxHeaderSize &&
+      std::memcmp(data, kKtxIdentifier, sizeof(kKtxIdentifier)) == 0) {
+    if (ReadLe32(data + 12) != kKtxEndianness) {
+      return ::mediapipe::InvalidArgumentError(absl::StrCat(
+          "Big-endian KTX textures are not supported: ", file->path()));
+    }
+    if (ReadLe32(data + 16) != 0) {
+      return ::mediapipe::InvalidArgumentError(
+          absl::StrCat("KTX texture is not compressed: ", file->path()));
+    }
+    texture->gl_internal_format_ = ReadLe32(data + 28);
+    texture->width_ = ReadLe32(data + 36);
+    texture->height_ = ReadLe32(data + 40);
+    depth = ReadLe32(data + 44);
+    num_layers = ReadLe32(data + 48);
+    num_faces = ReadLe32(data + 52);
+    // The base level follows the key/value data, prefixed with its size
+    level_offset = kKtxHeaderSize + static_cast<uint64>(ReadLe32(data + 60));
+    if (level_offset + 4 > size) {
+      return ::mediapipe::InvalidArgumentError(
+          absl::StrCat("Truncated KTX texture: ", file->path()));
+    }
+    level_size = ReadLe32(data + level_offset);
+    level_offset += 4;
+  } else if (size >= kKtx2LevelIndexOffset + kKtx2LevelIndexEntrySize &&
+             std::memcmp(data, kKtx2Identifier, sizeof(kKtx2Identifier)) ==
+                 0) {
+    texture->gl_internal_format_ = GlFormatFromVkFormat(ReadLe32(data + 12));
+    texture->width_ = ReadLe32(data + 20);
+    texture->height_ = ReadLe32(data + 24);
+    depth = ReadLe32(data + 28);
+    num_layers = ReadLe32(data + 32);
+    num_faces = ReadLe32(data + 36);
+    if (ReadLe32(data + kKtx2HeaderSize - 4) != 0) {
+      return ::mediapipe::InvalidArgumentError(absl::StrCat(
+          "Supercompressed KTX2 textures are not supported: ", file->path()));
+    }
+    // Levels are indexed from the base level down
+    level_offset = ReadLe64(data + kKtx2LevelIndexOffset);
+    level_size = ReadLe64(data + kKtx2LevelIndexOffset + 8);
+  } else {
+    return ::mediapipe::InvalidArgumentError(
+        absl::StrCat("Not a KTX or KTX2 texture: ", file->path()));
+  }
+
+  if (depth > 1 || num_layers > 1 || num_faces != 1) {
+    return ::mediapipe::InvalidArgumentError(
+        absl::StrCat("KTX texture is not a 2D texture: ", file->path()));
+  }
+  int block_bytes = 0;
+  int block_width = 0;
+  int block_height = 0;
+  if (!GetBlockLayout(texture->gl_internal_format_, &block_bytes,
+                      &block_width, &block_height)) {
+    return ::mediapipe::InvalidArgumentError(
+        absl::StrCat("KTX texture is neither ETC2 nor ASTC: ", file->path()));
+  }
+  if (texture->width_ <= 0 || texture->height_ <= 0) {
+    return ::mediapipe::InvalidArgumentError(
+        absl::StrCat("KTX texture is empty: ", file->path()));
+  }
+  const uint64 expected_size =
+      static_cast<uint64>((texture->width_ + block_width - 1) / block_width) *
+      ((texture->height_ + block_height - 1) / block_height) * block_bytes;
+  if (level_size < expected_size || level_offset > size ||
+      size - level_offset < expected_size) {
+    return ::mediapipe::InvalidArgumentError(
+        absl::StrCat("Truncated KTX texture: ", file->path()));
+  }
+  texture->data_ = data + level_offset;
+  texture->size_ = expected_size;
+  texture->file_ = std::move(file);
+  return texture;
+}
+
+// static
+std::string CompressedTexture::SerializeKtx(uint32 gl_internal_format,
+                                            int width, int height,
+                                            const std::string& data) {
+  std::string ktx(reinterpret_cast<const char*>(kKtxIdentifier),
+                  sizeof(kKtxIdentifier));
+  AppendLe32(kKtxEndianness, &ktx);
+  // Compressed textures have no type, type size of 1 and no format
+  AppendLe32(0, &ktx);
+  AppendLe32(1, &ktx);
+  AppendLe32(0, &ktx);
+  AppendLe32(gl_internal_format, &ktx);
+  AppendLe32(gl_internal_format == kGlCompressedRgb8Etc2 ? kGlRgb : kGlRgba,
+             &ktx);
+  AppendLe32(width, &ktx);
+  AppendLe32(height, &ktx);
+  // No depth, array elements or key/value data, a single face and level
+  AppendLe32(0, &ktx);
+  AppendLe32(0, &ktx);
+  AppendLe32(1, &ktx);
+  AppendLe32(1, &ktx);
+  AppendLe32(0, &ktx);
+  AppendLe32(data.size(), &ktx);
+  ktx += data;
+  return ktx;
+}
+
+::mediapipe::Status CompressedTexture::DecodeToRgba(
+    std::vector<uint8>* rgba) const {
+  if (!is_etc2()) {
+    return ::mediapipe::UnimplementedError(
+        absl::StrCat("Cannot decode texture format ", gl_internal_format_,
+                     " on the CPU."));
+  }
+  const bool has_alpha = gl_internal_format_ == kGlCompressedRgba8Etc2Eac;
+  const int blocks_x = (width_ + kEtcBlockSize - 1) / kEtcBlockSize;
+  const int blocks_y = (height_ + kEtcBlockSize - 1) / kEtcBlockSize;
+  rgba->resize(static_cast<size_t>(width_) * height_ * 4);
+  const uint8* block = reinterpret_cast<const uint8*>(data_);
+  uint8 pixels[kEtcBlockPixels][4];
+  for (int block_y = 0; block_y < blocks_y; ++block_y) {
+    for (int block_x = 0; block_x < blocks_x; ++block_x) {
+      if (has_alpha) {
+        DecodeEacAlphaBlock(block, pixels);
+        block += kEtcAlphaBlockBytes;
+      } else {
+        for (int k = 0; k < kEtcBlockPixels; ++k) {
+          pixels[k][3] = 255;
+        }
+      }
+      DecodeEtc2ColorBlock(block, pixels);
+      block += kEtcColorBlockBytes;
+
+      // Blocks past the edges of the texture are only partly kept
+      for (int x = 0; x < kEtcBlockSize; ++x) {
+        const int pixel_x = block_x * kEtcBlockSize + x;
+        for (int y = 0; y < kEtcBlockSize; ++y) {
+          const int pixel_y = block_y * kEtcBlockSize + y;
+          if (pixel_x < width_ && pixel_y < height_) {
+            std::memcpy(
+                &(*rgba)[(static_cast<size_t>(pixel_y) * width_ + pixel_x) *
+                         4],
+                pixels[x * kEtcBlockSize + y], 4);
+          }
+        }
+      }
+    }
+  }
+  return ::mediapipe::OkStatus();
+}
+
+std::string EncodeEtc2(const uint8* rgba, int width, int height,
+                       uint32* gl_internal_format) {
+  const size_t num_pixels = static_cast<size_t>(width) * height;
+  bool has_alpha = false;
+  for (size_t i = 0; i < num_pixels && !has_alpha; ++i) {
+    has_alpha = rgba[i * 4 + 3] != 255;
+  }
+  *gl_internal_format =
+      has_alpha ? kGlCompressedRgba8Etc2Eac : kGlCompressedRgb8Etc2;
+
+  const int blocks_x = (width + kEtcBlockSize - 1) / kEtcBlockSize;
+  const int blocks_y = (height + kEtcBlockSize - 1) / kEtcBlockSize;
+  const int block_bytes = has_alpha ? kEtcAlphaBlockBytes + kEtcColorBlockBytes
+                                    : kEtcColorBlockBytes;
+  std::string data(static_cast<size_t>(blocks_x) * blocks_y * block_bytes,
+                   '\0');
+  uint8* block = reinterpret_cast<uint8*>(&data[0]);
+  uint8 pixels[kEtcBlockPixels][4];
+  for (int block_y = 0; block_y < blocks_y; ++block_y) {
+    for (int block_x = 0; block_x < blocks_x; ++block_x) {
+      // Blocks past the edges of the image repeat its edge pixels
+      for (int x = 0; x < kEtcBlockSize; ++x) {
+        const int pixel_x = std::min(block_x * kEtcBlockSize + x, width - 1);
+        for (int y = 0; y < kEtcBlockSize; ++y) {
+          const int pixel_y =
+              std::min(block_y * kEtcBlockSize + y, height - 1);
+          std::memcpy(pixels[x * kEtcBlockSize + y],
+                      rgba + (static_cast<size_t>(pixel_y) * width + pixel_x) *
+                                 4,
+                      4);
+        }
+      }
+      if (has_alpha) {
+        EncodeEacAlphaBlock(pixels, block);
+        block += kEtcAlphaBlockBytes;
+      }
+      EncodeEtc2ColorBlock(pixels, block);
+      block += kEtcColorBlockBytes;
+    }
+  }
+  return data;
+}
+
+}  // namespace mediapipe
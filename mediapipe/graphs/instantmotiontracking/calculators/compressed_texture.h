@@ -0,0 +1,98 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_COMPRESSED_TEXTURE_H_
+#define MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_COMPRESSED_TEXTURE_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/port/integral_types.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/statusor.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/animation_asset.h"
+
+namespace mediapipe {
+
+// OpenGL internal formats of the compressed textures supported, as defined by
+// OpenGL ES 3.0 and KHR_texture_compression_astc_ldr. ASTC formats of every
+// block size follow kGlCompressedRgbaAstc4x4 in increasing block size order.
+constexpr uint32 kGlCompressedRgb8Etc2 = 0x9274;
+constexpr uint32 kGlCompressedRgba8Etc2Eac = 0x9278;
+constexpr uint32 kGlCompressedRgbaAstc4x4 = 0x93B0;
+constexpr uint32 kGlCompressedRgbaAstc12x12 = 0x93BD;
+
+// Read-only view of the base level of a compressed texture in a KTX or KTX2
+// file, which points directly into the file contents so that it can be
+// uploaded without copying. Only 2D textures in ETC2 or ASTC formats, without
+// KTX2 supercompression, are accepted. Further mipmap levels are ignored, as
+// asset textures are sampled without mipmapping.
+//
+// The first row of the texture is the top row of the image, as with
+// ImageFrame textures.
+class CompressedTexture {
+ public:
+  // Loads the texture at path, which names an APK asset on Android.
+  static ::mediapipe::StatusOr<std::unique_ptr<CompressedTexture>> Load(
+      const std::string& path);
+
+  // Same as Load, for an already opened file.
+  static ::mediapipe::StatusOr<std::unique_ptr<CompressedTexture>> FromFile(
+      std::unique_ptr<AssetFile> file);
+
+  // Writes an ETC2 texture as a KTX file of a single level, and returns the
+  // contents of the file. data holds the compressed blocks of the texture.
+  static std::string SerializeKtx(uint32 gl_internal_format, int width,
+                                  int height, const std::string& data);
+
+  uint32 gl_internal_format() const { return gl_internal_format_; }
+  int width() const { return width_; }
+  int height() const { return height_; }
+  // Compressed blocks of the base level, size() bytes long
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+  bool is_etc2() const {
+    return gl_internal_format_ == kGlCompressedRgb8Etc2 ||
+           gl_internal_format_ == kGlCompressedRgba8Etc2Eac;
+  }
+
+  // Decodes the texture into RGBA pixels, row by row without padding, for
+  // OpenGL contexts lacking support for its format. Only ETC2 textures can be
+  // decoded.
+  ::mediapipe::Status DecodeToRgba(std::vector<uint8>* rgba) const;
+
+ private:
+  CompressedTexture() = default;
+
+  std::unique_ptr<AssetFile> file_;
+  uint32 gl_internal_format_ = 0;
+  int width_ = 0;
+  int height_ = 0;
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// Compresses RGBA pixels, row by row without padding, into ETC2 blocks. Opaque
+// images are compressed to kGlCompressedRgb8Etc2, using only the modes shared
+// with ETC1, and images with transparency to kGlCompressedRgba8Etc2Eac. Sets
+// gl_internal_format to the format chosen.
+std::string EncodeEtc2(const uint8* rgba, int width, int height,
+                       uint32* gl_internal_format);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_COMPRESSED_TEXTURE_H_
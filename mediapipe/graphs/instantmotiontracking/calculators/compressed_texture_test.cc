@@ -0,0 +1,169 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/graphs/instantmotiontracking/calculators/compressed_texture.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/port/file_helpers.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/integral_types.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/port/statusor.h"
+
+namespace mediapipe {
+namespace {
+
+// Reference KTX files and their pixels, row by row in RGBA, as decoded by an
+// independent implementation of the ETC2 and EAC block formats.
+//
+// The 8x8 RGBA texture holds, from its top left block in row order, a flipped
+// individual mode block, an unflipped differential mode block, a T mode block
+// and an H mode block, each along with an EAC alpha block. Their colors and
+// alphas are clamped in places.
+const uint8 kRgbaKtx[] = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A,
+    0x01, 0x02, 0x03, 0x04, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x78, 0x92, 0x00, 0x00, 0x08, 0x19, 0x00, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0xC8, 0x30, 0x39, 0x8A,
+    0xBC, 0x39, 0x8A, 0xBC, 0xF2, 0xC5, 0x1E, 0xC9, 0x5A, 0x3C, 0xC3, 0x5A,
+    0xFA, 0xFD, 0x5E, 0x1C, 0xC5, 0x5E, 0x1C, 0xC5, 0xA5, 0x1B, 0xFF, 0x3E,
+    0xE8, 0x93, 0xD4, 0xAB, 0x0A, 0x97, 0x62, 0xAF, 0x0E, 0x62, 0xAF, 0x0E,
+    0xF3, 0x49, 0x7D, 0x2B, 0x5A, 0x3C, 0xC3, 0x5A, 0x80, 0x04, 0x87, 0x31,
+    0x57, 0x87, 0x31, 0x57, 0x1D, 0x15, 0xD3, 0x36, 0xE8, 0x93, 0xD4, 0xAB
+};
+
+// The 10x4 RGB texture holds a planar mode block, an H mode block with equal
+// base colors, and an individual mode block cropped to its left half by the
+// texture edge.
+const uint8 kRgbKtx[] = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A,
+    0x01, 0x02, 0x03, 0x04, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x74, 0x92, 0x00, 0x00, 0x07, 0x19, 0x00, 0x00,
+    0x0A, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x5B, 0x26, 0xFB, 0x17,
+    0xFE, 0x47, 0xC0, 0x6A, 0x4B, 0x06, 0xCB, 0x2B, 0x5A, 0x3C, 0xC3, 0x5A,
+    0xF2, 0xC5, 0x1E, 0xC9, 0x5A, 0x3C, 0xC3, 0x5A
+};
+
+const uint8 kRgbaPixels[] = {
+    0xFF, 0xED, 0x32, 0xB6, 0x95, 0x62, 0x00, 0xD7, 0xFF, 0xFF, 0x7B, 0xB6,
+    0xDE, 0xAB, 0x00, 0xD7, 0x94, 0x07, 0xEE, 0xCD, 0xA0, 0x13, 0xFA, 0xFF,
+    0xBB, 0x60, 0xFF, 0xCD, 0xFF, 0xE8, 0xFF, 0xFF, 0xFF, 0xFF, 0x7B, 0xE0,
+    0xDE, 0xAB, 0x00, 0xAD, 0x95, 0x62, 0x00, 0xE0, 0xFF, 0xED, 0x32, 0xAD,
+    0x94, 0x07, 0xEE, 0xFF, 0xB6, 0x29, 0xFF, 0x64, 0xBB, 0x60, 0xFF, 0xFF,
+    0x5D, 0x02, 0xC8, 0x64, 0x19, 0x4C, 0xE5, 0x9B, 0x3F, 0x72, 0xFF, 0xF2,
+    0x2B, 0x5E, 0xF7, 0x9B, 0x05, 0x38, 0xD1, 0xF2, 0xAA, 0x1D, 0xFF, 0xFA,
+    0xAA, 0x1D, 0xFF, 0xEB, 0xFF, 0xE8, 0xFF, 0xFA, 0x00, 0x00, 0x40, 0xEB,
+    0x05, 0x38, 0xD1, 0xBF, 0x2B, 0x5E, 0xF7, 0xCE, 0x19, 0x4C, 0xE5, 0xBF,
+    0x3F, 0x72, 0xFF, 0xCE, 0xB6, 0x29, 0xFF, 0xDC, 0x94, 0x07, 0xEE, 0xFF,
+    0x5D, 0x02, 0xC8, 0xDC, 0x00, 0x00, 0x40, 0xFF, 0xBB, 0x44, 0x99, 0x00,
+    0x57, 0xBD, 0x02, 0x64, 0x97, 0xFD, 0x42, 0x00, 0x77, 0xDD, 0x22, 0x64,
+    0x93, 0x4F, 0x4F, 0x80, 0xC1, 0x7D, 0x7D, 0x80, 0x4A, 0xD2, 0x4A, 0x80,
+    0x1C, 0xA4, 0x1C, 0x80, 0x97, 0xFD, 0x42, 0x00, 0x77, 0xDD, 0x22, 0x1C,
+    0x57, 0xBD, 0x02, 0x00, 0xBB, 0x44, 0x99, 0x1C, 0x93, 0x4F, 0x4F, 0x80,
+    0x1C, 0xA4, 0x1C, 0x80, 0x4A, 0xD2, 0x4A, 0x80, 0xC1, 0x7D, 0x7D, 0x80,
+    0x77, 0xDD, 0x22, 0x2E, 0x97, 0xFD, 0x42, 0x00, 0xBB, 0x44, 0x99, 0x2E,
+    0x57, 0xBD, 0x02, 0x00, 0x4A, 0xD2, 0x4A, 0x80, 0x4A, 0xD2, 0x4A, 0x80,
+    0x1C, 0xA4, 0x1C, 0x80, 0x93, 0x4F, 0x4F, 0x80, 0x57, 0xBD, 0x02, 0x00,
+    0xBB, 0x44, 0x99, 0x49, 0x77, 0xDD, 0x22, 0x00, 0x97, 0xFD, 0x42, 0x49,
+    0x1C, 0xA4, 0x1C, 0x80, 0x93, 0x4F, 0x4F, 0x80, 0xC1, 0x7D, 0x7D, 0x80,
+    0x93, 0x4F, 0x4F, 0x80
+};
+
+const uint8 kRgbPixels[] = {
+    0xB6, 0xA7, 0x79, 0xFF, 0x94, 0xBD, 0x63, 0xFF, 0x71, 0xD3, 0x4D, 0xFF,
+    0x4F, 0xE9, 0x36, 0xFF, 0xA9, 0x76, 0x65, 0xFF, 0x89, 0x56, 0x45, 0xFF,
+    0x89, 0x56, 0x45, 0xFF, 0xA9, 0x76, 0x65, 0xFF, 0xFF, 0xED, 0x32, 0xFF,
+    0x95, 0x62, 0x00, 0xFF, 0xC7, 0x7E, 0x85, 0xFF, 0xA5, 0x94, 0x6F, 0xFF,
+    0x82, 0xAA, 0x59, 0xFF, 0x60, 0xC0, 0x43, 0xFF, 0x89, 0x56, 0x45, 0xFF,
+    0xA9, 0x76, 0x65, 0xFF, 0x89, 0x56, 0x45, 0xFF, 0xA9, 0x76, 0x65, 0xFF,
+    0xFF, 0xFF, 0x7B, 0xFF, 0xDE, 0xAB, 0x00, 0xFF, 0xD9, 0x55, 0x92, 0xFF,
+    0xB6, 0x6B, 0x7B, 0xFF, 0x94, 0x81, 0x65, 0xFF, 0x71, 0x97, 0x4F, 0xFF,
+    0xA9, 0x76, 0x65, 0xFF, 0x89, 0x56, 0x45, 0xFF, 0xA9, 0x76, 0x65, 0xFF,
+    0x89, 0x56, 0x45, 0xFF, 0x19, 0x4C, 0xE5, 0xFF, 0x3F, 0x72, 0xFF, 0xFF,
+    0xEA, 0x2B, 0x9E, 0xFF, 0xC7, 0x41, 0x88, 0xFF, 0xA5, 0x57, 0x71, 0xFF,
+    0x82, 0x6D, 0x5B, 0xFF, 0x89, 0x56, 0x45, 0xFF, 0xA9, 0x76, 0x65, 0xFF,
+    0xA9, 0x76, 0x65, 0xFF, 0x89, 0x56, 0x45, 0xFF, 0x05, 0x38, 0xD1, 0xFF,
+    0x2B, 0x5E, 0xF7, 0xFF
+};
+
+::mediapipe::StatusOr<std::unique_ptr<CompressedTexture>> LoadKtx(
+    const uint8* ktx, size_t size, const std::string& name) {
+  const std::string path = ::testing::TempDir() + "/" + name;
+  const ::mediapipe::Status status = file::SetContents(
+      path, std::string(reinterpret_cast<const char*>(ktx), size));
+  if (!status.ok()) {
+    return status;
+  }
+  return CompressedTexture::Load(path);
+}
+
+void ExpectPixels(const CompressedTexture& texture, const uint8* expected) {
+  std::vector<uint8> rgba;
+  MP_ASSERT_OK(texture.DecodeToRgba(&rgba));
+  ASSERT_EQ(rgba.size(),
+            static_cast<size_t>(texture.width()) * texture.height() * 4);
+  for (size_t i = 0; i < rgba.size(); ++i) {
+    EXPECT_EQ(rgba[i], expected[i])
+        << "at " << (i / 4) % texture.width() << ", "
+        << (i / 4) / texture.width() << ", channel " << i % 4;
+  }
+}
+
+TEST(CompressedTextureTest, DecodesEtc2RgbaReferenceBlocks) {
+  auto texture = LoadKtx(kRgbaKtx, sizeof(kRgbaKtx), "rgba.ktx");
+  ASSERT_TRUE(texture.ok()) << texture.status();
+  const std::unique_ptr<CompressedTexture> loaded =
+      std::move(texture).ValueOrDie();
+  EXPECT_EQ(loaded->gl_internal_format(), kGlCompressedRgba8Etc2Eac);
+  EXPECT_EQ(loaded->width(), 8);
+  EXPECT_EQ(loaded->height(), 8);
+  EXPECT_EQ(loaded->size(), 64u);
+  ExpectPixels(*loaded, kRgbaPixels);
+}
+
+TEST(CompressedTextureTest, DecodesEtc2RgbReferenceBlocks) {
+  auto texture = LoadKtx(kRgbKtx, sizeof(kRgbKtx), "rgb.ktx");
+  ASSERT_TRUE(texture.ok()) << texture.status();
+  const std::unique_ptr<CompressedTexture> loaded =
+      std::move(texture).ValueOrDie();
+  EXPECT_EQ(loaded->gl_internal_format(), kGlCompressedRgb8Etc2);
+  EXPECT_EQ(loaded->width(), 10);
+  EXPECT_EQ(loaded->height(), 4);
+  EXPECT_EQ(loaded->size(), 24u);
+  ExpectPixels(*loaded, kRgbPixels);
+}
+
+TEST(CompressedTextureTest, SerializesReferenceKtx) {
+  // The blocks of the RGB texture follow its 64 byte header and level size
+  const std::string blocks(reinterpret_cast<const char*>(kRgbKtx) + 68, 24);
+  EXPECT_EQ(CompressedTexture::SerializeKtx(kGlCompressedRgb8Etc2, 10, 4,
+                                            blocks),
+            std::string(reinterpret_cast<const char*>(kRgbKtx),
+                        sizeof(kRgbKtx)));
+}
+
+TEST(CompressedTextureTest, RejectsTruncatedKtx) {
+  EXPECT_FALSE(LoadKtx(kRgbaKtx, sizeof(kRgbaKtx) - 1, "truncated.ktx").ok());
+}
+
+}  // namespace
+}  // namespace mediapipe
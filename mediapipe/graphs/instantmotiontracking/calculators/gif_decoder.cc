@@ -0,0 +1,349 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/graphs/instantmotiontracking/calculators/gif_decoder.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "absl/strings/str_cat.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr int kHeaderSize = 13;
+constexpr int kImageDescriptorSize = 9;
+// Block introducers and extension labels
+constexpr uint8 kExtensionIntroducer = 0x21;
+constexpr uint8 kImageSeparator = 0x2C;
+constexpr uint8 kTrailer = 0x3B;
+constexpr uint8 kGraphicControlLabel = 0xF9;
+constexpr int kGraphicControlSize = 4;
+// Disposal methods of the graphic control extension
+constexpr int kDisposeToBackground = 2;
+constexpr int kDisposeToPrevious = 3;
+// LZW codes are at most 12 bits long
+constexpr int kMaxLzwBits = 12;
+constexpr int kMaxLzwCodes = 1 << kMaxLzwBits;
+// First row and row step of each pass over an interlaced frame
+constexpr int kInterlacedPasses = 4;
+constexpr int kInterlacedFirstRow[kInterlacedPasses] = {0, 4, 2, 1};
+constexpr int kInterlacedRowStep[kInterlacedPasses] = {8, 8, 4, 2};
+
+::mediapipe::Status TruncatedError() {
+  return ::mediapipe::InvalidArgumentError("Truncated GIF image.");
+}
+
+}  // namespace
+
+::mediapipe::Status GifDecoder::Open(std::string data) {
+  data_ = std::move(data);
+  if (data_.size() < kHeaderSize || (data_.compare(0, 6, "GIF87a") != 0 &&
+                                     data_.compare(0, 6, "GIF89a") != 0)) {
+    return ::mediapipe::InvalidArgumentError("Not a GIF image.");
+  }
+  width_ = ReadLe16(6);
+  height_ = ReadLe16(8);
+  if (width_ == 0 || height_ == 0) {
+    return ::mediapipe::InvalidArgumentError("GIF image is empty.");
+  }
+  // The background color index is ignored, as backgrounds are transparent
+  const int packed_fields = Byte(10);
+  position_ = kHeaderSize;
+  global_color_table_.clear();
+  if (packed_fields & 0x80) {
+    MP_RETURN_IF_ERROR(ReadColorTable(packed_fields, &global_color_table_));
+  }
+  first_frame_position_ = position_;
+
+  lzw_prefix_.resize(kMaxLzwCodes);
+  lzw_suffix_.resize(kMaxLzwCodes);
+  lzw_stack_.resize(kMaxLzwCodes + 1);
+  saved_canvas_.clear();
+  Rewind();
+  return ::mediapipe::OkStatus();
+}
+
+void GifDecoder::Rewind() {
+  position_ = first_frame_position_;
+  canvas_.assign(static_cast<size_t>(width_) * height_ * 4, 0);
+  frame_delay_ms_ = 0;
+  previous_disposal_ = 0;
+}
+
+::mediapipe::Status GifDecoder::DecodeNextFrame(bool* decoded) {
+  *decoded = false;
+  // Graphic control of the next frame, if any
+  int disposal = 0;
+  int delay_ms = 0;
+  int transparent_index = -1;
+  while (true) {
+    if (position_ >= data_.size()) {
+      return TruncatedError();
+    }
+    const uint8 block = Byte(position_++);
+    if (block == kTrailer) {
+      return ::mediapipe::OkStatus();
+    }
+    if (block == kExtensionIntroducer) {
+      if (position_ >= data_.size()) {
+        return TruncatedError();
+      }
+      const uint8 label = Byte(position_++);
+      if (label == kGraphicControlLabel) {
+        if (data_.size() - position_ < kGraphicControlSize + 1 ||
+            Byte(position_) != kGraphicControlSize) {
+          return ::mediapipe::InvalidArgumentError(
+              "Invalid GIF graphic control extension.");
+        }
+        const int packed_fields = Byte(position_ + 1);
+        disposal = (packed_fields >> 2) & 0x7;
+        // Delays are stored in hundredths of a second
+        delay_ms = ReadLe16(position_ + 2) * 10;
+        transparent_index = (packed_fields & 0x1) ? Byte(position_ + 4) : -1;
+      }
+      // Other extensions, such as comments and looping, are of no use here
+      MP_RETURN_IF_ERROR(SkipSubBlocks());
+      continue;
+    }
+    if (block != kImageSeparator) {
+      return ::mediapipe::InvalidArgumentError(
+          absl::StrCat("Invalid GIF block type ", block, "."));
+    }
+    break;
+  }
+
+  if (data_.size() - position_ < kImageDescriptorSize) {
+    return TruncatedError();
+  }
+  Rect rect;
+  rect.left = ReadLe16(position_);
+  rect.top = ReadLe16(position_ + 2);
+  rect.width = ReadLe16(position_ + 4);
+  rect.height = ReadLe16(position_ + 6);
+  const int packed_fields = Byte(position_ + 8);
+  position_ += kImageDescriptorSize;
+  const std::vector<uint8>* color_table = &global_color_table_;
+  if (packed_fields & 0x80) {
+    MP_RETURN_IF_ERROR(ReadColorTable(packed_fields, &local_color_table_));
+    color_table = &local_color_table_;
+  }
+  if (color_table->empty()) {
+    return ::mediapipe::InvalidArgumentError(
+        "GIF frame without a color table.");
+  }
+
+  DisposePreviousFrame();
+  if (disposal == kDisposeToPrevious) {
+    saved_canvas_ = canvas_;
+  }
+  previous_disposal_ = disposal;
+  previous_rect_ = rect;
+  MP_RETURN_IF_ERROR(DecodeImageData(rect, packed_fields & 0x40, *color_table,
+                                     transparent_index));
+  frame_delay_ms_ = delay_ms;
+  *decoded = true;
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status GifDecoder::ReadColorTable(
+    int packed_fields, std::vector<uint8>* color_table) {
+  const size_t size = 3 * (2 << (packed_fields & 0x7));
+  if (data_.size() - position_ < size) {
+    return TruncatedError();
+  }
+  color_table->assign(data_.begin() + position_,
+                      data_.begin() + position_ + size);
+  position_ += size;
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status GifDecoder::SkipSubBlocks() {
+  while (true) {
+    if (position_ >= data_.size()) {
+      return TruncatedError();
+    }
+    const int block_size = Byte(position_++);
+    if (block_size == 0) {
+      return ::mediapipe::OkStatus();
+    }
+    if (data_.size() - position_ < static_cast<size_t>(block_size)) {
+      return TruncatedError();
+    }
+    position_ += block_size;
+  }
+}
+
+void GifDecoder::DisposePreviousFrame() {
+  if (previous_disposal_ == kDisposeToBackground) {
+    const int left = std::min(previous_rect_.left, width_);
+    const int right =
+        std::min(previous_rect_.left + previous_rect_.width, width_);
+    const int bottom =
+        std::min(previous_rect_.top + previous_rect_.height, height_);
+    for (int y = previous_rect_.top; y < bottom; ++y) {
+      std::memset(&canvas_[(static_cast<size_t>(y) * width_ + left) * 4], 0,
+                  (right - left) * 4);
+    }
+  } else if (previous_disposal_ == kDisposeToPrevious &&
+             !saved_canvas_.empty()) {
+    canvas_.swap(saved_canvas_);
+  }
+}
+
+::mediapipe::Status GifDecoder::DecodeImageData(
+    const Rect& rect, bool interlaced, const std::vector<uint8>& color_table,
+    int transparent_index) {
+  if (position_ >= data_.size()) {
+    return TruncatedError();
+  }
+  const int min_code_size = Byte(position_++);
+  if (min_code_size < 1 || min_code_size >= kMaxLzwBits) {
+    return ::mediapipe::InvalidArgumentError(
+        "Invalid GIF LZW minimum code size.");
+  }
+  const int clear_code = 1 << min_code_size;
+  const int end_code = clear_code + 1;
+  const int num_colors = color_table.size() / 3;
+
+  // Position of the next pixel within the frame
+  const int64 num_pixels = static_cast<int64>(rect.width) * rect.height;
+  int64 pixels_written = 0;
+  int column = 0;
+  int row = 0;
+  int pass = 0;
+  const auto write_pixel = [&](int color_index) {
+    if (pixels_written >= num_pixels) {
+      return;
+    }
+    const int x = rect.left + column;
+    const int y = rect.top + row;
+    if (color_index != transparent_index && x < width_ && y < height_) {
+      uint8* pixel = &canvas_[(static_cast<size_t>(y) * width_ + x) * 4];
+      if (color_index < num_colors) {
+        std::memcpy(pixel, &color_table[color_index * 3], 3);
+      } else {
+        std::memset(pixel, 0, 3);
+      }
+      pixel[3] = 255;
+    }
+    ++pixels_written;
+    if (++column < rect.width) {
+      return;
+    }
+    column = 0;
+    if (!interlaced) {
+      ++row;
+      return;
+    }
+    row += kInterlacedRowStep[pass];
+    while (row >= rect.height && pass + 1 < kInterlacedPasses) {
+      row = kInterlacedFirstRow[++pass];
+    }
+  };
+
+  int code_size = min_code_size + 1;
+  int next_code = end_code + 1;
+  int previous_code = -1;
+  uint8 first_index = 0;
+  uint32 bits = 0;
+  int num_bits = 0;
+  // Bytes left in the current data sub-block
+  int block_remaining = 0;
+  bool data_ended = false;
+  while (!data_ended) {
+    // Gather the bits of the next code across sub-blocks
+    while (num_bits < code_size) {
+      if (block_remaining == 0) {
+        if (position_ >= data_.size()) {
+          return TruncatedError();
+        }
+        block_remaining = Byte(position_++);
+        if (block_remaining == 0) {
+          data_ended = true;
+          break;
+        }
+      }
+      if (position_ >= data_.size()) {
+        return TruncatedError();
+      }
+      bits |= static_cast<uint32>(Byte(position_++)) << num_bits;
+      num_bits += 8;
+      --block_remaining;
+    }
+    if (data_ended) {
+      break;
+    }
+    const int code = bits & ((1 << code_size) - 1);
+    bits >>= code_size;
+    num_bits -= code_size;
+
+    if (code == clear_code) {
+      code_size = min_code_size + 1;
+      next_code = end_code + 1;
+      previous_code = -1;
+      continue;
+    }
+    if (code == end_code) {
+      // Skip whatever follows the end code, up to the block terminator
+      position_ += block_remaining;
+      MP_RETURN_IF_ERROR(SkipSubBlocks());
+      break;
+    }
+    if (previous_code == -1) {
+      if (code >= clear_code) {
+        return ::mediapipe::InvalidArgumentError("Invalid GIF LZW code.");
+      }
+      write_pixel(code);
+      first_index = code;
+      previous_code = code;
+      continue;
+    }
+    if (code > next_code || (code == next_code && next_code >= kMaxLzwCodes)) {
+      return ::mediapipe::InvalidArgumentError("Invalid GIF LZW code.");
+    }
+
+    // Expand the string of the code, last index first. A code not yet in the
+    // table stands for the previous string followed by its own first index
+    int stack_size = 0;
+    int current_code = code;
+    if (code == next_code) {
+      lzw_stack_[stack_size++] = first_index;
+      current_code = previous_code;
+    }
+    while (current_code > end_code) {
+      lzw_stack_[stack_size++] = lzw_suffix_[current_code];
+      current_code = lzw_prefix_[current_code];
+    }
+    first_index = current_code;
+    lzw_stack_[stack_size++] = first_index;
+    while (stack_size > 0) {
+      write_pixel(lzw_stack_[--stack_size]);
+    }
+
+    if (next_code < kMaxLzwCodes) {
+      lzw_prefix_[next_code] = previous_code;
+      lzw_suffix_[next_code] = first_index;
+      ++next_code;
+      if (next_code == (1 << code_size) && code_size < kMaxLzwBits) {
+        ++code_size;
+      }
+    }
+    previous_code = code;
+  }
+  return ::mediapipe::OkStatus();
+}
+
+}  // namespace mediapipe
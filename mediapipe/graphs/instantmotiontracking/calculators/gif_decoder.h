@@ -0,0 +1,102 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_GIF_DECODER_H_
+#define MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_GIF_DECODER_H_
+
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/port/integral_types.h"
+#include "mediapipe/framework/port/status.h"
+
+namespace mediapipe {
+
+// Decodes the frames of a GIF image one at a time, compositing each onto an
+// RGBA canvas the size of the image, so that only the canvas, and a copy of it
+// for frames restoring the previous one, is held in memory however many frames
+// the GIF has.
+//
+// Frame disposal follows the GIF89a specification, except that disposing to
+// the background clears to transparent, as web browsers do.
+class GifDecoder {
+ public:
+  // Parses the header and global color table of a GIF image held in data, which
+  // is kept for decoding the frames on demand.
+  ::mediapipe::Status Open(std::string data);
+
+  int width() const { return width_; }
+  int height() const { return height_; }
+
+  // Decodes the next frame onto the canvas. Sets decoded to false, leaving the
+  // canvas untouched, once past the last frame.
+  ::mediapipe::Status DecodeNextFrame(bool* decoded);
+  // Restarts decoding from the first frame, with a transparent canvas.
+  void Rewind();
+
+  // RGBA pixels of the current frame, row by row without padding
+  const uint8* canvas() const { return canvas_.data(); }
+  // Display duration of the current frame in milliseconds, 0 if unspecified
+  int frame_delay_ms() const { return frame_delay_ms_; }
+
+ private:
+  // Frame rectangle, in canvas pixels
+  struct Rect {
+    int left = 0;
+    int top = 0;
+    int width = 0;
+    int height = 0;
+  };
+
+  uint8 Byte(size_t offset) const { return static_cast<uint8>(data_[offset]); }
+  int ReadLe16(size_t offset) const {
+    return Byte(offset) | (Byte(offset + 1) << 8);
+  }
+  ::mediapipe::Status ReadColorTable(int packed_fields,
+                                     std::vector<uint8>* color_table);
+  ::mediapipe::Status SkipSubBlocks();
+  // Undoes the previous frame as its disposal method requires
+  void DisposePreviousFrame();
+  // Decodes the LZW compressed indices of a frame onto the canvas
+  ::mediapipe::Status DecodeImageData(const Rect& rect, bool interlaced,
+                                      const std::vector<uint8>& color_table,
+                                      int transparent_index);
+
+  std::string data_;
+  // Read position within data_, and the position of the first frame
+  size_t position_ = 0;
+  size_t first_frame_position_ = 0;
+  int width_ = 0;
+  int height_ = 0;
+  // RGB triplets of the global and current local color tables
+  std::vector<uint8> global_color_table_;
+  std::vector<uint8> local_color_table_;
+
+  std::vector<uint8> canvas_;
+  // Canvas before the previous frame, kept when it is to be restored
+  std::vector<uint8> saved_canvas_;
+  int frame_delay_ms_ = 0;
+  int previous_disposal_ = 0;
+  Rect previous_rect_;
+
+  // LZW string table, as the prefix code and last index of every code, and
+  // the stack strings are expanded on
+  std::vector<uint16> lzw_prefix_;
+  std::vector<uint8> lzw_suffix_;
+  std::vector<uint8> lzw_stack_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_GIF_DECODER_H_
@@ -0,0 +1,109 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Measures the time to decode every frame of an animated GIF, against the GIF
+// size, for GIFs whose frames cover the whole canvas and for GIFs whose frames
+// only update a part of it, as GIF optimizers make them.
+// Usage:
+//   bazel run -c opt //mediapipe/graphs/instantmotiontracking/calculators:gif_decoder_benchmark
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "mediapipe/framework/port/integral_types.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/gif_decoder.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/gif_test_util.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr int kFrameCount = 24;
+
+// Encodes a GIF of diagonal stripes scrolling across the canvas, with a patch
+// of noise, which compresses poorly, moving along with them. Partial frames
+// only cover the middle half of the canvas.
+std::string MakeAnimatedGif(int size, bool partial_frames) {
+  std::vector<uint8> color_table;
+  for (int i = 0; i < 256; ++i) {
+    color_table.insert(color_table.end(), {static_cast<uint8>(i),
+                                           static_cast<uint8>(i / 2),
+                                           static_cast<uint8>(255 - i)});
+  }
+  const int frame_offset = partial_frames ? size / 4 : 0;
+  const int frame_size = partial_frames ? size / 2 : size;
+  uint32 state = 1;
+  std::vector<GifTestFrame> frames;
+  for (int i = 0; i < kFrameCount; ++i) {
+    GifTestFrame frame;
+    frame.left = frame_offset;
+    frame.top = frame_offset;
+    frame.width = frame_size;
+    frame.height = frame_size;
+    frame.delay_centiseconds = 4;
+    frame.indices.resize(frame_size * frame_size);
+    for (int y = 0; y < frame_size; ++y) {
+      for (int x = 0; x < frame_size; ++x) {
+        const int stripe = (x + y + 4 * i) / 8;
+        uint8 index = stripe % 128;
+        if ((x - 2 * i) / 32 == 0 && y / 32 == 0) {
+          state = state * 1103515245 + 12345;
+          index = 128 + (state >> 25);
+        }
+        frame.indices[y * frame_size + x] = index;
+      }
+    }
+    frames.push_back(std::move(frame));
+  }
+  return EncodeGif(size, size, color_table, frames);
+}
+
+// The first argument is the GIF width and height, and the second one whether
+// its frames only cover part of the canvas.
+void BM_DecodeGif(benchmark::State& state) {
+  const std::string gif = MakeAnimatedGif(state.range(0), state.range(1));
+  GifDecoder decoder;
+  if (!decoder.Open(gif).ok()) {
+    state.SkipWithError("Unable to open GIF.");
+    return;
+  }
+  for (auto _ : state) {
+    decoder.Rewind();
+    bool decoded = true;
+    while (decoded) {
+      if (!decoder.DecodeNextFrame(&decoded).ok()) {
+        state.SkipWithError("Unable to decode GIF.");
+        return;
+      }
+    }
+    benchmark::DoNotOptimize(decoder.canvas());
+  }
+  state.SetItemsProcessed(state.iterations() * kFrameCount);
+  state.SetBytesProcessed(state.iterations() * gif.size());
+}
+
+BENCHMARK(BM_DecodeGif)
+    ->ArgNames({"size", "partial"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      for (const int size : {128, 256, 512}) {
+        for (const int partial : {0, 1}) {
+          b->Args({size, partial});
+        }
+      }
+    })
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,269 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/gif_decoder.h"
+
+namespace mediapipe {
+
+constexpr char kTickTag[] = "TICK";
+constexpr char kGifTag[] = "GIF";
+constexpr char kTextureTag[] = "TEXTURE";
+constexpr char kAspectRatioTag[] = "ASPECT_RATIO";
+constexpr char kRingSizeSidePacketTag[] = "RING_SIZE";
+// Number of decoded frames kept, unless RING_SIZE says otherwise
+constexpr int kDefaultRingSize = 8;
+// Shorter frame delays are shown for the default delay instead, as browsers do
+constexpr int kMinFrameDelayMs = 20;
+constexpr int kDefaultFrameDelayMs = 100;
+
+// This calculator decodes an animated GIF from its raw bytes into a stream of
+// textures, one frame at a time, timed by the frame delays of the GIF and
+// looping forever. Frames are decoded incrementally, so that memory use does
+// not grow with the number of frames: decoded frames are kept in a ring of at
+// most RING_SIZE RGBA buffers, from which a GIF whose frames all fit is looped
+// without decoding it again. Longer GIFs are decoded anew on every loop, with
+// no frames kept beyond the ones being displayed.
+//
+// Frames are mirrored horizontally while being copied out of the decoder, for
+// the texture coordinates of the sticker assets, so that no extra copy of any
+// frame is made.
+//
+// The Instant Motion Tracking app does not use this calculator yet, and does
+// not link it into its mobile_calculators. It still decodes GIFs with Glide,
+// so as to pack every frame into the single texture atlas that
+// GlAnimationOverlayCalculator animates without uploading frames, which a ring
+// of frames bounded in number cannot feed. This calculator is meant for graphs
+// that receive raw GIF bytes, and for GIFs too long to fit an atlas, whose
+// frames are then uploaded one at a time.
+//
+// Input:
+//  TICK - Stream of any type, at whose timestamps the next frame is output
+//  once the current one has been displayed long enough [REQUIRED]
+//  GIF - std::string of raw GIF bytes, replacing the current GIF [OPTIONAL]
+// Input Side Packets:
+//  GIF - std::string of raw GIF bytes [OPTIONAL]
+//  RING_SIZE - Maximum number of decoded frames kept (default 8) [OPTIONAL]
+// Output:
+//  TEXTURE - ImageFrame of the current GIF frame, in SRGBA [REQUIRED]
+//  ASPECT_RATIO - float of the GIF width over its height, whenever a GIF is
+//  loaded [OPTIONAL]
+//
+// Exactly one of the GIF input stream and side packet must be given.
+//
+// Example config:
+// node {
+//   calculator: "GifDecoderCalculator"
+//   input_stream: "TICK:input_video"
+//   input_stream: "GIF:gif_bytes"
+//   output_stream: "TEXTURE:gif_texture"
+//   output_stream: "ASPECT_RATIO:gif_aspect_ratio"
+// }
+
+class GifDecoderCalculator : public CalculatorBase {
+private:
+  // A decoded frame, and how long it is displayed for
+  struct DecodedFrame {
+    Packet texture;
+    int delay_ms = 0;
+  };
+
+  std::unique_ptr<GifDecoder> decoder;
+  int ring_size = kDefaultRingSize;
+  // Frames decoded so far, in order from the first, while they all fit
+  std::vector<DecodedFrame> ring;
+  // Whether the ring holds every frame of the GIF, and the next one to output
+  bool ring_complete = false;
+  // Whether the GIF has more frames than fit the ring
+  bool streaming = false;
+  int next_ring_index = 0;
+  // Number of frames decoded since the first frame
+  int frame_index = 0;
+  // Time at which the current frame has been displayed long enough
+  Timestamp next_frame_time = Timestamp::Unstarted();
+
+  // Starts animating the given GIF from its first frame
+  ::mediapipe::Status LoadGif(const std::string& data);
+  // Outputs the next frame of the animation, if there is a different one
+  ::mediapipe::Status OutputNextFrame(CalculatorContext* cc);
+  // Decodes the next frame into a texture, setting decoded to false once past
+  // the last frame
+  ::mediapipe::Status DecodeNextFrame(DecodedFrame* frame, bool* decoded);
+
+public:
+  static ::mediapipe::Status GetContract(CalculatorContract* cc) {
+    RET_CHECK(cc->Inputs().HasTag(kTickTag));
+    RET_CHECK(cc->Inputs().HasTag(kGifTag)
+      != cc->InputSidePackets().HasTag(kGifTag))
+        << "Exactly one of the GIF stream or side packet must be provided";
+    RET_CHECK(cc->Outputs().HasTag(kTextureTag));
+
+    cc->Inputs().Tag(kTickTag).SetAny();
+    if (cc->Inputs().HasTag(kGifTag)) {
+      cc->Inputs().Tag(kGifTag).Set<std::string>();
+    } else {
+      cc->InputSidePackets().Tag(kGifTag).Set<std::string>();
+    }
+    if (cc->InputSidePackets().HasTag(kRingSizeSidePacketTag)) {
+      cc->InputSidePackets().Tag(kRingSizeSidePacketTag).Set<int>();
+    }
+    cc->Outputs().Tag(kTextureTag).Set<ImageFrame>();
+    if (cc->Outputs().HasTag(kAspectRatioTag)) {
+      cc->Outputs().Tag(kAspectRatioTag).Set<float>();
+    }
+
+    return ::mediapipe::OkStatus();
+  }
+
+  ::mediapipe::Status Open(CalculatorContext* cc) override {
+    cc->SetOffset(TimestampDiff(0));
+    if (cc->InputSidePackets().HasTag(kRingSizeSidePacketTag)) {
+      ring_size =
+          cc->InputSidePackets().Tag(kRingSizeSidePacketTag).Get<int>();
+      RET_CHECK_GE(ring_size, 1);
+    }
+    if (cc->InputSidePackets().HasTag(kGifTag)) {
+      MP_RETURN_IF_ERROR(
+          LoadGif(cc->InputSidePackets().Tag(kGifTag).Get<std::string>()))
+          << "Failed to load GIF side packet";
+    }
+    return ::mediapipe::OkStatus();
+  }
+
+  ::mediapipe::Status Process(CalculatorContext* cc) override {
+    if (cc->Inputs().HasTag(kGifTag) && !cc->Inputs().Tag(kGifTag).IsEmpty()) {
+      MP_RETURN_IF_ERROR(
+          LoadGif(cc->Inputs().Tag(kGifTag).Get<std::string>()))
+          << "Failed to load GIF";
+    }
+    if (decoder == nullptr) {
+      return ::mediapipe::OkStatus();
+    }
+
+    // A newly loaded GIF starts right away
+    if (next_frame_time == Timestamp::Unstarted()) {
+      if (cc->Outputs().HasTag(kAspectRatioTag)) {
+        cc->Outputs().Tag(kAspectRatioTag).Add(
+            new float(static_cast<float>(decoder->width()) /
+                      decoder->height()),
+            cc->InputTimestamp());
+      }
+      return OutputNextFrame(cc);
+    }
+    if (cc->InputTimestamp() >= next_frame_time) {
+      return OutputNextFrame(cc);
+    }
+    return ::mediapipe::OkStatus();
+  }
+};
+REGISTER_CALCULATOR(GifDecoderCalculator);
+
+::mediapipe::Status GifDecoderCalculator::LoadGif(const std::string& data) {
+  auto new_decoder = absl::make_unique<GifDecoder>();
+  MP_RETURN_IF_ERROR(new_decoder->Open(data));
+  decoder = std::move(new_decoder);
+  ring.clear();
+  ring_complete = false;
+  streaming = false;
+  next_ring_index = 0;
+  frame_index = 0;
+  next_frame_time = Timestamp::Unstarted();
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status GifDecoderCalculator::OutputNextFrame(
+    CalculatorContext* cc) {
+  DecodedFrame decoded_frame;
+  const DecodedFrame* frame = &decoded_frame;
+  if (!ring_complete) {
+    bool decoded = false;
+    MP_RETURN_IF_ERROR(DecodeNextFrame(&decoded_frame, &decoded));
+    if (!decoded) {
+      RET_CHECK_GT(frame_index, 0) << "GIF has no frames";
+      if (!streaming) {
+        ring_complete = true;
+      } else {
+        // Too many frames to keep, so decode them again on every loop
+        frame_index = 0;
+        decoder->Rewind();
+        MP_RETURN_IF_ERROR(DecodeNextFrame(&decoded_frame, &decoded));
+        RET_CHECK(decoded);
+      }
+    }
+    if (decoded) {
+      ++frame_index;
+      cc->GetCounter("GifDecoderFrames")->Increment();
+      // Keep the first frames until it is known whether they all fit
+      if (!streaming && frame_index <= ring_size) {
+        ring.push_back(decoded_frame);
+      } else if (!streaming) {
+        streaming = true;
+        ring.clear();
+      }
+    }
+  }
+  if (ring_complete) {
+    // A still GIF was output once, and is kept by the overlay from then on
+    if (ring.size() == 1) {
+      next_frame_time = Timestamp::Done();
+      return ::mediapipe::OkStatus();
+    }
+    frame = &ring[next_ring_index];
+    next_ring_index = (next_ring_index + 1) % ring.size();
+  }
+
+  cc->Outputs().Tag(kTextureTag).AddPacket(
+      frame->texture.At(cc->InputTimestamp()));
+  next_frame_time =
+      cc->InputTimestamp() + TimestampDiff(frame->delay_ms * 1000);
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status GifDecoderCalculator::DecodeNextFrame(DecodedFrame* frame,
+                                                          bool* decoded) {
+  MP_RETURN_IF_ERROR(decoder->DecodeNextFrame(decoded));
+  if (!*decoded) {
+    return ::mediapipe::OkStatus();
+  }
+  const int width = decoder->width();
+  const int height = decoder->height();
+  auto texture = absl::make_unique<ImageFrame>(
+      ImageFormat::SRGBA, width, height,
+      ImageFrame::kGlDefaultAlignmentBoundary);
+  // Mirror each row while copying it out of the canvas
+  const uint8* canvas = decoder->canvas();
+  for (int y = 0; y < height; ++y) {
+    const uint8* source_row = canvas + static_cast<size_t>(y) * width * 4;
+    uint8* destination_row =
+        texture->MutablePixelData() + y * texture->WidthStep();
+    for (int x = 0; x < width; ++x) {
+      std::memcpy(destination_row + (width - 1 - x) * 4, source_row + x * 4,
+                  4);
+    }
+  }
+  frame->texture = Adopt(texture.release());
+  frame->delay_ms = decoder->frame_delay_ms() < kMinFrameDelayMs
+                        ? kDefaultFrameDelayMs
+                        : decoder->frame_delay_ms();
+  return ::mediapipe::OkStatus();
+}
+}
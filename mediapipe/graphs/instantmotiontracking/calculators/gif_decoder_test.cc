@@ -0,0 +1,253 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/graphs/instantmotiontracking/calculators/gif_decoder.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/integral_types.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/gif_test_util.h"
+
+namespace mediapipe {
+namespace {
+
+// Black, red, green and blue
+const std::vector<uint8> kFourColors = {0,   0, 0, 255, 0,   0,
+                                        0, 255, 0, 0,   0, 255};
+constexpr int kRed = 1;
+constexpr int kGreen = 2;
+constexpr int kBlue = 3;
+
+// 10x10 GIF with a white, red, blue and black color table, as produced by an
+// independent encoder, whose LZW data grows from 3 to 4 bit codes
+const uint8 kReferenceGif[] = {
+    0x47, 0x49, 0x46, 0x38, 0x39, 0x61, 0x0A, 0x00, 0x0A, 0x00, 0x91, 0x00,
+    0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00,
+    0x00, 0x21, 0xF9, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x2C, 0x00, 0x00,
+    0x00, 0x00, 0x0A, 0x00, 0x0A, 0x00, 0x00, 0x02, 0x16, 0x8C, 0x2D, 0x99,
+    0x87, 0x2A, 0x1C, 0xDC, 0x33, 0xA0, 0x02, 0x75, 0xEC, 0x95, 0xFA, 0xA8,
+    0xDE, 0x60, 0x8C, 0x04, 0x91, 0x4C, 0x01, 0x00, 0x3B};
+// Color indices of the reference GIF, every row given by the indices of its
+// 5 left and 5 right pixels, or of its 3 left, 4 middle and 3 right pixels
+constexpr int kReferenceRows[10][3] = {
+    {1, 1, 2}, {1, 1, 2}, {1, 1, 2}, {1, 0, 2}, {1, 0, 2},
+    {2, 0, 1}, {2, 0, 1}, {2, 2, 1}, {2, 2, 1}, {2, 2, 1}};
+constexpr uint8 kReferenceColors[4][3] = {
+    {255, 255, 255}, {255, 0, 0}, {0, 0, 255}, {0, 0, 0}};
+
+// Returns the index of the color of the pixel at (x, y) in the reference GIF
+int ReferenceIndex(int x, int y) {
+  const int* row = kReferenceRows[y];
+  if (row[0] == row[1]) {
+    return x < 5 ? row[0] : row[2];
+  }
+  return x < 3 ? row[0] : x < 7 ? row[1] : row[2];
+}
+
+GifTestFrame MakeSolidFrame(int left, int top, int width, int height,
+                            int index) {
+  GifTestFrame frame;
+  frame.left = left;
+  frame.top = top;
+  frame.width = width;
+  frame.height = height;
+  frame.indices.assign(width * height, index);
+  return frame;
+}
+
+const uint8* Pixel(const GifDecoder& decoder, int x, int y) {
+  return decoder.canvas() + (y * decoder.width() + x) * 4;
+}
+
+void ExpectColor(const GifDecoder& decoder, int x, int y, int index) {
+  const uint8* pixel = Pixel(decoder, x, y);
+  EXPECT_EQ(pixel[0], kFourColors[index * 3]) << "at " << x << ", " << y;
+  EXPECT_EQ(pixel[1], kFourColors[index * 3 + 1]) << "at " << x << ", " << y;
+  EXPECT_EQ(pixel[2], kFourColors[index * 3 + 2]) << "at " << x << ", " << y;
+  EXPECT_EQ(pixel[3], 255) << "at " << x << ", " << y;
+}
+
+void DecodeFrames(int num_frames, GifDecoder* decoder) {
+  for (int i = 0; i < num_frames; ++i) {
+    bool decoded = false;
+    MP_ASSERT_OK(decoder->DecodeNextFrame(&decoded));
+    ASSERT_TRUE(decoded) << "frame " << i;
+  }
+}
+
+// Decodes a red canvas, then a blue square in its top left corner with the
+// given disposal, then a green pixel in its bottom right corner
+void DecodeAfterDisposal(int disposal, GifDecoder* decoder) {
+  GifTestFrame square = MakeSolidFrame(0, 0, 2, 2, kBlue);
+  square.disposal = disposal;
+  MP_ASSERT_OK(decoder->Open(EncodeGif(
+      4, 4, kFourColors,
+      {MakeSolidFrame(0, 0, 4, 4, kRed), square,
+       MakeSolidFrame(3, 3, 1, 1, kGreen)})));
+  DecodeFrames(3, decoder);
+  ExpectColor(*decoder, 3, 3, kGreen);
+  ExpectColor(*decoder, 2, 2, kRed);
+}
+
+TEST(GifDecoderTest, DecodesReferenceLzwData) {
+  GifDecoder decoder;
+  MP_ASSERT_OK(decoder.Open(std::string(
+      reinterpret_cast<const char*>(kReferenceGif), sizeof(kReferenceGif))));
+  ASSERT_EQ(decoder.width(), 10);
+  ASSERT_EQ(decoder.height(), 10);
+  DecodeFrames(1, &decoder);
+  for (int y = 0; y < 10; ++y) {
+    for (int x = 0; x < 10; ++x) {
+      const uint8* pixel = Pixel(decoder, x, y);
+      const uint8* color = kReferenceColors[ReferenceIndex(x, y)];
+      EXPECT_EQ(pixel[0], color[0]) << "at " << x << ", " << y;
+      EXPECT_EQ(pixel[1], color[1]) << "at " << x << ", " << y;
+      EXPECT_EQ(pixel[2], color[2]) << "at " << x << ", " << y;
+      EXPECT_EQ(pixel[3], 255) << "at " << x << ", " << y;
+    }
+  }
+  bool decoded = true;
+  MP_ASSERT_OK(decoder.DecodeNextFrame(&decoded));
+  EXPECT_FALSE(decoded);
+}
+
+TEST(GifDecoderTest, DecodesNoiseThroughFullLzwTables) {
+  // Random indices barely compress, so the 12 bit string table fills up and
+  // is cleared many times over
+  constexpr int kSize = 128;
+  std::vector<uint8> color_table;
+  for (int i = 0; i < 256; ++i) {
+    color_table.insert(color_table.end(), {static_cast<uint8>(i),
+                                           static_cast<uint8>(255 - i),
+                                           static_cast<uint8>(i * 7)});
+  }
+  GifTestFrame frame = MakeSolidFrame(0, 0, kSize, kSize, 0);
+  uint32 state = 1;
+  for (uint8& index : frame.indices) {
+    state = state * 1103515245 + 12345;
+    index = state >> 24;
+  }
+  // Runs of a single index take the code not yet in the table
+  std::fill(frame.indices.begin(), frame.indices.begin() + 100, 7);
+
+  GifDecoder decoder;
+  MP_ASSERT_OK(decoder.Open(EncodeGif(kSize, kSize, color_table, {frame})));
+  DecodeFrames(1, &decoder);
+  int mismatches = 0;
+  for (int i = 0; i < kSize * kSize; ++i) {
+    const uint8* pixel = decoder.canvas() + i * 4;
+    const uint8* color = &color_table[frame.indices[i] * 3];
+    if (pixel[0] != color[0] || pixel[1] != color[1] ||
+        pixel[2] != color[2] || pixel[3] != 255) {
+      ++mismatches;
+    }
+  }
+  EXPECT_EQ(mismatches, 0);
+}
+
+TEST(GifDecoderTest, DecodesInterlacedRows) {
+  // 11 rows leave the last rows of every pass short
+  constexpr int kWidth = 3;
+  constexpr int kHeight = 11;
+  GifTestFrame frame = MakeSolidFrame(0, 0, kWidth, kHeight, 0);
+  frame.interlaced = true;
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      frame.indices[y * kWidth + x] = (x + y) % 4;
+    }
+  }
+  GifDecoder decoder;
+  MP_ASSERT_OK(
+      decoder.Open(EncodeGif(kWidth, kHeight, kFourColors, {frame})));
+  DecodeFrames(1, &decoder);
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      ExpectColor(decoder, x, y, (x + y) % 4);
+    }
+  }
+}
+
+TEST(GifDecoderTest, KeepsFrameWithoutDisposal) {
+  GifDecoder decoder;
+  DecodeAfterDisposal(/*disposal=*/1, &decoder);
+  ExpectColor(decoder, 0, 0, kBlue);
+  ExpectColor(decoder, 1, 1, kBlue);
+}
+
+TEST(GifDecoderTest, DisposesFrameToTransparentBackground) {
+  GifDecoder decoder;
+  DecodeAfterDisposal(/*disposal=*/2, &decoder);
+  EXPECT_EQ(Pixel(decoder, 0, 0)[3], 0);
+  EXPECT_EQ(Pixel(decoder, 1, 1)[3], 0);
+  ExpectColor(decoder, 2, 0, kRed);
+}
+
+TEST(GifDecoderTest, DisposesFrameToPreviousCanvas) {
+  GifDecoder decoder;
+  DecodeAfterDisposal(/*disposal=*/3, &decoder);
+  ExpectColor(decoder, 0, 0, kRed);
+  ExpectColor(decoder, 1, 1, kRed);
+}
+
+TEST(GifDecoderTest, TransparentIndexKeepsCanvas) {
+  GifTestFrame frame = MakeSolidFrame(0, 0, 2, 1, kBlue);
+  frame.indices[1] = kGreen;
+  frame.transparent_index = kGreen;
+  frame.delay_centiseconds = 7;
+  GifDecoder decoder;
+  MP_ASSERT_OK(decoder.Open(EncodeGif(
+      2, 1, kFourColors, {MakeSolidFrame(0, 0, 2, 1, kRed), frame})));
+  DecodeFrames(2, &decoder);
+  ExpectColor(decoder, 0, 0, kBlue);
+  ExpectColor(decoder, 1, 0, kRed);
+  EXPECT_EQ(decoder.frame_delay_ms(), 70);
+}
+
+TEST(GifDecoderTest, RewindRestartsFromFirstFrame) {
+  GifDecoder decoder;
+  MP_ASSERT_OK(decoder.Open(EncodeGif(
+      2, 2, kFourColors,
+      {MakeSolidFrame(0, 0, 2, 2, kRed), MakeSolidFrame(0, 0, 1, 1, kBlue)})));
+  DecodeFrames(2, &decoder);
+  bool decoded = true;
+  MP_ASSERT_OK(decoder.DecodeNextFrame(&decoded));
+  EXPECT_FALSE(decoded);
+
+  decoder.Rewind();
+  EXPECT_EQ(Pixel(decoder, 0, 0)[3], 0);
+  DecodeFrames(1, &decoder);
+  ExpectColor(decoder, 0, 0, kRed);
+}
+
+TEST(GifDecoderTest, RejectsTruncatedImages) {
+  const std::string gif = EncodeGif(
+      4, 4, kFourColors,
+      {MakeSolidFrame(0, 0, 4, 4, kRed), MakeSolidFrame(1, 1, 2, 2, kBlue)});
+  for (size_t size = 0; size < gif.size(); ++size) {
+    GifDecoder decoder;
+    ::mediapipe::Status status = decoder.Open(gif.substr(0, size));
+    bool decoded = true;
+    while (status.ok() && decoded) {
+      status = decoder.DecodeNextFrame(&decoded);
+    }
+    EXPECT_FALSE(status.ok()) << "truncated to " << size << " bytes";
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
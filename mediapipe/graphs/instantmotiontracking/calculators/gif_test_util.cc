@@ -0,0 +1,175 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/graphs/instantmotiontracking/calculators/gif_test_util.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace mediapipe {
+
+namespace {
+
+constexpr int kMaxLzwBits = 12;
+constexpr int kMaxLzwCodes = 1 << kMaxLzwBits;
+constexpr int kMaxSubBlockSize = 255;
+// First row and row step of each pass over an interlaced frame
+constexpr int kInterlacedPasses = 4;
+constexpr int kInterlacedFirstRow[kInterlacedPasses] = {0, 4, 2, 1};
+constexpr int kInterlacedRowStep[kInterlacedPasses] = {8, 8, 4, 2};
+
+void AppendLe16(int value, std::string* out) {
+  out->push_back(static_cast<char>(value & 0xFF));
+  out->push_back(static_cast<char>((value >> 8) & 0xFF));
+}
+
+// Packs codes into bytes, least significant bit first
+class BitWriter {
+ public:
+  void Write(int code, int code_size) {
+    bits_ |= static_cast<uint32>(code) << num_bits_;
+    num_bits_ += code_size;
+    while (num_bits_ >= 8) {
+      bytes_.push_back(static_cast<char>(bits_ & 0xFF));
+      bits_ >>= 8;
+      num_bits_ -= 8;
+    }
+  }
+
+  std::string Finish() {
+    if (num_bits_ > 0) {
+      bytes_.push_back(static_cast<char>(bits_ & 0xFF));
+    }
+    return bytes_;
+  }
+
+ private:
+  std::string bytes_;
+  uint32 bits_ = 0;
+  int num_bits_ = 0;
+};
+
+// Returns the LZW code stream of the indices
+std::string EncodeLzw(const std::vector<uint8>& indices, int min_code_size) {
+  const int clear_code = 1 << min_code_size;
+  const int end_code = clear_code + 1;
+  BitWriter writer;
+  std::map<std::pair<int, int>, int> table;
+  int code_size = min_code_size + 1;
+  int next_code = end_code + 1;
+  writer.Write(clear_code, code_size);
+  int prefix = indices.front();
+  for (size_t i = 1; i < indices.size(); ++i) {
+    auto entry = table.find({prefix, indices[i]});
+    if (entry != table.end()) {
+      prefix = entry->second;
+      continue;
+    }
+    writer.Write(prefix, code_size);
+    table[{prefix, indices[i]}] = next_code++;
+    // The decoder adds each entry one code later, and so widens its codes
+    // once the code after the widest one is in the table
+    if (next_code > (1 << code_size) && code_size < kMaxLzwBits) {
+      ++code_size;
+    }
+    if (next_code == kMaxLzwCodes) {
+      writer.Write(clear_code, code_size);
+      table.clear();
+      code_size = min_code_size + 1;
+      next_code = end_code + 1;
+    }
+    prefix = indices[i];
+  }
+  writer.Write(prefix, code_size);
+  // The decoder adds an entry for the last code too, before the end code
+  if (next_code > end_code + 1 && next_code == (1 << code_size) &&
+      code_size < kMaxLzwBits) {
+    ++code_size;
+  }
+  writer.Write(end_code, code_size);
+  return writer.Finish();
+}
+
+// Reorders the rows of a frame as they are stored when interlaced
+std::vector<uint8> InterlaceRows(const GifTestFrame& frame) {
+  std::vector<uint8> indices;
+  indices.reserve(frame.indices.size());
+  for (int pass = 0; pass < kInterlacedPasses; ++pass) {
+    for (int row = kInterlacedFirstRow[pass]; row < frame.height;
+         row += kInterlacedRowStep[pass]) {
+      indices.insert(indices.end(),
+                     frame.indices.begin() + row * frame.width,
+                     frame.indices.begin() + (row + 1) * frame.width);
+    }
+  }
+  return indices;
+}
+
+}  // namespace
+
+std::string EncodeGif(int width, int height,
+                      const std::vector<uint8>& color_table,
+                      const std::vector<GifTestFrame>& frames) {
+  const int num_colors = color_table.size() / 3;
+  int color_bits = 1;
+  while ((1 << color_bits) < num_colors) {
+    ++color_bits;
+  }
+
+  std::string gif = "GIF89a";
+  AppendLe16(width, &gif);
+  AppendLe16(height, &gif);
+  // Global color table, with 8 bits per primary color
+  gif.push_back(static_cast<char>(0xF0 | (color_bits - 1)));
+  gif.push_back(0);
+  gif.push_back(0);
+  gif.append(color_table.begin(), color_table.end());
+
+  for (const GifTestFrame& frame : frames) {
+    // Graphic control extension
+    gif.append({'\x21', '\xF9', '\x04'});
+    gif.push_back(static_cast<char>((frame.disposal << 2) |
+                                    (frame.transparent_index >= 0 ? 1 : 0)));
+    AppendLe16(frame.delay_centiseconds, &gif);
+    gif.push_back(static_cast<char>(std::max(frame.transparent_index, 0)));
+    gif.push_back(0);
+
+    // Image descriptor, without a local color table
+    gif.push_back('\x2C');
+    AppendLe16(frame.left, &gif);
+    AppendLe16(frame.top, &gif);
+    AppendLe16(frame.width, &gif);
+    AppendLe16(frame.height, &gif);
+    gif.push_back(frame.interlaced ? '\x40' : '\x00');
+
+    // The minimum code size is at least 2, even for two colors
+    const int min_code_size = std::max(color_bits, 2);
+    const std::string data = EncodeLzw(
+        frame.interlaced ? InterlaceRows(frame) : frame.indices,
+        min_code_size);
+    gif.push_back(static_cast<char>(min_code_size));
+    for (size_t i = 0; i < data.size(); i += kMaxSubBlockSize) {
+      const size_t block_size =
+          std::min<size_t>(kMaxSubBlockSize, data.size() - i);
+      gif.push_back(static_cast<char>(block_size));
+      gif.append(data, i, block_size);
+    }
+    gif.push_back(0);
+  }
+  gif.push_back('\x3B');
+  return gif;
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,51 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_GIF_TEST_UTIL_H_
+#define MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_GIF_TEST_UTIL_H_
+
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/port/integral_types.h"
+
+namespace mediapipe {
+
+// A frame of a GIF image to encode
+struct GifTestFrame {
+  // Frame rectangle, in canvas pixels
+  int left = 0;
+  int top = 0;
+  int width = 0;
+  int height = 0;
+  // Color table index of every pixel of the frame, row by row from the top
+  std::vector<uint8> indices;
+  bool interlaced = false;
+  // Graphic control of the frame
+  int disposal = 0;
+  int delay_centiseconds = 0;
+  int transparent_index = -1;
+};
+
+// Encodes an animated GIF89a image with the given global color table, of RGB
+// triplets whose count is a power of two from 2 to 256. The frame data is LZW
+// compressed with a growing code size, clearing the string table once full,
+// as GIF encoders do.
+std::string EncodeGif(int width, int height,
+                      const std::vector<uint8>& color_table,
+                      const std::vector<GifTestFrame>& frames);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_GIF_TEST_UTIL_H_
@@ -12,21 +12,30 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#if defined(__ANDROID__)
-#include "mediapipe/util/android/asset_manager_util.h"
-#else
-#include <fstream>
-#include <iostream>
-#endif
-
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "absl/hash/hash.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/integral_types.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status.h"
 #include "mediapipe/gpu/gl_calculator_helper.h"
 #include "mediapipe/gpu/shader_util.h"
+#include "mediapipe/framework/port/singleton.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/animation_asset.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/animation_asset_cache.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/compressed_texture.h"
 #include "mediapipe/graphs/object_detection_3d/calculators/camera_parameters.pb.h"
 #include "mediapipe/graphs/object_detection_3d/calculators/gl_animation_overlay_calculator.pb.h"
 #include "mediapipe/graphs/object_detection_3d/calculators/model_matrix.pb.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/model_matrix_buffer.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/sticker_buffer.pb.h"
 
 namespace mediapipe {
 
@@ -48,7 +57,28 @@ typedef GpuBuffer AssetTextureFormat;
 #endif
 
 enum { ATTRIB_VERTEX, ATTRIB_TEXTURE_POSITION, ATTRIB_NORMAL, NUM_ATTRIBUTES };
-static const int kNumMatrixEntries = 16;
+static const int kNumMatrixEntries = kModelMatrixSize;
+// When rendering instanced, the per-instance model matrix occupies the four
+// attribute locations following the per-vertex attributes, one per column.
+static const int kAttribModelMatrix = NUM_ATTRIBUTES;
+static const int kNumModelMatrixColumns = 4;
+
+// Instanced rendering requires OpenGL ES 3.0 headers at compile time, and an
+// OpenGL ES 3.0 context at run time.
+#if defined(GL_ES_VERSION_3_0)
+#define GL_ANIMATION_OVERLAY_INSTANCING 1
+#endif
+
+// Texture frame transform sampling the whole texture, as a scale and offset
+static const float kFullTextureFrameTransform[] = {1.0f, 1.0f, 0.0f, 0.0f};
+// Atlas frames without a display duration, or shorter than the minimum, are
+// shown for the default duration instead, as GIF viewers commonly do.
+static const int kMinAtlasFrameDelayMs = 20;
+static const int kDefaultAtlasFrameDelayMs = 100;
+
+static const char kTextureUploadsCounter[] = "GlAnimationOverlayTextureUploads";
+static const char kTextureUploadsSkippedCounter[] =
+    "GlAnimationOverlayTextureUploadsSkipped";
 
 // Hard-coded MVP Matrix for testing.
 static const float kModelMatrix[] = {0.83704215,  -0.36174262, 0.41049102, 0.0,
@@ -56,41 +86,86 @@ static const float kModelMatrix[] = {0.83704215,  -0.36174262, 0.41049102, 0.0,
                                      -0.54367524, -0.4656292,  0.69828844, 0.0,
                                      0.0,         0.0,         -98.64117,  1.0};
 
-// Loads a texture from an input side packet, and streams in an animation file
-// from a filename given in another input side packet, and renders the animation
-// over the screen according to the input timestamp and desired animation FPS.
+// Loads textures from input side packets or streams, and animation files from
+// filenames given in other input side packets, and renders the animations over
+// the screen according to the input timestamp and desired animation FPS.
+//
+// Any number of animations can be rendered in a single pass, sharing one depth
+// buffer. Each animation occupies an asset slot, given by the index of its
+// ANIMATION_ASSET side packet, and is rendered with the TEXTURE and model
+// matrices of the same index. Slots are drawn in index order.
 //
 // Inputs:
 //   VIDEO (GpuBuffer, optional):
 //     If provided, the input buffer will be assumed to be unique, and will be
 //     consumed by this calculator and rendered to directly.  The output video
 //     buffer will then be the released reference to the input video buffer.
-//   MODEL_MATRICES (TimedModelMatrixProtoList, optional):
-//     If provided, will set the model matrices for the objects to be rendered
-//     during future rendering calls.
-//   TEXTURE (ImageFrame on Android / GpuBuffer on iOS, semi-optional):
-//     Texture to use with animation file. Texture is REQUIRED to be passed into
-//     the calculator, but can be passed in as a Side Packet OR Input Stream.
+//   MODEL_MATRICES:n (TimedModelMatrixProtoList, optional):
+//     If provided, will set the model matrices for the objects of asset slot n
+//     to be rendered during future rendering calls.
+//   MODEL_MATRIX_BUFFER:n (ModelMatrixBuffer, optional):
+//     Same as MODEL_MATRICES:n, but with the column-major matrices already laid
+//     out contiguously, which are rendered without any conversion or copies.
+//     Cannot be used together with MODEL_MATRICES:n. An asset slot with
+//     neither renders a single object at a fixed position.
+//   TEXTURE:n (ImageFrame on Android / GpuBuffer on iOS, semi-optional):
+//     Texture to use with animation file n. Texture is REQUIRED to be passed
+//     into the calculator, but can be passed in as a Side Packet OR Input
+//     Stream. A texture with the same contents as the previous one on
+//     Android, or the same GpuBuffer elsewhere, is not uploaded again, even
+//     when re-sent in a new packet.
+//   TEXTURE_ATLAS:n (String, optional):
+//     Serialized TextureAtlas proto, given whenever TEXTURE:n changes to an
+//     animated texture with all its frames packed into a grid. The frame
+//     sampled from is picked from the input timestamp and the frame display
+//     durations, starting with the first frame when the atlas is received, so
+//     that TEXTURE:n is only uploaded once per animation.
 //
 // Input side packets:
-//   TEXTURE (ImageFrame on Android / GpuBuffer on iOS, semi-optional):
-//     Texture to use with animation file. Texture is REQUIRED to be passed into
-//     the calculator, but can be passed in as a Side Packet OR Input Stream.
-//   ANIMATION_ASSET (String, required):
-//     Path of animation file to load and render. Should be generated by
+//   TEXTURE:n (ImageFrame on Android / GpuBuffer on iOS, or String,
+//              semi-optional):
+//     Texture to use with animation file n. Texture is REQUIRED to be passed
+//     into the calculator, but can be passed in as a Side Packet OR Input
+//     Stream. As a side packet, it can also be the path of a KTX or KTX2
+//     texture compressed in ETC2 or ASTC, generated by texture_asset_converter,
+//     which is uploaded as is. ETC2 textures are decoded on the CPU instead in
+//     contexts lacking the format.
+//   ANIMATION_ASSET:n (String, at least one required):
+//     Path of animation file to load and render in asset slot n. Should be a
+//     binary animation asset generated by animation_asset_converter, which is
+//     memory-mapped and uploaded to the GPU as is. Animations in the custom
+//     .obj.uuu file format generated by
 //     //java/com/google/android/apps/motionstills/SimpleObjEncryptor with
-//     --compressed_mode=true.  See comments and documentation there for more
-//     information on custom .obj.uuu file format.
+//     --compressed_mode=true are still accepted, but are converted on load.
+//   MASK_ASSET (String, optional):
+//     Path of an animation file in the same format as ANIMATION_ASSET, whose
+//     first frame is rendered into the depth buffer only, to occlude objects.
 //   CAMERA_PARAMETERS_PROTO_STRING (String, optional):
 //     Serialized proto std::string of CameraParametersProto. We need this to
 //     get the right aspect ratio and field of view.
+//   FOV (float, optional):
+//     Vertical field of view in radians, overriding the vertical_fov_degrees
+//     option and CAMERA_PARAMETERS_PROTO_STRING. Should be the FOV side packet
+//     given to the MatricesManagerCalculator, so that stickers are projected
+//     with the same frustum they are culled with.
+//   ASPECT_RATIO (float, optional):
+//     Aspect ratio of the rendered image, overriding the aspect_ratio option
+//     and CAMERA_PARAMETERS_PROTO_STRING, for the same reason as FOV.
+//   ASSET_CACHE_MAX_BYTES (int64, optional):
+//     Memory budget of the process-wide AnimationAssetCache, which keeps
+//     animations, and their GPU buffers, loaded after all calculators using
+//     them are gone.
+//   INSTANCING (bool, optional):
+//     Whether to draw each asset slot with a single instanced draw call in
+//     OpenGL ES 3.0 contexts. Defaults to true; false always draws one object
+//     per draw call, as in OpenGL ES 2.0 contexts, to compare the two.
 // Options:
 //   aspect_ratio: the ratio between the rendered image width and height.
-//     It will be ignored if CAMERA_PARAMETERS_PROTO_STRING input side packet
-//     is provided.
+//     It will be ignored if the ASPECT_RATIO or CAMERA_PARAMETERS_PROTO_STRING
+//     input side packet is provided.
 //   vertical_fov_degrees: vertical field of view in degrees.
-//     It will be ignored if CAMERA_PARAMETERS_PROTO_STRING input side packet
-//     is provided.
+//     It will be ignored if the FOV or CAMERA_PARAMETERS_PROTO_STRING input
+//     side packet is provided.
 //   z_clipping_plane_near: near plane value for z-clipping.
 //   z_clipping_plane_far: far plane value for z-clipping.
 //   animation_speed_fps: speed at which to cycle through animation frames (in
@@ -99,18 +174,116 @@ static const float kModelMatrix[] = {0.83704215,  -0.36174262, 0.41049102, 0.0,
 // Outputs:
 //   OUTPUT, or index 0 (GpuBuffer):
 //     Frames filled with the given texture.
+//
+// Example config rendering two animations over the input video:
+// node {
+//   calculator: "GlAnimationOverlayCalculator"
+//   input_stream: "VIDEO:input_video"
+//   input_stream: "MODEL_MATRIX_BUFFER:0:gif_matrices"
+//   input_stream: "MODEL_MATRIX_BUFFER:1:asset_3d_matrices"
+//   input_stream: "TEXTURE:0:gif_texture"
+//   input_stream: "TEXTURE_ATLAS:0:gif_texture_atlas"
+//   input_side_packet: "TEXTURE:1:texture_3d"
+//   input_side_packet: "ANIMATION_ASSET:0:gif_asset_name"
+//   input_side_packet: "ANIMATION_ASSET:1:asset_3d"
+//   output_stream: "output_video"
+// }
+//
+// Animations are shared through the AnimationAssetCache, so calculators, and
+// later graph runs, rendering the same animation parse it only once, and
+// upload it only once per GlContext.
+//
+// On OpenGL ES 3.0 contexts, all objects sharing an animation frame are drawn
+// with a single instanced draw call, with their model matrices uploaded as an
+// instanced vertex attribute. OpenGL ES 2.0 contexts fall back to one draw call
+// per model matrix.
+
+// The GPU vertex buffers use the interleaved vertex layout of the binary
+// animation asset format.
+static const GLsizei kVertexStride = kAnimationVertexFloats * sizeof(float);
 
-// Simple helper-struct for containing the parsed geometry data from a 3D
-// animation frame for rendering.
+// Simple helper-struct for locating the geometry data of a 3D animation frame
+// within its animation's GPU buffers for rendering.
 struct TriangleMesh {
   int index_count = 0;  // Needed for glDrawElements rendering call
-  std::unique_ptr<float[]> normals = nullptr;
-  std::unique_ptr<float[]> vertices = nullptr;
-  std::unique_ptr<float[]> texture_coords = nullptr;
-  std::unique_ptr<int16[]> triangle_indices = nullptr;
+  // Byte offsets of this frame's data within the AnimationGpuBuffers
+  GLintptr vertex_offset = 0;
+  GLintptr index_offset = 0;
 };
 
-typedef std::unique_ptr<float[]> ModelMatrix;
+// An animation, along with the texture and model matrices it is rendered with.
+struct AssetSlot {
+  // Acquired from the AnimationAssetCache, whose GPU buffers are looked up on
+  // the first call to Process
+  std::shared_ptr<const CachedAnimation> animation;
+  std::vector<TriangleMesh> meshes;
+  std::shared_ptr<const AnimationGpuBuffers> buffers;
+  GlTexture texture;
+  // Texture loaded from a compressed texture asset instead, owned by the slot
+  GLuint asset_texture = 0;
+  bool has_texture_stream = false;
+  // Latest TEXTURE packet uploaded, held so that its contents cannot be
+  // replaced while texture still shows them, and the TextureContentKey of it
+  Packet texture_packet;
+  size_t texture_content_key = 0;
+  bool has_texture_atlas_stream = false;
+  // Grid of the texture atlas, and the time each of its frames stops being
+  // displayed, in milliseconds since atlas_start_time. Empty unless the
+  // texture is an atlas with more than one frame
+  int atlas_columns = 1;
+  int atlas_rows = 1;
+  std::vector<int64> atlas_frame_end_ms;
+  Timestamp atlas_start_time;
+  bool has_model_matrix_stream = false;
+  // Latest ModelMatrixBuffer packet received (or converted from protos)
+  Packet model_matrices;
+};
+
+// Target and name of the texture an asset slot is rendered with
+GLenum GetSlotTextureTarget(const AssetSlot &slot) {
+  return slot.asset_texture ? GL_TEXTURE_2D : slot.texture.target();
+}
+GLuint GetSlotTextureName(const AssetSlot &slot) {
+  return slot.asset_texture ? slot.asset_texture : slot.texture.name();
+}
+
+// Returns a key telling the contents of a TEXTURE packet apart from those of
+// the previous one. The app creates a new ImageFrame for every texture it
+// sends, so those are hashed by size, format and pixels, which costs far less
+// than the upload it may save. GpuBuffers would have to be read back to hash,
+// so only the same buffer sent again is recognized.
+#if defined(__ANDROID__)
+size_t TextureContentKey(const ImageFrame &frame) {
+  size_t key = absl::Hash<std::tuple<int, int, int>>()(std::make_tuple(
+      frame.Width(), frame.Height(), static_cast<int>(frame.Format())));
+  // Rows are hashed one by one, leaving out their alignment padding
+  const int row_size =
+      frame.Width() * frame.NumberOfChannels() * frame.ByteDepth();
+  const char *row = reinterpret_cast<const char *>(frame.PixelData());
+  for (int y = 0; y < frame.Height(); ++y, row += frame.WidthStep()) {
+    key = absl::Hash<std::pair<size_t, absl::string_view>>()(
+        std::make_pair(key, absl::string_view(row, row_size)));
+  }
+  return key;
+}
+#else
+size_t TextureContentKey(const GpuBuffer &buffer) {
+  return reinterpret_cast<size_t>(&buffer);
+}
+#endif
+
+// Returns true if the current OpenGL context can sample textures in the given
+// compressed format.
+bool IsCompressedTextureFormatSupported(GLenum format) {
+  GLint num_formats = 0;
+  glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &num_formats);
+  std::vector<GLint> formats(num_formats);
+  if (num_formats > 0) {
+    glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+  }
+  return std::find(formats.begin(), formats.end(),
+                   static_cast<GLint>(format)) != formats.end();
+}
 
 }  // namespace
 
@@ -126,31 +299,39 @@ class GlAnimationOverlayCalculator : public CalculatorBase {
 
  private:
   bool has_video_stream_ = false;
-  bool has_model_matrix_stream_ = false;
   bool has_mask_model_matrix_stream_ = false;
   bool has_occlusion_mask_ = false;
 
   GlCalculatorHelper helper_;
   bool initialized_ = false;
-  GlTexture texture_;
   GlTexture mask_texture_;
 
   GLuint renderbuffer_ = 0;
   bool depth_buffer_created_ = false;
 
   GLuint program_ = 0;
+  // False if the INSTANCING side packet disables instanced rendering
+  bool instancing_enabled_ = true;
+  // True if program_ reads its model matrix from per-instance attributes
+  bool use_instancing_ = false;
+  // Per-instance model matrices, re-filled for every instanced draw call
+  GLuint instance_buffer_ = 0;
   GLint texture_uniform_ = -1;
   GLint perspective_matrix_uniform_ = -1;
   GLint model_matrix_uniform_ = -1;
+  GLint texture_frame_transform_uniform_ = -1;
 
-  std::vector<TriangleMesh> triangle_meshes_;
+  // Animations to render, indexed by asset slot
+  std::vector<AssetSlot> slots_;
+  // Occlusion mask, acquired and looked up like the animations
+  std::shared_ptr<const CachedAnimation> mask_animation_;
   std::vector<TriangleMesh> mask_meshes_;
+  std::shared_ptr<const AnimationGpuBuffers> mask_mesh_buffers_;
   Timestamp animation_start_time_;
-  int frame_count_ = 0;
   float animation_speed_fps_;
 
-  std::vector<ModelMatrix> current_model_matrices_;
-  std::vector<ModelMatrix> current_mask_model_matrices_;
+  // Latest mask ModelMatrixBuffer packet, converted from protos
+  Packet current_mask_model_matrices_;
 
   // Perspective matrix for rendering, to be applied to all model matrices
   // prior to passing through to the shader as a MVP matrix.  Initialized during
@@ -159,30 +340,41 @@ class GlAnimationOverlayCalculator : public CalculatorBase {
   void ComputeAspectRatioAndFovFromCameraParameters(
       const CameraParametersProto &camera_parameters, float *aspect_ratio,
       float *vertical_fov_degrees);
-  int GetAnimationFrameIndex(Timestamp timestamp);
+  int GetAnimationFrameIndex(Timestamp timestamp, int frame_count);
+  ::mediapipe::Status LoadTextureAtlas(const std::string &serialized_atlas,
+                                       Timestamp timestamp, AssetSlot *slot);
+  // Writes the scale and offset, in texture coordinates, of the atlas frame of
+  // slot displayed at timestamp.
+  void GetTextureFrameTransform(const AssetSlot &slot, Timestamp timestamp,
+                                float transform[4]);
   ::mediapipe::Status GlSetup();
+  ::mediapipe::Status GlGetAnimationBuffers(
+      const std::shared_ptr<const CachedAnimation> &animation,
+      std::shared_ptr<const AnimationGpuBuffers> *buffers);
+  // Uploads the compressed texture asset at path into a new texture, decoding
+  // it first if the context does not support its format.
+  ::mediapipe::Status GlLoadCompressedTexture(const std::string &path,
+                                              GLuint *texture_name);
   ::mediapipe::Status GlBind(const TriangleMesh &triangle_mesh,
-                             const GlTexture &texture);
+                             const AnimationGpuBuffers &buffers,
+                             GLenum texture_target, GLuint texture_name,
+                             const float *texture_frame_transform);
   ::mediapipe::Status GlRender(const TriangleMesh &triangle_mesh,
                                const float *model_matrix);
+  // Renders triangle_mesh once for each of the num_matrices consecutive model
+  // matrices, using a single instanced draw call when available.
+  ::mediapipe::Status GlRenderInstances(const TriangleMesh &triangle_mesh,
+                                        const float *model_matrices,
+                                        int num_matrices);
   void InitializePerspectiveMatrix(float aspect_ratio,
                                    float vertical_fov_degrees, float z_near,
                                    float z_far);
   void LoadModelMatrices(const TimedModelMatrixProtoList &model_matrices,
-                         std::vector<ModelMatrix> *current_model_matrices);
-   void CalculateTriangleMeshNormals(TriangleMesh &triangle_mesh,
-     int normals_len);
-   void Normalize3f(float input[3]);
-
-#if !defined(__ANDROID__)
-  // Asset loading routine for all non-Android platforms.
-  bool LoadAnimation(const std::string &filename);
-#else
-  // Asset loading for all Android platforms.
-  bool LoadAnimationAndroid(const std::string &filename,
-                            std::vector<TriangleMesh> *mesh);
-  bool ReadBytesFromAsset(AAsset *asset, void *buffer, int num_bytes_to_read);
-#endif
+                         Packet *current_model_matrices);
+  ::mediapipe::Status LoadAnimation(
+      const std::string &filename,
+      std::shared_ptr<const CachedAnimation> *animation,
+      std::vector<TriangleMesh> *meshes);
 };
 REGISTER_CALCULATOR(GlAnimationOverlayCalculator);
 
@@ -197,27 +389,64 @@ REGISTER_CALCULATOR(GlAnimationOverlayCalculator);
   }
   TagOrIndex(&(cc->Outputs()), "OUTPUT", 0).Set<GpuBuffer>();
 
-  if (cc->Inputs().HasTag("MODEL_MATRICES")) {
-    cc->Inputs().Tag("MODEL_MATRICES").Set<TimedModelMatrixProtoList>();
+  const int num_slots = cc->InputSidePackets().NumEntries("ANIMATION_ASSET");
+  RET_CHECK_GT(num_slots, 0) << "At least one ANIMATION_ASSET is required";
+  RET_CHECK_LE(cc->Inputs().NumEntries("MODEL_MATRICES"), num_slots);
+  RET_CHECK_LE(cc->Inputs().NumEntries("MODEL_MATRIX_BUFFER"), num_slots);
+  RET_CHECK_LE(cc->Inputs().NumEntries("TEXTURE") +
+                   cc->InputSidePackets().NumEntries("TEXTURE"),
+               num_slots);
+  for (int i = 0; i < num_slots; ++i) {
+    cc->InputSidePackets().Get("ANIMATION_ASSET", i).Set<std::string>();
+
+    const CollectionItemId matrices_id =
+        cc->Inputs().GetId("MODEL_MATRICES", i);
+    const CollectionItemId matrix_buffer_id =
+        cc->Inputs().GetId("MODEL_MATRIX_BUFFER", i);
+    RET_CHECK(!(matrices_id.IsValid() && matrix_buffer_id.IsValid()))
+        << "Only one of MODEL_MATRICES or MODEL_MATRIX_BUFFER can be provided "
+           "for asset slot "
+        << i;
+    if (matrices_id.IsValid()) {
+      cc->Inputs().Get(matrices_id).Set<TimedModelMatrixProtoList>();
+    }
+    if (matrix_buffer_id.IsValid()) {
+      cc->Inputs().Get(matrix_buffer_id).Set<ModelMatrixBuffer>();
+    }
+
+    // Must have texture as Input Stream or Side Packet
+    const CollectionItemId texture_side_packet_id =
+        cc->InputSidePackets().GetId("TEXTURE", i);
+    if (texture_side_packet_id.IsValid()) {
+      cc->InputSidePackets().Get(texture_side_packet_id)
+          .SetOneOf<AssetTextureFormat, std::string>();
+    } else {
+      const CollectionItemId texture_id = cc->Inputs().GetId("TEXTURE", i);
+      RET_CHECK(texture_id.IsValid()) << "Missing TEXTURE for asset slot " << i;
+      cc->Inputs().Get(texture_id).Set<AssetTextureFormat>();
+    }
+    const CollectionItemId atlas_id = cc->Inputs().GetId("TEXTURE_ATLAS", i);
+    if (atlas_id.IsValid()) {
+      RET_CHECK(cc->Inputs().GetId("TEXTURE", i).IsValid())
+          << "TEXTURE_ATLAS requires a TEXTURE stream for asset slot " << i;
+      cc->Inputs().Get(atlas_id).Set<std::string>();
+    }
   }
   if (cc->Inputs().HasTag("MASK_MODEL_MATRICES")) {
     cc->Inputs().Tag("MASK_MODEL_MATRICES").Set<TimedModelMatrixProtoList>();
   }
 
-  // Must have texture as Input Stream or Side Packet
-  if (cc->InputSidePackets().HasTag("TEXTURE")) {
-    cc->InputSidePackets().Tag("TEXTURE").Set<AssetTextureFormat>();
-  }
-  else {
-    cc->Inputs().Tag("TEXTURE").Set<AssetTextureFormat>();
-  }
-
-  cc->InputSidePackets().Tag("ANIMATION_ASSET").Set<std::string>();
   if (cc->InputSidePackets().HasTag("CAMERA_PARAMETERS_PROTO_STRING")) {
     cc->InputSidePackets()
         .Tag("CAMERA_PARAMETERS_PROTO_STRING")
         .Set<std::string>();
   }
+  if (cc->InputSidePackets().HasTag("FOV")) {
+    cc->InputSidePackets().Tag("FOV").Set<float>();
+  }
+  if (cc->InputSidePackets().HasTag("ASPECT_RATIO")) {
+    cc->InputSidePackets().Tag("ASPECT_RATIO").Set<float>();
+  }
 
   if (cc->InputSidePackets().HasTag("MASK_TEXTURE")) {
     cc->InputSidePackets().Tag("MASK_TEXTURE").Set<AssetTextureFormat>();
@@ -225,85 +454,14 @@ REGISTER_CALCULATOR(GlAnimationOverlayCalculator);
   if (cc->InputSidePackets().HasTag("MASK_ASSET")) {
     cc->InputSidePackets().Tag("MASK_ASSET").Set<std::string>();
   }
-
-  return ::mediapipe::OkStatus();
-}
-
-void GlAnimationOverlayCalculator::CalculateTriangleMeshNormals(
-  TriangleMesh &triangle_mesh, int normals_len) {
-  // Set triangle_mesh normals for shader usage
-  triangle_mesh.normals.reset(new float[normals_len]);
-  // Used for storing the vertex normals prior to averaging
-  float vertex_normals_sum[normals_len];
-  // Compute every triangle surface normal and store them for averaging
-  for (int idx = 0; idx < triangle_mesh.index_count; idx += 3) {
-    int v_idx[3];
-    v_idx[0] = triangle_mesh.triangle_indices.get()[idx];
-    v_idx[1] = triangle_mesh.triangle_indices.get()[idx + 1];
-    v_idx[2] = triangle_mesh.triangle_indices.get()[idx + 2];
-    // (V1) vertex X,Y,Z indices in triangle_mesh.vertices
-    float V1x = triangle_mesh.vertices[v_idx[0] * 3];
-    float V1y = triangle_mesh.vertices[v_idx[0] * 3 + 1];
-    float V1z = triangle_mesh.vertices[v_idx[0] * 3 + 2];
-    // (V2) vertex X,Y,Z indices in triangle_mesh.vertices
-    float V2x = triangle_mesh.vertices[v_idx[1] * 3];
-    float V2y = triangle_mesh.vertices[v_idx[1] * 3 + 1];
-    float V2z = triangle_mesh.vertices[v_idx[1] * 3 + 2];
-    // (V3) vertex X,Y,Z indices in triangle_mesh.vertices
-    float V3x = triangle_mesh.vertices[v_idx[2] * 3];
-    float V3y = triangle_mesh.vertices[v_idx[2] * 3 + 1];
-    float V3z = triangle_mesh.vertices[v_idx[2] * 3 + 2];
-    // Calculate normals from vertices
-    // V2 - V1
-    float Ax = V2x - V1x;
-    float Ay = V2y - V1y;
-    float Az = V2z - V1z;
-    // V3 - V1
-    float Bx = V3x - V1x;
-    float By = V3y - V1y;
-    float Bz = V3z - V1z;
-    // Calculate cross product
-    float normal_x = Ay * Bz - Az * By;
-    float normal_y = Az * Bx - Ax * Bz;
-    float normal_z = Ax * By - Ay * Bx;
-    // The normals calculated above must be normalized if we wish to prevent
-    // triangles with a larger surface area from dominating the normal
-    // calculations, however, none of our current models require this
-    // normalization.
-
-    // Add connected normal to each associated vertex
-    // It is also necessary to increment each vertex denominator for averaging
-    for (int i = 0; i < 3; i++) {
-      vertex_normals_sum[v_idx[i] * 3] += normal_x;
-      vertex_normals_sum[v_idx[i] * 3 + 1] += normal_y;
-      vertex_normals_sum[v_idx[i] * 3 + 2] += normal_z;
-    }
+  if (cc->InputSidePackets().HasTag("ASSET_CACHE_MAX_BYTES")) {
+    cc->InputSidePackets().Tag("ASSET_CACHE_MAX_BYTES").Set<int64>();
   }
-
-  // Combine all triangle normals connected to each vertex by adding the X,Y,Z
-  // value of each adjacent triangle surface normal to every vertex and then
-  // averaging the combined value.
-  for (int idx = 0; idx < normals_len; idx += 3) {
-    float normal[3];
-    normal[0] = vertex_normals_sum[idx];
-    normal[1] = vertex_normals_sum[idx + 1];
-    normal[2] = vertex_normals_sum[idx + 2];
-    Normalize3f(normal);
-    triangle_mesh.normals.get()[idx] = normal[0];
-    triangle_mesh.normals.get()[idx + 1] = normal[1];
-    triangle_mesh.normals.get()[idx + 2] = normal[2];
+  if (cc->InputSidePackets().HasTag("INSTANCING")) {
+    cc->InputSidePackets().Tag("INSTANCING").Set<bool>();
   }
-}
 
-void GlAnimationOverlayCalculator::Normalize3f(float input[3]) {
-  float product = 0.0;
-  product += input[0] * input[0];
-  product += input[1] * input[1];
-  product += input[2] * input[2];
-  float magnitude = sqrt(product);
-  input[0] /= magnitude;
-  input[1] /= magnitude;
-  input[2] /= magnitude;
+  return ::mediapipe::OkStatus();
 }
 
 // Helper function for initializing our perspective matrix.
@@ -322,178 +480,32 @@ void GlAnimationOverlayCalculator::InitializePerspectiveMatrix(
   perspective_matrix_[14] = 2.0f * z_far * z_near * denom;
 }
 
-#if defined(__ANDROID__)
-// Helper function for reading in a specified number of bytes from an Android
-// asset.  Returns true if successfully reads in all bytes into buffer.
-bool GlAnimationOverlayCalculator::ReadBytesFromAsset(AAsset *asset,
-                                                      void *buffer,
-                                                      int num_bytes_to_read) {
-  // Most file systems use block sizes of 4KB or 8KB; ideally we'd choose a
-  // small multiple of the block size for best input streaming performance, so
-  // we go for a reasobably safe buffer size of 8KB = 8*1024 bytes.
-  static const int kMaxChunkSize = 8192;
-
-  int bytes_left = num_bytes_to_read;
-  int bytes_read = 1;  // any value > 0 here just to start looping.
-
-  // Treat as uint8_t array so we can deal in single byte arithmetic easily.
-  uint8_t *currBufferIndex = reinterpret_cast<uint8_t *>(buffer);
-  while (bytes_read > 0 && bytes_left > 0) {
-    bytes_read = AAsset_read(asset, (void *)currBufferIndex,
-                             std::min(bytes_left, kMaxChunkSize));
-    bytes_left -= bytes_read;
-    currBufferIndex += bytes_read;
-  }
-  // At least log any I/O errors encountered.
-  if (bytes_read < 0) {
-    LOG(ERROR) << "Error reading from AAsset: " << bytes_read;
-    return false;
-  }
-  if (bytes_left > 0) {
-    // Reached EOF before reading in specified number of bytes.
-    LOG(WARNING) << "Reached EOF before reading in specified number of bytes.";
-    return false;
-  }
-  return true;
-}
-
-// The below asset streaming code is Android-only, making use of the platform
-// JNI helper classes AAssetManager and AAsset.
-bool GlAnimationOverlayCalculator::LoadAnimationAndroid(
-    const std::string &filename, std::vector<TriangleMesh> *meshes) {
-  mediapipe::AssetManager *mediapipe_asset_manager =
-      Singleton<mediapipe::AssetManager>::get();
-  AAssetManager *asset_manager = mediapipe_asset_manager->GetAssetManager();
-  if (!asset_manager) {
-    LOG(ERROR) << "Failed to access Android asset manager.";
-    return false;
-  }
-
-  // New read-bytes stuff here!  First we open file for streaming.
-  AAsset *asset = AAssetManager_open(asset_manager, filename.c_str(),
-                                     AASSET_MODE_STREAMING);
-  if (!asset) {
-    LOG(ERROR) << "Failed to open animation asset: " << filename;
-    return false;
-  }
-
-  // And now, while we are able to stream in more frames, we do so.
-  frame_count_ = 0;
-  int32 lengths[3];
-  while (ReadBytesFromAsset(asset, (void *)lengths, sizeof(lengths[0]) * 3)) {
-    // About to start reading the next animation frame.  Stream it in here.
-    // Each frame stores first the object counts of its three arrays
-    // (vertices, texture coordinates, triangle indices; respectively), and
-    // then stores each of those arrays as a byte dump, in order.
-    meshes->emplace_back();
-    TriangleMesh &triangle_mesh = meshes->back();
-    // Try to read in vertices (4-byte floats)
-    triangle_mesh.vertices.reset(new float[lengths[0]]);
-    if (!ReadBytesFromAsset(asset, (void *)triangle_mesh.vertices.get(),
-                            sizeof(float) * lengths[0])) {
-      LOG(ERROR) << "Failed to read vertices for frame " << frame_count_;
-      return false;
-    }
-    // Try to read in texture coordinates (4-byte floats)
-    triangle_mesh.texture_coords.reset(new float[lengths[1]]);
-    if (!ReadBytesFromAsset(asset, (void *)triangle_mesh.texture_coords.get(),
-                            sizeof(float) * lengths[1])) {
-      LOG(ERROR) << "Failed to read tex-coords for frame " << frame_count_;
-      return false;
-    }
-    // Try to read in indices (2-byte shorts)
-    triangle_mesh.index_count = lengths[2];
-    triangle_mesh.triangle_indices.reset(new int16[lengths[2]]);
-    if (!ReadBytesFromAsset(asset, (void *)triangle_mesh.triangle_indices.get(),
-                            sizeof(int16) * lengths[2])) {
-      LOG(ERROR) << "Failed to read indices for frame " << frame_count_;
-      return false;
-    }
-
-    // Set the normals for this triangle_mesh
-    CalculateTriangleMeshNormals(triangle_mesh, lengths[0]);
-
-    frame_count_++;
+::mediapipe::Status GlAnimationOverlayCalculator::LoadAnimation(
+    const std::string &filename,
+    std::shared_ptr<const CachedAnimation> *animation,
+    std::vector<TriangleMesh> *meshes) {
+  auto animation_or = Singleton<AnimationAssetCache>::get()->Acquire(filename);
+  if (!animation_or.ok()) {
+    return animation_or.status();
   }
-  AAsset_close(asset);
-
-  LOG(INFO) << "Finished parsing " << frame_count_ << " animation frames.";
-  if (meshes->empty()) {
-    LOG(ERROR) << "No animation frames were parsed!  Erroring out calculator.";
-    return false;
-  }
-  return true;
-}
-
-#else  // defined(__ANDROID__)
-
-bool GlAnimationOverlayCalculator::LoadAnimation(const std::string &filename) {
-  std::ifstream infile(filename.c_str(), std::ifstream::binary);
-  if (!infile) {
-    LOG(ERROR) << "Error opening asset with filename: " << filename;
-    return false;
-  }
-
-  frame_count_ = 0;
-  int32 lengths[3];
-  while (true) {
-    // See if we have more initial size counts to read in.
-    infile.read((char *)(lengths), sizeof(lengths[0]) * 3);
-    if (!infile) {
-      // No more frames to read.  Close out.
-      infile.close();
-      break;
-    }
-
-    triangle_meshes_.emplace_back();
-    TriangleMesh &triangle_mesh = triangle_meshes_.back();
-
-    // Try to read in vertices (4-byte floats).
-    triangle_mesh.vertices.reset(new float[lengths[0]]);
-    infile.read((char *)(triangle_mesh.vertices.get()),
-                sizeof(float) * lengths[0]);
-    if (!infile) {
-      LOG(ERROR) << "Failed to read vertices for frame " << frame_count_;
-      return false;
-    }
-
-    // Try to read in texture coordinates (4-byte floats)
-    triangle_mesh.texture_coords.reset(new float[lengths[1]]);
-    infile.read((char *)(triangle_mesh.texture_coords.get()),
-                sizeof(float) * lengths[1]);
-    if (!infile) {
-      LOG(ERROR) << "Failed to read texture coordinates for frame "
-                 << frame_count_;
-      return false;
-    }
-
-    // Try to read in the triangle indices (2-byte shorts)
-    triangle_mesh.index_count = lengths[2];
-    triangle_mesh.triangle_indices.reset(new int16[lengths[2]]);
-    infile.read((char *)(triangle_mesh.triangle_indices.get()),
-                sizeof(int16) * lengths[2]);
-    if (!infile) {
-      LOG(ERROR) << "Failed to read triangle indices for frame "
-                 << frame_count_;
-      return false;
-    }
-
-    // Set the normals for this triangle_mesh
-    CalculateTriangleMeshNormals(triangle_mesh, lengths[0]);
-
-    frame_count_++;
-  }
-
-  LOG(INFO) << "Finished parsing " << frame_count_ << " animation frames.";
-  if (triangle_meshes_.empty()) {
-    LOG(ERROR) << "No animation frames were parsed!  Erroring out calculator.";
-    return false;
+  *animation = std::move(animation_or).ValueOrDie();
+
+  // The frame table already holds the location of every frame within the
+  // asset's vertex and index data, which are uploaded as they are.
+  const AnimationAsset &asset = (*animation)->asset();
+  meshes->resize(asset.frame_count());
+  for (int i = 0; i < asset.frame_count(); ++i) {
+    const AnimationAssetFrame &frame = asset.frame(i);
+    TriangleMesh &triangle_mesh = (*meshes)[i];
+    triangle_mesh.index_count = frame.index_count;
+    triangle_mesh.vertex_offset = frame.first_vertex * kVertexStride;
+    triangle_mesh.index_offset = frame.first_index * sizeof(uint16);
   }
-  return true;
+  VLOG(1) << "Using " << meshes->size() << " animation frames from "
+          << filename;
+  return ::mediapipe::OkStatus();
 }
 
-#endif
-
 void GlAnimationOverlayCalculator::ComputeAspectRatioAndFovFromCameraParameters(
     const CameraParametersProto &camera_parameters, float *aspect_ratio,
     float *vertical_fov_degrees) {
@@ -506,7 +518,9 @@ void GlAnimationOverlayCalculator::ComputeAspectRatioAndFovFromCameraParameters(
 }
 
 ::mediapipe::Status GlAnimationOverlayCalculator::Open(CalculatorContext *cc) {
-  cc->SetOffset(TimestampDiff(0));
+  // No timestamp offset is set: textures may be synchronized separately from
+  // the video frames, and processing a texture would then advance the output
+  // bound past video frames that are still to be rendered.
   MP_RETURN_IF_ERROR(helper_.Open(cc));
 
   const auto &options = cc->Options<GlAnimationOverlayCalculatorOptions>();
@@ -529,6 +543,14 @@ void GlAnimationOverlayCalculator::ComputeAspectRatioAndFovFromCameraParameters(
     aspect_ratio = options.aspect_ratio();
     vertical_fov_degrees = options.vertical_fov_degrees();
   }
+  // The sticker matrices are culled against the frustum of these side packets
+  if (cc->InputSidePackets().HasTag("FOV")) {
+    vertical_fov_degrees =
+        cc->InputSidePackets().Tag("FOV").Get<float>() * 180 / M_PI;
+  }
+  if (cc->InputSidePackets().HasTag("ASPECT_RATIO")) {
+    aspect_ratio = cc->InputSidePackets().Tag("ASPECT_RATIO").Get<float>();
+  }
 
   // when constructing projection matrix.
   InitializePerspectiveMatrix(aspect_ratio, vertical_fov_degrees,
@@ -537,34 +559,46 @@ void GlAnimationOverlayCalculator::ComputeAspectRatioAndFovFromCameraParameters(
 
   // See what streams we have.
   has_video_stream_ = cc->Inputs().HasTag("VIDEO");
-  has_model_matrix_stream_ = cc->Inputs().HasTag("MODEL_MATRICES");
   has_mask_model_matrix_stream_ = cc->Inputs().HasTag("MASK_MODEL_MATRICES");
+  if (cc->InputSidePackets().HasTag("INSTANCING")) {
+    instancing_enabled_ = cc->InputSidePackets().Tag("INSTANCING").Get<bool>();
+  }
 
-  // Try to load in the animation asset in a platform-specific manner.
-  const std::string &asset_name =
-      cc->InputSidePackets().Tag("ANIMATION_ASSET").Get<std::string>();
-  bool loaded_animation = false;
-#if defined(__ANDROID__)
+  if (cc->InputSidePackets().HasTag("ASSET_CACHE_MAX_BYTES")) {
+    Singleton<AnimationAssetCache>::get()->SetMemoryBudget(
+        cc->InputSidePackets().Tag("ASSET_CACHE_MAX_BYTES").Get<int64>());
+  }
+
+  // Acquire the animation assets. Their GPU buffers are looked up on the first
+  // call to Process, together with the rest of our GL state.
   if (cc->InputSidePackets().HasTag("MASK_ASSET")) {
     has_occlusion_mask_ = true;
     const std::string &mask_asset_name =
         cc->InputSidePackets().Tag("MASK_ASSET").Get<std::string>();
-    loaded_animation = LoadAnimationAndroid(mask_asset_name, &mask_meshes_);
-    if (!loaded_animation) {
-      LOG(ERROR) << "Failed to load mask asset.";
-      return ::mediapipe::UnknownError("Failed to load mask asset.");
-    }
+    MP_RETURN_IF_ERROR(
+        LoadAnimation(mask_asset_name, &mask_animation_, &mask_meshes_))
+        << "Failed to load mask asset.";
   }
-  loaded_animation = LoadAnimationAndroid(asset_name, &triangle_meshes_);
-#else
-  loaded_animation = LoadAnimation(asset_name);
-#endif
-  if (!loaded_animation) {
-    LOG(ERROR) << "Failed to load animation asset.";
-    return ::mediapipe::UnknownError("Failed to load animation asset.");
+  const int num_slots = cc->InputSidePackets().NumEntries("ANIMATION_ASSET");
+  slots_.resize(num_slots);
+  for (int i = 0; i < num_slots; ++i) {
+    AssetSlot &slot = slots_[i];
+    const std::string &asset_name =
+        cc->InputSidePackets().Get("ANIMATION_ASSET", i).Get<std::string>();
+    MP_RETURN_IF_ERROR(LoadAnimation(asset_name, &slot.animation, &slot.meshes))
+        << "Failed to load animation asset " << i << ".";
+    RET_CHECK(!slot.meshes.empty())
+        << "Animation asset " << asset_name << " has no frames.";
+    slot.has_texture_stream = cc->Inputs().GetId("TEXTURE", i).IsValid();
+    slot.has_texture_atlas_stream =
+        cc->Inputs().GetId("TEXTURE_ATLAS", i).IsValid();
+    slot.has_model_matrix_stream =
+        cc->Inputs().GetId("MODEL_MATRICES", i).IsValid() ||
+        cc->Inputs().GetId("MODEL_MATRIX_BUFFER", i).IsValid();
   }
 
   return helper_.RunInGlContext([this, &cc]() -> ::mediapipe::Status {
+    const int num_slots = slots_.size();
     if (cc->InputSidePackets().HasTag("MASK_TEXTURE")) {
       const auto &mask_texture =
           cc->InputSidePackets().Tag("MASK_TEXTURE").Get<AssetTextureFormat>();
@@ -572,38 +606,93 @@ void GlAnimationOverlayCalculator::ComputeAspectRatioAndFovFromCameraParameters(
     }
 
     // Load in all static texture data if it exists
-    if (cc->InputSidePackets().HasTag("TEXTURE")) {
-      const auto &input_texture =
-          cc->InputSidePackets().Tag("TEXTURE").Get<AssetTextureFormat>();
-      texture_ = helper_.CreateSourceTexture(input_texture);
+    for (int i = 0; i < num_slots; ++i) {
+      if (slots_[i].has_texture_stream) {
+        continue;
+      }
+      const Packet &texture_packet = cc->InputSidePackets().Get("TEXTURE", i);
+      if (texture_packet.ValidateAsType<std::string>().ok()) {
+        MP_RETURN_IF_ERROR(GlLoadCompressedTexture(
+            texture_packet.Get<std::string>(), &slots_[i].asset_texture))
+            << "Failed to load texture " << i << ".";
+        continue;
+      }
+      const auto &input_texture = texture_packet.Get<AssetTextureFormat>();
+      slots_[i].texture = helper_.CreateSourceTexture(input_texture);
+      VLOG(2) << "Input texture " << i
+              << " size: " << slots_[i].texture.width() << ", "
+              << slots_[i].texture.height() << std::endl;
     }
 
-    VLOG(2) << "Input texture size: " << texture_.width() << ", "
-            << texture_.height() << std::endl;
-
     return ::mediapipe::OkStatus();
   });
 }
 
-int GlAnimationOverlayCalculator::GetAnimationFrameIndex(Timestamp timestamp) {
+int GlAnimationOverlayCalculator::GetAnimationFrameIndex(Timestamp timestamp,
+                                                         int frame_count) {
   double seconds_delta = timestamp.Seconds() - animation_start_time_.Seconds();
   int64_t frame_index =
       static_cast<int64_t>(seconds_delta * animation_speed_fps_);
-  frame_index %= frame_count_;
+  frame_index %= frame_count;
   return static_cast<int>(frame_index);
 }
 
+::mediapipe::Status GlAnimationOverlayCalculator::LoadTextureAtlas(
+    const std::string &serialized_atlas, Timestamp timestamp,
+    AssetSlot *slot) {
+  ::instantmotiontracking::TextureAtlas atlas;
+  RET_CHECK(atlas.ParseFromString(serialized_atlas))
+      << "Unable to parse texture atlas.";
+  RET_CHECK(atlas.columns() > 0 && atlas.rows() > 0)
+      << "Texture atlas has an empty grid.";
+  RET_CHECK_LE(atlas.frame_delay_ms_size(), atlas.columns() * atlas.rows())
+      << "Texture atlas has more frames than grid cells.";
+  slot->atlas_columns = atlas.columns();
+  slot->atlas_rows = atlas.rows();
+  slot->atlas_start_time = timestamp;
+  slot->atlas_frame_end_ms.clear();
+  // A single frame is displayed for good
+  if (atlas.frame_delay_ms_size() > 1) {
+    int64 end_ms = 0;
+    for (const int delay_ms : atlas.frame_delay_ms()) {
+      end_ms += delay_ms < kMinAtlasFrameDelayMs ? kDefaultAtlasFrameDelayMs
+                                                 : delay_ms;
+      slot->atlas_frame_end_ms.push_back(end_ms);
+    }
+  }
+  return ::mediapipe::OkStatus();
+}
+
+void GlAnimationOverlayCalculator::GetTextureFrameTransform(
+    const AssetSlot &slot, Timestamp timestamp, float transform[4]) {
+  int frame_index = 0;
+  if (!slot.atlas_frame_end_ms.empty()) {
+    const int64 elapsed_ms =
+        (timestamp - slot.atlas_start_time).Microseconds() / 1000;
+    const int64 loop_ms = elapsed_ms % slot.atlas_frame_end_ms.back();
+    frame_index = std::upper_bound(slot.atlas_frame_end_ms.begin(),
+                                   slot.atlas_frame_end_ms.end(), loop_ms) -
+                  slot.atlas_frame_end_ms.begin();
+  }
+  transform[0] = 1.0f / slot.atlas_columns;
+  transform[1] = 1.0f / slot.atlas_rows;
+  transform[2] = static_cast<float>(frame_index % slot.atlas_columns) /
+                 slot.atlas_columns;
+  transform[3] =
+      static_cast<float>(frame_index / slot.atlas_columns) / slot.atlas_rows;
+}
+
 void GlAnimationOverlayCalculator::LoadModelMatrices(
     const TimedModelMatrixProtoList &model_matrices,
-    std::vector<ModelMatrix> *current_model_matrices) {
-  current_model_matrices->clear();
+    Packet *current_model_matrices) {
+  auto matrix_buffer = absl::make_unique<ModelMatrixBuffer>();
+  matrix_buffer->Resize(model_matrices.model_matrix_size());
   for (int i = 0; i < model_matrices.model_matrix_size(); ++i) {
     const auto &model_matrix = model_matrices.model_matrix(i);
     CHECK(model_matrix.matrix_entries_size() == kNumMatrixEntries)
         << "Invalid Model Matrix";
-    current_model_matrices->emplace_back();
-    ModelMatrix &new_matrix = current_model_matrices->back();
-    new_matrix.reset(new float[kNumMatrixEntries]);
+    matrix_buffer->ids[i] = model_matrix.id();
+    float *new_matrix = matrix_buffer->mutable_matrix(i);
     for (int j = 0; j < kNumMatrixEntries; j++) {
       // Model matrices streamed in using ROW-MAJOR format, but we want
       // COLUMN-MAJOR for rendering, so we transpose here.
@@ -612,24 +701,44 @@ void GlAnimationOverlayCalculator::LoadModelMatrices(
       new_matrix[row + col * 4] = model_matrix.matrix_entries(j);
     }
   }
+  *current_model_matrices = Adopt(matrix_buffer.release());
 }
 
 ::mediapipe::Status GlAnimationOverlayCalculator::Process(
     CalculatorContext *cc) {
   return helper_.RunInGlContext([this, &cc]() -> ::mediapipe::Status {
+    const int num_slots = slots_.size();
     if (!initialized_) {
       MP_RETURN_IF_ERROR(GlSetup());
+      for (AssetSlot &slot : slots_) {
+        MP_RETURN_IF_ERROR(
+            GlGetAnimationBuffers(slot.animation, &slot.buffers));
+      }
+      if (has_occlusion_mask_) {
+        MP_RETURN_IF_ERROR(
+            GlGetAnimationBuffers(mask_animation_, &mask_mesh_buffers_));
+      }
       initialized_ = true;
       animation_start_time_ = cc->InputTimestamp();
     }
 
     // Process model matrices, if any are being streamed in, and update our
-    // list.
-    if (has_model_matrix_stream_ &&
-        !cc->Inputs().Tag("MODEL_MATRICES").IsEmpty()) {
-      const TimedModelMatrixProtoList &model_matrices =
-          cc->Inputs().Tag("MODEL_MATRICES").Get<TimedModelMatrixProtoList>();
-      LoadModelMatrices(model_matrices, &current_model_matrices_);
+    // lists.
+    for (int i = 0; i < num_slots; ++i) {
+      const CollectionItemId matrices_id =
+          cc->Inputs().GetId("MODEL_MATRICES", i);
+      if (matrices_id.IsValid() && !cc->Inputs().Get(matrices_id).IsEmpty()) {
+        const TimedModelMatrixProtoList &model_matrices =
+            cc->Inputs().Get(matrices_id).Get<TimedModelMatrixProtoList>();
+        LoadModelMatrices(model_matrices, &slots_[i].model_matrices);
+      }
+      const CollectionItemId matrix_buffer_id =
+          cc->Inputs().GetId("MODEL_MATRIX_BUFFER", i);
+      if (matrix_buffer_id.IsValid() &&
+          !cc->Inputs().Get(matrix_buffer_id).IsEmpty()) {
+        // Holding on to the packet keeps the matrices alive without a copy
+        slots_[i].model_matrices = cc->Inputs().Get(matrix_buffer_id).Value();
+      }
     }
     if (has_mask_model_matrix_stream_ &&
         !cc->Inputs().Tag("MASK_MODEL_MATRICES").IsEmpty()) {
@@ -640,6 +749,35 @@ void GlAnimationOverlayCalculator::LoadModelMatrices(
       LoadModelMatrices(model_matrices, &current_mask_model_matrices_);
     }
 
+    // Load dynamic textures if they exist, keeping the previous ones
+    // otherwise. They may arrive on their own, without a video frame to render
+    for (int i = 0; i < num_slots; ++i) {
+      AssetSlot &slot = slots_[i];
+      if (slot.has_texture_stream &&
+          !cc->Inputs().Get("TEXTURE", i).IsEmpty()) {
+        const Packet &texture_packet = cc->Inputs().Get("TEXTURE", i).Value();
+        const auto &input_texture = texture_packet.Get<AssetTextureFormat>();
+        // The same texture re-sent, possibly in a new packet at a new
+        // timestamp, is already uploaded
+        const size_t content_key = TextureContentKey(input_texture);
+        if (!slot.texture_packet.IsEmpty() &&
+            slot.texture_content_key == content_key) {
+          cc->GetCounter(kTextureUploadsSkippedCounter)->Increment();
+        } else {
+          slot.texture = helper_.CreateSourceTexture(input_texture);
+          slot.texture_packet = texture_packet;
+          slot.texture_content_key = content_key;
+          cc->GetCounter(kTextureUploadsCounter)->Increment();
+        }
+      }
+      if (slot.has_texture_atlas_stream &&
+          !cc->Inputs().Get("TEXTURE_ATLAS", i).IsEmpty()) {
+        MP_RETURN_IF_ERROR(LoadTextureAtlas(
+            cc->Inputs().Get("TEXTURE_ATLAS", i).Get<std::string>(),
+            cc->InputTimestamp(), &slot));
+      }
+    }
+
     // Arbitrary default width and height for output destination texture, in the
     // event that we don't have a valid and unique input buffer to overlay.
     int width = 640;
@@ -695,36 +833,54 @@ void GlAnimationOverlayCalculator::LoadModelMatrices(
     if (has_occlusion_mask_) {
       glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
       const TriangleMesh &mask_frame = mask_meshes_.front();
-      MP_RETURN_IF_ERROR(GlBind(mask_frame, mask_texture_));
+      MP_RETURN_IF_ERROR(GlBind(mask_frame, *mask_mesh_buffers_,
+                                mask_texture_.target(), mask_texture_.name(),
+                                kFullTextureFrameTransform));
       // Draw objects using our latest model matrix stream packet.
-      for (const ModelMatrix &model_matrix : current_mask_model_matrices_) {
-        MP_RETURN_IF_ERROR(GlRender(mask_frame, model_matrix.get()));
+      if (!current_mask_model_matrices_.IsEmpty()) {
+        const auto &mask_model_matrices =
+            current_mask_model_matrices_.Get<ModelMatrixBuffer>();
+        MP_RETURN_IF_ERROR(GlRenderInstances(
+            mask_frame, mask_model_matrices.matrices.data(),
+            mask_model_matrices.size()));
       }
     }
 
     glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-    int frame_index = GetAnimationFrameIndex(cc->InputTimestamp());
-    const TriangleMesh &current_frame = triangle_meshes_[frame_index];
-
-    // Load dynamic texture if it exists
-    if (cc->Inputs().HasTag("TEXTURE")) {
-      const auto &input_texture =
-          cc->Inputs().Tag("TEXTURE").Get<AssetTextureFormat>();
-      texture_ = helper_.CreateSourceTexture(input_texture);
-    }
-
-    MP_RETURN_IF_ERROR(GlBind(current_frame, texture_));
-    if (has_model_matrix_stream_) {
-      // Draw objects using our latest model matrix stream packet.
-      for (const ModelMatrix &model_matrix : current_model_matrices_) {
-        MP_RETURN_IF_ERROR(GlRender(current_frame, model_matrix.get()));
+    for (int i = 0; i < num_slots; ++i) {
+      AssetSlot &slot = slots_[i];
+      // Streamed textures may not have arrived yet
+      if (slot.texture.width() == 0 && !slot.asset_texture) {
+        continue;
+      }
+      int frame_index =
+          GetAnimationFrameIndex(cc->InputTimestamp(), slot.meshes.size());
+      const TriangleMesh &current_frame = slot.meshes[frame_index];
+      float texture_frame_transform[4];
+      GetTextureFrameTransform(slot, cc->InputTimestamp(),
+                               texture_frame_transform);
+
+      MP_RETURN_IF_ERROR(GlBind(current_frame, *slot.buffers,
+                                GetSlotTextureTarget(slot),
+                                GetSlotTextureName(slot),
+                                texture_frame_transform));
+      if (slot.has_model_matrix_stream) {
+        // Draw objects using our latest model matrix stream packet.
+        if (!slot.model_matrices.IsEmpty()) {
+          const auto &model_matrices =
+              slot.model_matrices.Get<ModelMatrixBuffer>();
+          MP_RETURN_IF_ERROR(GlRenderInstances(current_frame,
+                                               model_matrices.matrices.data(),
+                                               model_matrices.size()));
+        }
+      } else {
+        // Just draw one object to a static model matrix.
+        MP_RETURN_IF_ERROR(GlRenderInstances(current_frame, kModelMatrix, 1));
       }
-    } else {
-      // Just draw one object to a static model matrix.
-      MP_RETURN_IF_ERROR(GlRender(current_frame, kModelMatrix));
     }
 
-    // Disable vertex attributes
+    // Disable vertex attributes and unbind mesh buffers
+    GLCHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
     GLCHECK(glDisableVertexAttribArray(ATTRIB_VERTEX));
     GLCHECK(glDisableVertexAttribArray(ATTRIB_TEXTURE_POSITION));
     GLCHECK(glDisableVertexAttribArray(ATTRIB_NORMAL));
@@ -732,9 +888,11 @@ void GlAnimationOverlayCalculator::LoadModelMatrices(
     // Disable depth test
     GLCHECK(glDisable(GL_DEPTH_TEST));
 
-    // Unbind texture
+    // Unbind textures, from every target the slots were drawn with
     GLCHECK(glActiveTexture(GL_TEXTURE1));
-    GLCHECK(glBindTexture(texture_.target(), 0));
+    for (const AssetSlot &slot : slots_) {
+      GLCHECK(glBindTexture(GetSlotTextureTarget(slot), 0));
+    }
 
     // Unbind depth buffer
     GLCHECK(glBindRenderbuffer(GL_RENDERBUFFER, 0));
@@ -751,24 +909,58 @@ void GlAnimationOverlayCalculator::LoadModelMatrices(
 }
 
 ::mediapipe::Status GlAnimationOverlayCalculator::GlSetup() {
-  // Load vertex and fragment shaders
-  const GLint attr_location[NUM_ATTRIBUTES] = {
+#if defined(GL_ANIMATION_OVERLAY_INSTANCING)
+  use_instancing_ =
+      instancing_enabled_ && helper_.GetGlVersion() == GlVersion::kGLES3;
+#endif
+
+  // Load vertex and fragment shaders. The instanced program additionally binds
+  // the per-instance model matrix attribute.
+  const GLint attr_location[NUM_ATTRIBUTES + 1] = {
       ATTRIB_VERTEX,
       ATTRIB_TEXTURE_POSITION,
       ATTRIB_NORMAL,
+      kAttribModelMatrix,
   };
-  const GLchar *attr_name[NUM_ATTRIBUTES] = {
+  const GLchar *attr_name[NUM_ATTRIBUTES + 1] = {
       "position",
       "texture_coordinate",
       "normal",
+      "instanceModelMatrix",
   };
+  const int num_attributes =
+      use_instancing_ ? NUM_ATTRIBUTES + 1 : NUM_ATTRIBUTES;
+
+  // Both shaders are written against GLSL ES 1.00. For instanced rendering we
+  // compile them as GLSL ES 3.00 instead, mapping the removed keywords and
+  // built-ins onto their replacements.
+  const GLchar *vert_preamble = "";
+  const GLchar *frag_preamble = "";
+  if (use_instancing_) {
+    vert_preamble = R"(#version 300 es
+      #define INSTANCED
+      #define attribute in
+      #define varying out
+    )";
+    frag_preamble = R"(#version 300 es
+      #define varying in
+      #define texture2D texture
+      out mediump vec4 fragColor;
+      #define gl_FragColor fragColor
+    )";
+  }
 
   const GLchar *vert_src = R"(
     // Perspective projection matrix for rendering / clipping
     uniform mat4 perspectiveMatrix;
 
     // Matrix defining the currently rendered object model
+#ifdef INSTANCED
+    attribute mat4 instanceModelMatrix;
+    #define modelMatrix instanceModelMatrix
+#else
     uniform mat4 modelMatrix;
+#endif
 
     // vertex position in threespace
     attribute vec4 position;
@@ -776,13 +968,17 @@ void GlAnimationOverlayCalculator::LoadModelMatrices(
 
     // texture coordinate for each vertex in normalized texture space (0..1)
     attribute mediump vec4 texture_coordinate;
+    // scale (xy) and offset (zw) of the texture frame sampled from, within a
+    // texture atlas
+    uniform mediump vec4 textureFrameTransform;
 
     // texture coordinate for fragment shader (will be interpolated)
     varying mediump vec2 sampleCoordinate;
     varying mediump vec3 vNormal;
 
     void main() {
-      sampleCoordinate = texture_coordinate.xy;
+      sampleCoordinate = texture_coordinate.xy * textureFrameTransform.xy +
+                         textureFrameTransform.zw;
       mat4 mvpMatrix = perspectiveMatrix * modelMatrix;
       gl_Position = mvpMatrix * position;
 
@@ -800,7 +996,7 @@ void GlAnimationOverlayCalculator::LoadModelMatrices(
 
     varying vec2 sampleCoordinate;  // texture coordinate (0..1)
     varying vec3 vNormal;
-    uniform sampler2D texture;  // texture to shade with
+    uniform sampler2D textureSampler;  // texture to shade with
     const float kPi = 3.14159265359;
 
     // Define ambient lighting factor that is applied to our texture in order to
@@ -844,7 +1040,7 @@ void GlAnimationOverlayCalculator::LoadModelMatrices(
 
     void main() {
       // Sample the texture, retrieving an rgba pixel value
-      vec4 pixel = texture2D(texture, sampleCoordinate);
+      vec4 pixel = texture2D(textureSampler, sampleCoordinate);
       // If the alpha (background) value is near transparent, then discard the
       // pixel, this allows the rendering of transparent background GIFs
       // TODO: Adding a toggle to perform pixel alpha discarding for transparent
@@ -860,20 +1056,81 @@ void GlAnimationOverlayCalculator::LoadModelMatrices(
 
 
   // Shader program
-  GLCHECK(GlhCreateProgram(vert_src, frag_src, NUM_ATTRIBUTES,
-                           (const GLchar **)&attr_name[0], attr_location,
-                           &program_));
+  const std::string full_vert_src = absl::StrCat(vert_preamble, vert_src);
+  const std::string full_frag_src = absl::StrCat(frag_preamble, frag_src);
+  GLCHECK(GlhCreateProgram(full_vert_src.c_str(), full_frag_src.c_str(),
+                           num_attributes, (const GLchar **)&attr_name[0],
+                           attr_location, &program_));
   RET_CHECK(program_) << "Problem initializing the program.";
-  texture_uniform_ = GLCHECK(glGetUniformLocation(program_, "texture"));
+  texture_uniform_ = GLCHECK(glGetUniformLocation(program_, "textureSampler"));
   perspective_matrix_uniform_ =
       GLCHECK(glGetUniformLocation(program_, "perspectiveMatrix"));
-  model_matrix_uniform_ =
-      GLCHECK(glGetUniformLocation(program_, "modelMatrix"));
+  texture_frame_transform_uniform_ =
+      GLCHECK(glGetUniformLocation(program_, "textureFrameTransform"));
+  if (use_instancing_) {
+    GLCHECK(glGenBuffers(1, &instance_buffer_));
+  } else {
+    model_matrix_uniform_ =
+        GLCHECK(glGetUniformLocation(program_, "modelMatrix"));
+  }
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status GlAnimationOverlayCalculator::GlGetAnimationBuffers(
+    const std::shared_ptr<const CachedAnimation> &animation,
+    std::shared_ptr<const AnimationGpuBuffers> *buffers) {
+  auto buffers_or = Singleton<AnimationAssetCache>::get()->GetBuffers(
+      animation, &helper_.GetGlContext());
+  if (!buffers_or.ok()) {
+    return buffers_or.status();
+  }
+  *buffers = std::move(buffers_or).ValueOrDie();
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status GlAnimationOverlayCalculator::GlLoadCompressedTexture(
+    const std::string &path, GLuint *texture_name) {
+  auto texture_or = CompressedTexture::Load(path);
+  if (!texture_or.ok()) {
+    return texture_or.status();
+  }
+  const auto texture = std::move(texture_or).ValueOrDie();
+
+  GLCHECK(glGenTextures(1, texture_name));
+  GLCHECK(glBindTexture(GL_TEXTURE_2D, *texture_name));
+  // Sampled like the textures of GlCalculatorHelper, without mipmapping
+  GLCHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+  GLCHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+  GLCHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+  GLCHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+  if (IsCompressedTextureFormatSupported(texture->gl_internal_format())) {
+    GLCHECK(glCompressedTexImage2D(GL_TEXTURE_2D, 0,
+                                   texture->gl_internal_format(),
+                                   texture->width(), texture->height(), 0,
+                                   texture->size(), texture->data()));
+    VLOG(2) << "Uploaded compressed texture " << path << " of format "
+            << texture->gl_internal_format();
+  } else {
+    // Contexts without the format, such as OpenGL ES 2.0 or software
+    // renderers, get the texture uncompressed
+    std::vector<uint8> rgba;
+    MP_RETURN_IF_ERROR(texture->DecodeToRgba(&rgba))
+        << "Texture format of " << path << " is not supported by the context.";
+    GLCHECK(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+    GLCHECK(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texture->width(),
+                         texture->height(), 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                         rgba.data()));
+    VLOG(2) << "Decoded compressed texture " << path << " of format "
+            << texture->gl_internal_format() << " on the CPU";
+  }
+  GLCHECK(glBindTexture(GL_TEXTURE_2D, 0));
   return ::mediapipe::OkStatus();
 }
 
 ::mediapipe::Status GlAnimationOverlayCalculator::GlBind(
-    const TriangleMesh &triangle_mesh, const GlTexture &texture) {
+    const TriangleMesh &triangle_mesh, const AnimationGpuBuffers &buffers,
+    GLenum texture_target, GLuint texture_name,
+    const float *texture_frame_transform) {
   GLCHECK(glUseProgram(program_));
 
   // Disable backface culling to allow occlusion effects.
@@ -885,33 +1142,90 @@ void GlAnimationOverlayCalculator::LoadModelMatrices(
   GLCHECK(glDepthMask(GL_TRUE));
   GLCHECK(glDepthFunc(GL_LESS));
 
-  // Clear our depth buffer before starting draw calls
-  GLCHECK(glVertexAttribPointer(ATTRIB_VERTEX, 3, GL_FLOAT, 0, 0,
-                                triangle_mesh.vertices.get()));
+  // Point the vertex attributes at this frame's interleaved vertices. The
+  // attribute state keeps referencing the vertex buffer after unbinding it.
+  const auto attribute_pointer = [&triangle_mesh](int offset_floats) {
+    return reinterpret_cast<const void *>(triangle_mesh.vertex_offset +
+                                          offset_floats * sizeof(float));
+  };
+  GLCHECK(glBindBuffer(GL_ARRAY_BUFFER, buffers.vertex_buffer()));
+  GLCHECK(glVertexAttribPointer(
+      ATTRIB_VERTEX, 3, GL_FLOAT, 0, kVertexStride,
+      attribute_pointer(kAnimationVertexPositionOffset)));
   GLCHECK(glEnableVertexAttribArray(ATTRIB_VERTEX));
-  GLCHECK(glVertexAttribPointer(ATTRIB_TEXTURE_POSITION, 2, GL_FLOAT, 0, 0,
-                                triangle_mesh.texture_coords.get()));
+  GLCHECK(glVertexAttribPointer(
+      ATTRIB_TEXTURE_POSITION, 2, GL_FLOAT, 0, kVertexStride,
+      attribute_pointer(kAnimationVertexTextureCoordOffset)));
   GLCHECK(glEnableVertexAttribArray(ATTRIB_TEXTURE_POSITION));
-  GLCHECK(glVertexAttribPointer(ATTRIB_NORMAL, 3, GL_FLOAT, 0, 0,
-                                triangle_mesh.normals.get()));
+  GLCHECK(glVertexAttribPointer(
+      ATTRIB_NORMAL, 3, GL_FLOAT, 0, kVertexStride,
+      attribute_pointer(kAnimationVertexNormalOffset)));
   GLCHECK(glEnableVertexAttribArray(ATTRIB_NORMAL));
+  GLCHECK(glBindBuffer(GL_ARRAY_BUFFER, 0));
+  GLCHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.index_buffer()));
   GLCHECK(glActiveTexture(GL_TEXTURE1));
-  GLCHECK(glBindTexture(texture.target(), texture.name()));
+  GLCHECK(glBindTexture(texture_target, texture_name));
 
   // We previously bound it to GL_TEXTURE1
   GLCHECK(glUniform1i(texture_uniform_, 1));
 
   GLCHECK(glUniformMatrix4fv(perspective_matrix_uniform_, 1, GL_FALSE,
                              perspective_matrix_));
+  GLCHECK(glUniform4fv(texture_frame_transform_uniform_, 1,
+                       texture_frame_transform));
   return ::mediapipe::OkStatus();
 }
 
 ::mediapipe::Status GlAnimationOverlayCalculator::GlRender(
     const TriangleMesh &triangle_mesh, const float *model_matrix) {
   GLCHECK(glUniformMatrix4fv(model_matrix_uniform_, 1, GL_FALSE, model_matrix));
-  GLCHECK(glDrawElements(GL_TRIANGLES, triangle_mesh.index_count,
-                         GL_UNSIGNED_SHORT,
-                         triangle_mesh.triangle_indices.get()));
+  GLCHECK(glDrawElements(
+      GL_TRIANGLES, triangle_mesh.index_count, GL_UNSIGNED_SHORT,
+      reinterpret_cast<const void *>(triangle_mesh.index_offset)));
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status GlAnimationOverlayCalculator::GlRenderInstances(
+    const TriangleMesh &triangle_mesh, const float *model_matrices,
+    int num_matrices) {
+  if (num_matrices == 0) {
+    return ::mediapipe::OkStatus();
+  }
+#if defined(GL_ANIMATION_OVERLAY_INSTANCING)
+  if (use_instancing_) {
+    // Orphan and refill the instance buffer, so we never stall on draw calls
+    // still reading the previous contents.
+    const GLsizei stride = kNumMatrixEntries * sizeof(float);
+    GLCHECK(glBindBuffer(GL_ARRAY_BUFFER, instance_buffer_));
+    GLCHECK(glBufferData(GL_ARRAY_BUFFER, num_matrices * stride,
+                         model_matrices, GL_STREAM_DRAW));
+    for (int col = 0; col < kNumModelMatrixColumns; ++col) {
+      const GLuint location = kAttribModelMatrix + col;
+      GLCHECK(glVertexAttribPointer(
+          location, 4, GL_FLOAT, GL_FALSE, stride,
+          reinterpret_cast<const void *>(col * 4 * sizeof(float))));
+      GLCHECK(glEnableVertexAttribArray(location));
+      GLCHECK(glVertexAttribDivisor(location, 1));
+    }
+    GLCHECK(glBindBuffer(GL_ARRAY_BUFFER, 0));
+
+    GLCHECK(glDrawElementsInstanced(
+        GL_TRIANGLES, triangle_mesh.index_count, GL_UNSIGNED_SHORT,
+        reinterpret_cast<const void *>(triangle_mesh.index_offset),
+        num_matrices));
+
+    for (int col = 0; col < kNumModelMatrixColumns; ++col) {
+      const GLuint location = kAttribModelMatrix + col;
+      GLCHECK(glVertexAttribDivisor(location, 0));
+      GLCHECK(glDisableVertexAttribArray(location));
+    }
+    return ::mediapipe::OkStatus();
+  }
+#endif
+  for (int i = 0; i < num_matrices; ++i) {
+    MP_RETURN_IF_ERROR(
+        GlRender(triangle_mesh, model_matrices + i * kNumMatrixEntries));
+  }
   return ::mediapipe::OkStatus();
 }
 
@@ -921,17 +1235,32 @@ GlAnimationOverlayCalculator::~GlAnimationOverlayCalculator() {
       GLCHECK(glDeleteProgram(program_));
       program_ = 0;
     }
+    if (instance_buffer_) {
+      GLCHECK(glDeleteBuffers(1, &instance_buffer_));
+      instance_buffer_ = 0;
+    }
+    // Other calculators may still be rendering the same animations, so we only
+    // release our references, and let the cache decide what to keep.
+    mask_mesh_buffers_.reset();
+    mask_animation_.reset();
     if (depth_buffer_created_) {
       GLCHECK(glDeleteRenderbuffers(1, &renderbuffer_));
       renderbuffer_ = 0;
     }
-    if (texture_.width() > 0) {
-      texture_.Release();
+    for (AssetSlot &slot : slots_) {
+      if (slot.texture.width() > 0) {
+        slot.texture.Release();
+      }
+      if (slot.asset_texture) {
+        GLCHECK(glDeleteTextures(1, &slot.asset_texture));
+      }
     }
+    slots_.clear();
     if (mask_texture_.width() > 0) {
       mask_texture_.Release();
     }
   });
+  Singleton<AnimationAssetCache>::get()->Trim();
 }
 
 }  // namespace mediapipe
@@ -0,0 +1,166 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Measures the overlay frame time against the number of stickers, drawing
+// them with a single instanced draw call and with one draw call per sticker.
+// Each frame is read back to the CPU, so that the time includes the rendering
+// itself and not only its submission. Runs on any Linux host with Mesa's
+// llvmpipe software renderer:
+//   LIBGL_ALWAYS_SOFTWARE=1 bazel run -c opt --copt -DMESA_EGL_NO_X11_HEADERS --copt -DEGL_NO_X11 //mediapipe/graphs/instantmotiontracking/calculators:gl_animation_overlay_calculator_benchmark
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "benchmark/benchmark.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/gpu/gpu_shared_data_internal.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/model_matrix_buffer.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr char kAssetDir[] =
+    "mediapipe/examples/android/src/java/com/google/mediapipe/apps/"
+    "instantmotiontracking/assets/robot/";
+constexpr int kFrameWidth = 720;
+constexpr int kFrameHeight = 960;
+
+CalculatorGraphConfig MakeGraphConfig() {
+  return ParseTextProtoOrDie<CalculatorGraphConfig>(R"(
+    input_stream: "input_frames"
+    input_stream: "matrix_buffer"
+    output_stream: "output_frames"
+    node {
+      calculator: "ImageFrameToGpuBufferCalculator"
+      input_stream: "input_frames"
+      output_stream: "input_video"
+    }
+    node {
+      calculator: "GlAnimationOverlayCalculator"
+      input_stream: "VIDEO:input_video"
+      input_stream: "MODEL_MATRIX_BUFFER:0:matrix_buffer"
+      input_side_packet: "TEXTURE:0:texture"
+      input_side_packet: "ANIMATION_ASSET:0:animation_asset"
+      input_side_packet: "INSTANCING:instancing"
+      output_stream: "output_video"
+      node_options: {
+        [type.googleapis.com/mediapipe.GlAnimationOverlayCalculatorOptions] {
+          aspect_ratio: 0.75
+          vertical_fov_degrees: 70.
+          animation_speed_fps: 25
+        }
+      }
+    }
+    node {
+      calculator: "GpuBufferToImageFrameCalculator"
+      input_stream: "output_video"
+      output_stream: "output_frames"
+    }
+  )");
+}
+
+// Stickers laid out in a grid filling the screen, ten units away from the
+// camera
+std::unique_ptr<ModelMatrixBuffer> MakeMatrixBuffer(int num_stickers) {
+  auto buffer = absl::make_unique<ModelMatrixBuffer>();
+  buffer->Resize(num_stickers);
+  int columns = 1;
+  while (columns * columns < num_stickers) {
+    ++columns;
+  }
+  const float spacing = 12.0f / columns;
+  for (int i = 0; i < num_stickers; ++i) {
+    buffer->ids[i] = i;
+    float* matrix = buffer->mutable_matrix(i);
+    std::fill(matrix, matrix + kModelMatrixSize, 0.0f);
+    matrix[0] = matrix[5] = matrix[10] = spacing * 0.5f;
+    matrix[12] = spacing * (i % columns - 0.5f * (columns - 1));
+    matrix[13] = spacing * (i / columns - 0.5f * (columns - 1));
+    matrix[14] = -10.0f;
+    matrix[15] = 1.0f;
+  }
+  return buffer;
+}
+
+::mediapipe::Status RunOverlay(benchmark::State& state) {
+  const bool instancing = state.range(0) != 0;
+  const int num_stickers = state.range(1);
+
+  CalculatorGraph graph;
+  MP_RETURN_IF_ERROR(graph.Initialize(MakeGraphConfig()));
+  ASSIGN_OR_RETURN(auto gpu_resources, GpuResources::Create());
+  MP_RETURN_IF_ERROR(graph.SetGpuResources(std::move(gpu_resources)));
+  ASSIGN_OR_RETURN(OutputStreamPoller poller,
+                   graph.AddOutputStreamPoller("output_frames"));
+  MP_RETURN_IF_ERROR(graph.StartRun(
+      {{"texture", MakePacket<std::string>(std::string(kAssetDir) +
+                                           "robot_texture.ktx")},
+       {"animation_asset",
+        MakePacket<std::string>(std::string(kAssetDir) + "robot.imta")},
+       {"instancing", MakePacket<bool>(instancing)}}));
+
+  ImageFrame frame(ImageFormat::SRGBA, kFrameWidth, kFrameHeight);
+  frame.SetToZero();
+  const Packet matrix_buffer =
+      Adopt(MakeMatrixBuffer(num_stickers).release());
+  int64 timestamp = 0;
+  for (auto _ : state) {
+    auto input_frame = absl::make_unique<ImageFrame>();
+    input_frame->CopyFrom(frame, ImageFrame::kGlDefaultAlignmentBoundary);
+    MP_RETURN_IF_ERROR(graph.AddPacketToInputStream(
+        "input_frames",
+        Adopt(input_frame.release()).At(Timestamp(timestamp))));
+    MP_RETURN_IF_ERROR(graph.AddPacketToInputStream(
+        "matrix_buffer", matrix_buffer.At(Timestamp(timestamp))));
+    ++timestamp;
+    Packet output_frame;
+    RET_CHECK(poller.Next(&output_frame)) << "The graph stopped early";
+    benchmark::DoNotOptimize(output_frame);
+  }
+  state.SetItemsProcessed(state.iterations() * num_stickers);
+
+  MP_RETURN_IF_ERROR(graph.CloseAllPacketSources());
+  return graph.WaitUntilDone();
+}
+
+void BM_GlAnimationOverlay(benchmark::State& state) {
+  const ::mediapipe::Status status = RunOverlay(state);
+  if (!status.ok()) {
+    state.SkipWithError(status.ToString().c_str());
+  }
+}
+
+// The first argument is 1 for a single instanced draw call, 0 for one draw
+// call per sticker, and the second one the number of stickers. The GL context
+// renders in its own thread, hence real time.
+BENCHMARK(BM_GlAnimationOverlay)
+    ->ArgNames({"instancing", "stickers"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      for (const int instancing : {0, 1}) {
+        for (int num_stickers = 1; num_stickers <= 1024; num_stickers *= 4) {
+          b->Args({instancing, num_stickers});
+        }
+      }
+    })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace mediapipe
@@ -12,25 +12,33 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <memory>
 #include <cmath>
+#include <limits>
 #include "Eigen/Dense"
 #include "Eigen/src/Core/util/Constants.h"
 #include "Eigen/src/Geometry/Quaternion.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/singleton.h"
 #include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/statusor.h"
 #include "mediapipe/graphs/object_detection_3d/calculators/box.h"
 #include "mediapipe/graphs/object_detection_3d/calculators/model_matrix.pb.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/animation_asset.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/animation_asset_cache.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/model_matrix_buffer.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/model_matrix_kernel.h"
 #include "mediapipe/graphs/instantmotiontracking/calculators/transformations.h"
 
 namespace mediapipe {
 
 namespace {
-  using Matrix4fCM = Eigen::Matrix<float, 4, 4, Eigen::ColMajor>;
   using Vector3f = Eigen::Vector3f;
   using Matrix3f = Eigen::Matrix3f;
   using DiagonalMatrix3f = Eigen::DiagonalMatrix<float, 3>;
@@ -40,11 +48,19 @@ namespace {
   constexpr char kUserScalingsTag[] = "USER_SCALINGS";
   constexpr char kRendersTag[] = "RENDER_DATA";
   constexpr char kGifAspectRatioTag[] = "GIF_ASPECT_RATIO";
-  constexpr char kModelMatricesTag[] = "MODEL_MATRICES";
+  constexpr char kMatricesTag[] = "MATRICES";
+  constexpr char kMatrixBuffersTag[] = "MATRIX_BUFFERS";
   constexpr char kFOVSidePacketTag[] = "FOV";
   constexpr char kAspectRatioSidePacketTag[] = "ASPECT_RATIO";
+  constexpr char kAnimationAssetSidePacketTag[] = "ANIMATION_ASSET";
+  constexpr char kCulledStickersCounter[] = "MatricesManagerCulledStickers";
+  constexpr char kDrawnStickersCounter[] = "MatricesManagerDrawnStickers";
+  // Number of side planes of the view frustum
+  constexpr int kNumFrustumPlanes = 4;
   // initial Z value (-10 is center point in visual range for OpenGL render)
   constexpr float kInitialZ = -10.0f;
+  // Render id of stickers that should not be rendered
+  constexpr int kNoRenderId = -1;
   // Device properties that will be preset by side packets
   float vertical_fov_radians_ = 0.0f;
   float aspect_ratio_ = 0.0f;
@@ -60,6 +76,9 @@ namespace {
 // Input Side Packets:
 //  FOV - Vertical field of view for device [REQUIRED - Defines perspective matrix]
 //  ASPECT_RATIO - Aspect ratio of device [REQUIRED - Defines perspective matrix]
+//  ANIMATION_ASSET - Path of the animation asset of each render id, as given to
+//  gl_animation_overlay_calculator, whose bounds are used to cull stickers
+//  outside of the view frustum [OPTIONAL]
 //
 // Input:
 //  ANCHORS - Anchor data with x,y,z coordinates (x,y are in [0.0-1.0] range for
@@ -68,10 +87,20 @@ namespace {
 //  IMU_ROTATION - float[9] of row-major device rotation matrix [REQUIRED]
 //  USER_ROTATIONS - UserRotations with corresponding radians of rotation [REQUIRED]
 //  USER_SCALINGS - UserScalings with corresponding scale factor [REQUIRED]
+//  RENDER_DATA - Render ids of each sticker, in the same order as the user
+//  rotations [REQUIRED]
+//  (USER_ROTATIONS, USER_SCALINGS and RENDER_DATA are only sent when the sticker
+//  set changes, the last packets received are held in between)
 //  GIF_ASPECT_RATIO - Aspect ratio of GIF image used to dynamically scale GIF asset
 //  defined as width / height [OPTIONAL]
-// Output:
-//  MATRICES - TimedModelMatrixProtoList of each object type to render [REQUIRED]
+// Output (at least one of the following, indexed by render id):
+//  MATRIX_BUFFERS - ModelMatrixBuffer of each object type to render
+//  MATRICES - TimedModelMatrixProtoList of each object type to render (kept for
+//  compatibility with calculators that only accept the proto format)
+//
+// Stickers of a render id with an ANIMATION_ASSET are left out of the outputs
+// whenever the bounding sphere of their asset, over all animation frames, lies
+// entirely outside of the view frustum defined by FOV and ASPECT_RATIO.
 //
 // Example config:
 // node{
@@ -80,11 +109,14 @@ namespace {
 //  input_stream: "IMU_ROTATION:imu_rotation_matrix"
 //  input_stream: "USER_ROTATIONS:user_rotation_data"
 //  input_stream: "USER_SCALINGS:user_scaling_data"
+//  input_stream: "RENDER_DATA:sticker_render_data"
 //  input_stream: "GIF_ASPECT_RATIO:gif_aspect_ratio"
-//  output_stream: "MATRICES:0:first_render_matrices"
-//  output_stream: "MATRICES:1:second_render_matrices" [unbounded input size]
+//  output_stream: "MATRIX_BUFFERS:0:first_render_matrices"
+//  output_stream: "MATRIX_BUFFERS:1:second_render_matrices" [unbounded input size]
 //  input_side_packet: "FOV:vertical_fov_radians"
 //  input_side_packet: "ASPECT_RATIO:aspect_ratio"
+//  input_side_packet: "ANIMATION_ASSET:0:first_asset_name"
+//  input_side_packet: "ANIMATION_ASSET:1:second_asset_name"
 // }
 
 class MatricesManagerCalculator : public CalculatorBase {
@@ -93,30 +125,65 @@ class MatricesManagerCalculator : public CalculatorBase {
     ::mediapipe::Status Open(CalculatorContext* cc) override;
     ::mediapipe::Status Process(CalculatorContext* cc) override;
   private:
-    const DiagonalMatrix3f GenerateScalingMatrix(const float scale_factor);
-    const Matrix3f GenerateUserRotationMatrix(const float rotation_radians);
-    const Matrix4fCM GenerateEigenModelMatrix(const Vector3f translation_vector,
-      const Matrix3f rotation_submatrix);
-    const Vector3f GenerateAnchorVector(const Anchor tracked_anchor);
-
-    // Returns a user scaling increment associated with the sticker_id
-    // TODO: Adjust lookup function if total number of stickers is uncapped to improve performance
-    const float GetUserScaler(const std::vector<UserScaling> scalings, const int sticker_id) {
-      for (const UserScaling &user_scaling : scalings) {
-        if (user_scaling.sticker_id == sticker_id) {
-          return user_scaling.scale_factor;
-        }
-      }
-    }
-    // Returns a user rotation in radians associated with the sticker_id
-    const float GetUserRotation(const std::vector<UserRotation> rotations, const int sticker_id) {
-      for (const UserRotation &rotation : rotations) {
-        if (rotation.sticker_id == sticker_id) {
-          return rotation.rotation_radians;
-        }
-      }
+    // Generates the transformations shared by all stickers in this frame
+    void GenerateModelMatrixFrame(const Matrix3f& imu_rotation_submatrix,
+      ModelMatrixFrame* frame);
+
+    // All user-controlled data associated with a single sticker. The user
+    // rotation is stored as its cosine and sine, as required by the kernel.
+    struct StickerState {
+      float cos_rotation = 1.0f;
+      float sin_rotation = 0.0f;
+      float scale_factor = 1.0f;
+      int render_id = kNoRenderId;
+    };
+
+    // Rebuilds the sticker state index from the last received sticker data
+    void UpdateStickerStates();
+
+    // Returns the state associated with the sticker_id. Stickers without any
+    // user data fall back to a default state, which is not rendered.
+    const StickerState& GetStickerState(const int sticker_id) const {
+      const auto it = sticker_states_.find(sticker_id);
+      return it != sticker_states_.end() ? it->second : kDefaultStickerState;
     }
 
+    static const StickerState kDefaultStickerState;
+
+    // Sphere enclosing every frame of an asset, in model coordinates
+    struct BoundingSphere {
+      Vector3f center = Vector3f::Zero();
+      float radius = 0.0f;
+      // Stickers without known bounds are never culled
+      bool valid = false;
+    };
+
+    // Computes the bounding sphere of the animation asset at path
+    static ::mediapipe::Status ComputeBoundingSphere(const std::string& path,
+      BoundingSphere* sphere);
+
+    // Returns whether the bounding sphere of a sticker, transformed by the
+    // model matrix the kernel would generate for it, intersects the view
+    // frustum
+    bool IsInViewFrustum(const ModelMatrixFrame& frame,
+      const BoundingSphere& sphere, const Anchor& anchor,
+      const StickerState& sticker_state, const Vector3f& scaling) const;
+
+    // Last sticker data received from the sticker manager
+    std::vector<UserRotation> user_rotation_data_;
+    std::vector<UserScaling> user_scaling_data_;
+    std::vector<int> render_data_;
+    // Sticker states indexed by sticker_id, shared by all per-anchor lookups
+    absl::flat_hash_map<int, StickerState> sticker_states_;
+
+    // Per render id batches of sticker data, reused across frames
+    std::vector<ModelMatrixBatch> render_batches_;
+    // Per render id bounds of the assets, computed once in Open
+    std::vector<BoundingSphere> bounding_spheres_;
+    // Unit normals of the side planes of the view frustum, pointing outwards.
+    // All planes go through the camera, which looks down the negative z-axis.
+    Vector3f frustum_normals_[kNumFrustumPlanes];
+
     // This returns a scale factor by which to alter the projection matrix for
     // the specified render id in order to ensure all objects render at a similar
     // size in the view screen upon initial placement
@@ -152,6 +219,9 @@ class MatricesManagerCalculator : public CalculatorBase {
 
 REGISTER_CALCULATOR(MatricesManagerCalculator);
 
+const MatricesManagerCalculator::StickerState
+    MatricesManagerCalculator::kDefaultStickerState;
+
 ::mediapipe::Status MatricesManagerCalculator::GetContract(
     CalculatorContract* cc) {
   RET_CHECK(cc->Inputs().HasTag(kAnchorsTag)
@@ -173,12 +243,24 @@ REGISTER_CALCULATOR(MatricesManagerCalculator);
     cc->Inputs().Tag(kGifAspectRatioTag).Set<float>();
   }
 
-  for (CollectionItemId id = cc->Outputs().BeginId("MATRICES");
-         id < cc->Outputs().EndId("MATRICES"); ++id) {
+  RET_CHECK(cc->Outputs().HasTag(kMatrixBuffersTag)
+    || cc->Outputs().HasTag(kMatricesTag));
+  for (CollectionItemId id = cc->Outputs().BeginId(kMatrixBuffersTag);
+         id < cc->Outputs().EndId(kMatrixBuffersTag); ++id) {
+           cc->Outputs().Get(id).Set<ModelMatrixBuffer>();
+  }
+  for (CollectionItemId id = cc->Outputs().BeginId(kMatricesTag);
+         id < cc->Outputs().EndId(kMatricesTag); ++id) {
            cc->Outputs().Get(id).Set<TimedModelMatrixProtoList>();
   }
   cc->InputSidePackets().Tag(kFOVSidePacketTag).Set<float>();
   cc->InputSidePackets().Tag(kAspectRatioSidePacketTag).Set<float>();
+  for (CollectionItemId id =
+         cc->InputSidePackets().BeginId(kAnimationAssetSidePacketTag);
+         id < cc->InputSidePackets().EndId(kAnimationAssetSidePacketTag);
+         ++id) {
+    cc->InputSidePackets().Get(id).Set<std::string>();
+  }
 
   return ::mediapipe::OkStatus();
 }
@@ -188,27 +270,57 @@ REGISTER_CALCULATOR(MatricesManagerCalculator);
   // Set device properties from side packets
   vertical_fov_radians_ = cc->InputSidePackets().Tag(kFOVSidePacketTag).Get<float>();
   aspect_ratio_ = cc->InputSidePackets().Tag(kAspectRatioSidePacketTag).Get<float>();
+  // One batch of sticker data for each output index (render id)
+  render_batches_.resize(std::max(cc->Outputs().NumEntries(kMatrixBuffersTag),
+                                  cc->Outputs().NumEntries(kMatricesTag)));
+
+  // Asset bounds only depend on the asset, so they are computed only once
+  bounding_spheres_.resize(render_batches_.size());
+  for (size_t render_id = 0; render_id < bounding_spheres_.size();
+       ++render_id) {
+    const CollectionItemId asset_id = cc->InputSidePackets().GetId(
+        kAnimationAssetSidePacketTag, static_cast<int>(render_id));
+    if (asset_id.IsValid()) {
+      MP_RETURN_IF_ERROR(ComputeBoundingSphere(
+          cc->InputSidePackets().Get(asset_id).Get<std::string>(),
+          &bounding_spheres_[render_id]))
+          << "Failed to compute the bounds of asset " << render_id;
+    }
+  }
+
+  // Points inside the frustum satisfy |x| <= -z * tan_x and |y| <= -z * tan_y,
+  // for the half angles of the horizontal and vertical fields of view.
+  const float tan_y = std::tan(vertical_fov_radians_ * 0.5f);
+  const float tan_x = tan_y * aspect_ratio_;
+  frustum_normals_[0] = Vector3f(1.0f, 0.0f, tan_x).normalized();
+  frustum_normals_[1] = Vector3f(-1.0f, 0.0f, tan_x).normalized();
+  frustum_normals_[2] = Vector3f(0.0f, 1.0f, tan_y).normalized();
+  frustum_normals_[3] = Vector3f(0.0f, -1.0f, tan_y).normalized();
   return ::mediapipe::OkStatus();
 }
 
 ::mediapipe::Status MatricesManagerCalculator::Process(CalculatorContext* cc) {
-  // Define each object's model matrices
-  auto asset_matrices_gif = std::make_unique<TimedModelMatrixProtoList>();
-  auto asset_matrices_1 = std::make_unique<TimedModelMatrixProtoList>();
-  // Clear all model matrices
-  asset_matrices_gif.get()->clear_model_matrix();
-  asset_matrices_1.get()->clear_model_matrix();
-
-  const std::vector<UserRotation> user_rotation_data =
-      cc->Inputs().Tag(kUserRotationsTag).Get<std::vector<UserRotation>>();
-
-  const std::vector<UserScaling> user_scaling_data =
+  // Sticker data is only streamed in when it changes
+  bool sticker_data_changed = false;
+  if (!cc->Inputs().Tag(kUserRotationsTag).IsEmpty()) {
+    user_rotation_data_ =
+        cc->Inputs().Tag(kUserRotationsTag).Get<std::vector<UserRotation>>();
+    sticker_data_changed = true;
+  }
+  if (!cc->Inputs().Tag(kUserScalingsTag).IsEmpty()) {
+    user_scaling_data_ =
         cc->Inputs().Tag(kUserScalingsTag).Get<std::vector<UserScaling>>();
+    sticker_data_changed = true;
+  }
+  if (!cc->Inputs().Tag(kRendersTag).IsEmpty()) {
+    render_data_ = cc->Inputs().Tag(kRendersTag).Get<std::vector<int>>();
+    sticker_data_changed = true;
+  }
+  if (sticker_data_changed) {
+    UpdateStickerStates();
+  }
 
-  const std::vector<int> render_data =
-      cc->Inputs().Tag(kRendersTag).Get<std::vector<int>>();
-
-  const std::vector<Anchor> anchor_data =
+  const std::vector<Anchor>& anchor_data =
       cc->Inputs()
           .Tag(kAnchorsTag)
           .Get<std::vector<Anchor>>();
@@ -229,129 +341,214 @@ REGISTER_CALCULATOR(MatricesManagerCalculator);
     }
   }
 
-  int render_idx = 0;
-  for (const Anchor &anchor : anchor_data) {
-    const int id = anchor.sticker_id;
-
-    TimedModelMatrixProto* model_matrix;
+  // All transformations shared by the stickers are only computed once
+  ModelMatrixFrame frame;
+  GenerateModelMatrixFrame(imu_rotation_submatrix, &frame);
 
-    // Add model matrix to matrices list for defined object render ID
-    if (render_data[render_idx] == 0) { // GIF
-      model_matrix = asset_matrices_gif.get()->add_model_matrix();
-    }
-    else if (render_data[render_idx] == 1) { // Asset 1
-      model_matrix = asset_matrices_1.get()->add_model_matrix();
+  // Sort the sticker data into a batch for each object render ID
+  for (ModelMatrixBatch& batch : render_batches_) {
+    batch.Clear();
+  }
+  int culled_stickers = 0;
+  for (const Anchor &anchor : anchor_data) {
+    // The user transformation data associated with this sticker
+    const StickerState& sticker_state = GetStickerState(anchor.sticker_id);
+    // Unknown render ids (including stickers without user data) are skipped
+    if (sticker_state.render_id < 0 ||
+        sticker_state.render_id >= static_cast<int>(render_batches_.size())) {
+      continue;
     }
-
-    model_matrix->set_id(id);
-
-    // The user transformation data associated with this sticker must be defined
-    const float user_rotation_radians = GetUserRotation(user_rotation_data, id);
-    const float user_scale_factor = GetUserScaler(user_scaling_data, id);
-
-    // A vector representative of a user's sticker rotation transformation can be created
-    const Matrix3f user_rotation_submatrix = GenerateUserRotationMatrix(user_rotation_radians);
-    // Next, the diagonal representative of the combined scaling data
-    DiagonalMatrix3f scaling_diagonal = GetDefaultRenderScaleDiagonal(render_data[render_idx], user_scale_factor, gif_aspect_ratio);
-    // Increment to next render id from vector
-    render_idx++;
-
-    // The user transformation data can be concatenated into a final rotation submatrix with the
-    // device IMU rotational data
-    const Matrix3f user_transformed_rotation_submatrix = imu_rotation_submatrix * user_rotation_submatrix * scaling_diagonal;
-
-    // A vector representative of the translation of the object in OpenGL coordinate space must be generated
-    const Vector3f translation_vector = GenerateAnchorVector(anchor);
-
-    // Concatenate all model matrix data
-    const Matrix4fCM final_model_matrix = GenerateEigenModelMatrix(translation_vector, user_transformed_rotation_submatrix);
-
-    // The generated model matrix must be mapped to TimedModelMatrixProto (col-wise)
-    for (int x = 0; x < final_model_matrix.rows(); ++x) {
-      for (int y = 0; y < final_model_matrix.cols(); ++y) {
-        model_matrix->add_matrix_entries(final_model_matrix(x, y));
-      }
+    // The diagonal representative of the combined scaling data
+    const Vector3f scaling = GetDefaultRenderScaleDiagonal(
+        sticker_state.render_id, sticker_state.scale_factor,
+        gif_aspect_ratio).diagonal();
+    // Stickers out of view are dropped before their matrices are generated
+    if (!IsInViewFrustum(frame, bounding_spheres_[sticker_state.render_id],
+                         anchor, sticker_state, scaling)) {
+      ++culled_stickers;
+      continue;
     }
+    render_batches_[sticker_state.render_id].Add(
+        anchor.sticker_id, anchor.x, anchor.y, anchor.z,
+        sticker_state.cos_rotation, sticker_state.sin_rotation, scaling.x(),
+        scaling.y(), scaling.z());
+  }
+  int drawn_stickers = 0;
+  for (const ModelMatrixBatch& batch : render_batches_) {
+    drawn_stickers += batch.size();
   }
+  cc->GetCounter(kCulledStickersCounter)->IncrementBy(culled_stickers);
+  cc->GetCounter(kDrawnStickersCounter)->IncrementBy(drawn_stickers);
 
   // Output all individual render matrices
   // TODO: Perform depth ordering with gl_animation_overlay_calculator to render
   // objects in order by depth to allow occlusion.
-  cc->Outputs()
-          .Get(cc->Outputs().GetId("MATRICES", 0))
-          .Add(asset_matrices_gif.release(), cc->InputTimestamp());
-  cc->Outputs()
-          .Get(cc->Outputs().GetId("MATRICES", 1))
-          .Add(asset_matrices_1.release(), cc->InputTimestamp());
+  const int num_renders = render_batches_.size();
+  for (int render_id = 0; render_id < num_renders; ++render_id) {
+    const ModelMatrixBatch& batch = render_batches_[render_id];
+    // The kernel writes straight into the packet that is sent downstream
+    auto matrix_buffer = absl::make_unique<ModelMatrixBuffer>();
+    matrix_buffer->Resize(batch.size());
+    ComputeModelMatrices(frame, batch, matrix_buffer->matrices.data());
+    std::copy(batch.sticker_id.begin(), batch.sticker_id.end(),
+              matrix_buffer->ids.begin());
+
+    const CollectionItemId proto_id =
+        cc->Outputs().GetId(kMatricesTag, render_id);
+    if (proto_id.IsValid()) {
+      auto asset_matrices = absl::make_unique<TimedModelMatrixProtoList>();
+      for (int i = 0; i < matrix_buffer->size(); ++i) {
+        TimedModelMatrixProto* model_matrix = asset_matrices->add_model_matrix();
+        model_matrix->set_id(matrix_buffer->ids[i]);
+        // The generated model matrix must be mapped to TimedModelMatrixProto
+        // (row-major)
+        const float* matrix = matrix_buffer->matrix(i);
+        for (int row = 0; row < 4; ++row) {
+          for (int col = 0; col < 4; ++col) {
+            model_matrix->add_matrix_entries(matrix[col * 4 + row]);
+          }
+        }
+      }
+      cc->Outputs()
+              .Get(proto_id)
+              .Add(asset_matrices.release(), cc->InputTimestamp());
+    }
+
+    const CollectionItemId buffer_id =
+        cc->Outputs().GetId(kMatrixBuffersTag, render_id);
+    if (buffer_id.IsValid()) {
+      cc->Outputs()
+              .Get(buffer_id)
+              .Add(matrix_buffer.release(), cc->InputTimestamp());
+    }
+  }
 
   return ::mediapipe::OkStatus();
 }
 
-// Using a specified rotation value in radians, generate a rotation matrix for use with base rotation submatrix
-const Matrix3f MatricesManagerCalculator::GenerateUserRotationMatrix(const float rotation_radians) {
-  Eigen::Matrix3f user_rotation_submatrix;
-    user_rotation_submatrix =
-        // The rotation in radians must be inverted to rotate the object
-        // with the direction of finger movement from the user (system dependent)
-        Eigen::AngleAxisf(-rotation_radians, Eigen::Vector3f::UnitY()) *
-        Eigen::AngleAxisf(0.0f, Eigen::Vector3f::UnitZ()) *
-        // Model orientations all assume z-axis is up, but we need y-axis upwards,
-        // therefore, a +(M_PI * 0.5f) transformation must be applied
-        // TODO: Bring default rotations, translations, and scalings into independent
-        // sticker configuration
-        Eigen::AngleAxisf(M_PI * 0.5f, Eigen::Vector3f::UnitX());
-  // Matrix must be transposed due to the method of submatrix generation in Eigen
-  return user_rotation_submatrix.transpose();
+void MatricesManagerCalculator::UpdateStickerStates() {
+  sticker_states_.clear();
+  sticker_states_.reserve(user_rotation_data_.size());
+  // Render ids are provided in the same order as the user rotations
+  for (size_t i = 0; i < user_rotation_data_.size(); ++i) {
+    StickerState& state = sticker_states_[user_rotation_data_[i].sticker_id];
+    // The rotation in radians is inverted to rotate the object with the
+    // direction of finger movement from the user (system dependent), which
+    // cancels out with the transposition of the rotation submatrix.
+    state.cos_rotation = std::cos(user_rotation_data_[i].rotation_radians);
+    state.sin_rotation = std::sin(user_rotation_data_[i].rotation_radians);
+    if (i < render_data_.size()) {
+      state.render_id = render_data_[i];
+    }
+  }
+  for (const UserScaling &user_scaling : user_scaling_data_) {
+    sticker_states_[user_scaling.sticker_id].scale_factor =
+        user_scaling.scale_factor;
+  }
 }
 
-// Using a specified scale factor, generate a scaling matrix for use with base rotation submatrix
-const DiagonalMatrix3f MatricesManagerCalculator::GenerateScalingMatrix(const float scale_factor) {
-  DiagonalMatrix3f scaling_matrix(scale_factor, scale_factor, scale_factor);
-  return scaling_matrix;
+::mediapipe::Status MatricesManagerCalculator::ComputeBoundingSphere(
+    const std::string& path, BoundingSphere* sphere) {
+  // The overlay renders the same asset, so it is loaded only once between them
+  auto animation_or = Singleton<AnimationAssetCache>::get()->Acquire(path);
+  if (!animation_or.ok()) {
+    return animation_or.status();
+  }
+  const std::shared_ptr<const CachedAnimation> animation =
+      std::move(animation_or).ValueOrDie();
+  const AnimationAsset* asset = &animation->asset();
+  const int vertex_count = asset->vertex_data_size() /
+      (kAnimationVertexFloats * sizeof(float));
+  RET_CHECK_GT(vertex_count, 0) << "Asset has no vertices: " << path;
+
+  // The sphere around the bounding box of all frames is not the smallest one,
+  // but is close enough for the few stickers that are drawn
+  Vector3f min_position = Vector3f::Constant(
+      std::numeric_limits<float>::max());
+  Vector3f max_position = -min_position;
+  const float* vertex = asset->vertex_data() + kAnimationVertexPositionOffset;
+  for (int i = 0; i < vertex_count; ++i, vertex += kAnimationVertexFloats) {
+    const Vector3f position(vertex[0], vertex[1], vertex[2]);
+    min_position = min_position.cwiseMin(position);
+    max_position = max_position.cwiseMax(position);
+  }
+  sphere->center = (min_position + max_position) * 0.5f;
+  float squared_radius = 0.0f;
+  vertex = asset->vertex_data() + kAnimationVertexPositionOffset;
+  for (int i = 0; i < vertex_count; ++i, vertex += kAnimationVertexFloats) {
+    squared_radius = std::max(squared_radius,
+        (Vector3f(vertex[0], vertex[1], vertex[2]) - sphere->center)
+            .squaredNorm());
+  }
+  sphere->radius = std::sqrt(squared_radius);
+  sphere->valid = true;
+  return ::mediapipe::OkStatus();
 }
 
-// TODO: Investigate possible differences in warping of tracking speed across screen
-// Using the sticker anchor data, a translation vector can be generated in OpenGL coordinate space
-const Vector3f MatricesManagerCalculator::GenerateAnchorVector(const Anchor tracked_anchor) {
-  // Using an initial z-value in OpenGL space, generate a new base z-axis value to mimic scaling by distance.
-  const float z = kInitialZ * tracked_anchor.z;
-
-  // Using triangle geometry, the minimum for a y-coordinate that will appear in the view field
-  // for the given z value above can be found.
-  const float y_half_range = z * (tan(vertical_fov_radians_ * 0.5f));
-
-  // The aspect ratio of the device and y_minimum calculated above can be used to find the
-  // minimum value for x that will appear in the view field of the device screen.
-  const float x_half_range = y_half_range * aspect_ratio_;
-
-  // Given the minimum bounds of the screen in OpenGL space, the tracked anchor coordinates
-  // can be converted to OpenGL coordinate space.
-  //
-  // (i.e: X and Y will be converted from [0.0-1.0] space to [x_minimum, -x_minimum] space
-  // and [y_minimum, -y_minimum] space respectively)
-  const float x = (-2.0f * tracked_anchor.x * x_half_range) + x_half_range;
-  const float y = (-2.0f * tracked_anchor.y * y_half_range) + y_half_range;
-
-  // A translation transformation vector can be generated via Eigen
-  const Vector3f t_vector(x,y,z);
-  return t_vector;
+bool MatricesManagerCalculator::IsInViewFrustum(const ModelMatrixFrame& frame,
+    const BoundingSphere& sphere, const Anchor& anchor,
+    const StickerState& sticker_state, const Vector3f& scaling) const {
+  if (!sphere.valid) {
+    return true;
+  }
+  // Same transformation as the model matrix kernel: the user rotation about
+  // the y-axis of the base rotation, the scaling, then the anchor translation
+  const Eigen::Map<const Matrix3f> base_rotation(frame.base_rotation);
+  const float cos_rotation = sticker_state.cos_rotation;
+  const float sin_rotation = sticker_state.sin_rotation;
+  const Vector3f& center = sphere.center;
+  const Vector3f translation(
+      anchor.z * frame.translation_scale[0] * (1.0f - 2.0f * anchor.x),
+      anchor.z * frame.translation_scale[1] * (1.0f - 2.0f * anchor.y),
+      anchor.z * frame.translation_scale[2]);
+  const Vector3f view_center =
+      (cos_rotation * base_rotation.col(0) -
+       sin_rotation * base_rotation.col(2)) * (scaling.x() * center.x()) +
+      base_rotation.col(1) * (scaling.y() * center.y()) +
+      (sin_rotation * base_rotation.col(0) +
+       cos_rotation * base_rotation.col(2)) * (scaling.z() * center.z()) +
+      translation;
+  // Rotations preserve distances, so only the largest scale enlarges the sphere
+  const float view_radius = sphere.radius * scaling.cwiseAbs().maxCoeff();
+
+  // Spheres entirely behind the camera are out of view
+  if (view_center.z() > view_radius) {
+    return false;
+  }
+  for (int i = 0; i < kNumFrustumPlanes; ++i) {
+    if (frustum_normals_[i].dot(view_center) > view_radius) {
+      return false;
+    }
+  }
+  return true;
 }
 
-// Generates a model matrix via Eigen with appropriate transformations
-const Matrix4fCM MatricesManagerCalculator::GenerateEigenModelMatrix(
-    Vector3f translation_vector, Matrix3f rotation_submatrix) {
-  // Define basic empty model matrix
-  Matrix4fCM mvp_matrix;
-
-  // Set the translation vector
-  mvp_matrix.topRightCorner<3, 1>() = translation_vector;
-
-  // Set the rotation submatrix
-  mvp_matrix.topLeftCorner<3, 3>() = rotation_submatrix;
-
-  // Set trailing 1.0 required by OpenGL to define coordinate space
-  mvp_matrix(3,3) = 1.0f;
-
-  return mvp_matrix;
+void MatricesManagerCalculator::GenerateModelMatrixFrame(
+    const Matrix3f& imu_rotation_submatrix, ModelMatrixFrame* frame) {
+  // Model orientations all assume z-axis is up, but we need y-axis upwards,
+  // therefore, a +(M_PI * 0.5f) transformation must be applied. Each sticker's
+  // rotation submatrix is transposed, which turns this into the inverse
+  // rotation that is concatenated with the device IMU rotational data.
+  // TODO: Bring default rotations, translations, and scalings into independent
+  // sticker configuration
+  const Matrix3f base_rotation =
+      imu_rotation_submatrix *
+      Eigen::AngleAxisf(M_PI * 0.5f, Vector3f::UnitX()).toRotationMatrix()
+          .transpose();
+  Eigen::Map<Matrix3f>(frame->base_rotation) = base_rotation;
+
+  // TODO: Investigate possible differences in warping of tracking speed across screen
+  // Using an initial z-value in OpenGL space, the base z-axis value of each
+  // anchor is kInitialZ * anchor.z to mimic scaling by distance.
+  //
+  // Using triangle geometry, the minimum for a y-coordinate that will appear in
+  // the view field for that z value can be found, and the aspect ratio of the
+  // device gives the equivalent minimum for x. The tracked anchor coordinates
+  // can then be converted from [0.0-1.0] space to [x_minimum, -x_minimum] and
+  // [y_minimum, -y_minimum] space respectively.
+  const float y_half_range_per_z = kInitialZ * tan(vertical_fov_radians_ * 0.5f);
+  frame->translation_scale[0] = y_half_range_per_z * aspect_ratio_;
+  frame->translation_scale[1] = y_half_range_per_z;
+  frame->translation_scale[2] = kInitialZ;
 }
 }
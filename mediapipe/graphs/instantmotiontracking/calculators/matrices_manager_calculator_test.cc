@@ -0,0 +1,270 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/port/file_helpers.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/integral_types.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/animation_asset.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/model_matrix_buffer.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/transformations.h"
+#include "mediapipe/graphs/object_detection_3d/calculators/model_matrix.pb.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr float kVerticalFovRadians = 1.19f;
+constexpr float kAspectRatio = 0.75f;
+
+// A sticker as placed by the user
+struct TestSticker {
+  int id;
+  float x;
+  float y;
+  float z;
+  float rotation_radians;
+  float scale_factor;
+  int render_id;
+};
+
+// Returns the node config, with animation assets to cull stickers by if
+// with_assets is true
+CalculatorGraphConfig::Node MakeNodeConfig(bool with_assets = false) {
+  std::string config = R"(
+    calculator: "MatricesManagerCalculator"
+    input_stream: "ANCHORS:anchors"
+    input_stream: "IMU_ROTATION:imu_rotation"
+    input_stream: "USER_ROTATIONS:user_rotations"
+    input_stream: "USER_SCALINGS:user_scalings"
+    input_stream: "RENDER_DATA:render_data"
+    output_stream: "MATRIX_BUFFERS:0:gif_matrix_buffers"
+    output_stream: "MATRIX_BUFFERS:1:asset_3d_matrix_buffers"
+    output_stream: "MATRICES:0:gif_matrices"
+    output_stream: "MATRICES:1:asset_3d_matrices"
+    input_side_packet: "FOV:vertical_fov_radians"
+    input_side_packet: "ASPECT_RATIO:aspect_ratio"
+  )";
+  if (with_assets) {
+    config += R"(
+      input_side_packet: "ANIMATION_ASSET:0:gif_asset_name"
+      input_side_packet: "ANIMATION_ASSET:1:asset_3d"
+    )";
+  }
+  return ParseTextProtoOrDie<CalculatorGraphConfig::Node>(config);
+}
+
+// Sends the stickers to the calculator as a single frame, with the device held
+// upright
+void AddFrame(const std::vector<TestSticker>& stickers, int64 timestamp,
+              CalculatorRunner* runner) {
+  std::vector<Anchor> anchors;
+  std::vector<UserRotation> user_rotations;
+  std::vector<UserScaling> user_scalings;
+  std::vector<int> render_data;
+  for (const TestSticker& sticker : stickers) {
+    anchors.push_back({sticker.x, sticker.y, sticker.z, sticker.id});
+    user_rotations.push_back({sticker.rotation_radians, sticker.id});
+    user_scalings.push_back({sticker.scale_factor, sticker.id});
+    render_data.push_back(sticker.render_id);
+  }
+  float* imu_rotation = new float[9]{1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+                                     0.0f, 0.0f, 0.0f, 1.0f};
+
+  runner->MutableInputs()->Tag("ANCHORS").packets.push_back(
+      MakePacket<std::vector<Anchor>>(anchors).At(Timestamp(timestamp)));
+  runner->MutableInputs()->Tag("IMU_ROTATION").packets.push_back(
+      Adopt(reinterpret_cast<float(*)[]>(imu_rotation))
+          .At(Timestamp(timestamp)));
+  runner->MutableInputs()->Tag("USER_ROTATIONS").packets.push_back(
+      MakePacket<std::vector<UserRotation>>(user_rotations)
+          .At(Timestamp(timestamp)));
+  runner->MutableInputs()->Tag("USER_SCALINGS").packets.push_back(
+      MakePacket<std::vector<UserScaling>>(user_scalings)
+          .At(Timestamp(timestamp)));
+  runner->MutableInputs()->Tag("RENDER_DATA").packets.push_back(
+      MakePacket<std::vector<int>>(render_data).At(Timestamp(timestamp)));
+}
+
+void SetSidePackets(CalculatorRunner* runner) {
+  runner->MutableSidePackets()->Tag("FOV") =
+      MakePacket<float>(kVerticalFovRadians);
+  runner->MutableSidePackets()->Tag("ASPECT_RATIO") =
+      MakePacket<float>(kAspectRatio);
+}
+
+// Writes an animation of a single right triangle with unit legs, whose
+// bounding sphere has a radius of about 0.7, and returns its path
+std::string WriteTriangleAsset() {
+  const int32 lengths[3] = {9, 6, 3};
+  const float positions[9] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+                              0.0f, 0.0f, 1.0f, 0.0f};
+  const float texture_coords[6] = {0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f};
+  const int16 indices[3] = {0, 1, 2};
+  std::string legacy_asset;
+  legacy_asset.append(reinterpret_cast<const char*>(lengths), sizeof(lengths));
+  legacy_asset.append(reinterpret_cast<const char*>(positions),
+                      sizeof(positions));
+  legacy_asset.append(reinterpret_cast<const char*>(texture_coords),
+                      sizeof(texture_coords));
+  legacy_asset.append(reinterpret_cast<const char*>(indices), sizeof(indices));
+  auto converted = AnimationAsset::ConvertLegacyAsset(legacy_asset.data(),
+                                                      legacy_asset.size());
+  EXPECT_TRUE(converted.ok()) << converted.status();
+  const std::string path = ::testing::TempDir() + "/triangle.uuu";
+  MP_EXPECT_OK(file::SetContents(path, std::move(converted).ValueOrDie()));
+  return path;
+}
+
+void SetAssetSidePackets(CalculatorRunner* runner) {
+  const std::string path = WriteTriangleAsset();
+  runner->MutableSidePackets()->Get("ANIMATION_ASSET", 0) =
+      MakePacket<std::string>(path);
+  runner->MutableSidePackets()->Get("ANIMATION_ASSET", 1) =
+      MakePacket<std::string>(path);
+}
+
+// Returns the ids of the stickers drawn with the 3D asset
+std::vector<int> DrawnAssetIds(const CalculatorRunner& runner) {
+  const std::vector<Packet>& packets =
+      runner.Outputs().Get("MATRIX_BUFFERS", 1).packets;
+  EXPECT_EQ(packets.size(), 1u);
+  if (packets.empty()) {
+    return {};
+  }
+  return packets[0].Get<ModelMatrixBuffer>().ids;
+}
+
+TEST(MatricesManagerCalculatorTest, BuffersMatchProtoMatrices) {
+  CalculatorRunner runner(MakeNodeConfig());
+  SetSidePackets(&runner);
+  AddFrame({{1, 0.5f, 0.5f, 1.0f, 0.0f, 1.0f, 0},
+            {2, 0.3f, 0.6f, 0.8f, 1.2f, 2.0f, 1},
+            {3, 0.7f, 0.4f, 1.3f, -0.4f, 0.5f, 0},
+            {4, 0.2f, 0.2f, 1.0f, 3.0f, 1.5f, 1},
+            {5, 0.6f, 0.7f, 1.1f, 0.9f, 1.0f, 0}},
+           0, &runner);
+  MP_ASSERT_OK(runner.Run());
+
+  const std::vector<std::vector<int>> expected_ids = {{1, 3, 5}, {2, 4}};
+  for (int render_id = 0; render_id < 2; ++render_id) {
+    const std::vector<Packet>& buffer_packets =
+        runner.Outputs().Get("MATRIX_BUFFERS", render_id).packets;
+    const std::vector<Packet>& proto_packets =
+        runner.Outputs().Get("MATRICES", render_id).packets;
+    ASSERT_EQ(buffer_packets.size(), 1u);
+    ASSERT_EQ(proto_packets.size(), 1u);
+    const ModelMatrixBuffer& buffer =
+        buffer_packets[0].Get<ModelMatrixBuffer>();
+    const TimedModelMatrixProtoList& protos =
+        proto_packets[0].Get<TimedModelMatrixProtoList>();
+
+    EXPECT_EQ(buffer.ids, expected_ids[render_id]);
+    ASSERT_EQ(buffer.matrices.size(),
+              static_cast<size_t>(buffer.size() * kModelMatrixSize));
+    // The buffer can be loaded with aligned SIMD instructions
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer.matrices.data()) % 16, 0u);
+
+    ASSERT_EQ(protos.model_matrix_size(), buffer.size());
+    for (int i = 0; i < buffer.size(); ++i) {
+      const TimedModelMatrixProto& proto = protos.model_matrix(i);
+      EXPECT_EQ(proto.id(), buffer.ids[i]);
+      ASSERT_EQ(proto.matrix_entries_size(), kModelMatrixSize);
+      // Proto entries are row-major, buffer matrices column-major
+      const float* matrix = buffer.matrix(i);
+      for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 4; ++col) {
+          EXPECT_EQ(proto.matrix_entries(row * 4 + col), matrix[col * 4 + row])
+              << "sticker " << buffer.ids[i] << ", row " << row
+              << ", column " << col;
+        }
+      }
+    }
+  }
+}
+
+TEST(MatricesManagerCalculatorTest, CentersStickerAtScreenCenter) {
+  CalculatorRunner runner(MakeNodeConfig());
+  SetSidePackets(&runner);
+  AddFrame({{1, 0.5f, 0.5f, 1.0f, 0.0f, 1.0f, 1}}, 0, &runner);
+  MP_ASSERT_OK(runner.Run());
+
+  const ModelMatrixBuffer& buffer = runner.Outputs()
+                                        .Get("MATRIX_BUFFERS", 1)
+                                        .packets[0]
+                                        .Get<ModelMatrixBuffer>();
+  ASSERT_EQ(buffer.size(), 1);
+  // An anchor at the screen center is placed straight ahead of the camera
+  const float* matrix = buffer.matrix(0);
+  EXPECT_NEAR(matrix[12], 0.0f, 1e-6f);
+  EXPECT_NEAR(matrix[13], 0.0f, 1e-6f);
+  EXPECT_FLOAT_EQ(matrix[14], -10.0f);
+  EXPECT_EQ(matrix[15], 1.0f);
+}
+
+TEST(MatricesManagerCalculatorTest, DrawsStickersInView) {
+  CalculatorRunner runner(MakeNodeConfig(/*with_assets=*/true));
+  SetSidePackets(&runner);
+  SetAssetSidePackets(&runner);
+  // Stickers at the screen center and corners, with their assets partly out
+  // of view at the corners
+  AddFrame({{1, 0.5f, 0.5f, 1.0f, 0.0f, 1.0f, 1},
+            {2, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1},
+            {3, 1.0f, 1.0f, 0.5f, 2.0f, 2.0f, 1}},
+           0, &runner);
+  MP_ASSERT_OK(runner.Run());
+
+  EXPECT_EQ(DrawnAssetIds(runner), std::vector<int>({1, 2, 3}));
+  EXPECT_EQ(runner.GetCounter("MatricesManagerCulledStickers")->Get(), 0);
+  EXPECT_EQ(runner.GetCounter("MatricesManagerDrawnStickers")->Get(), 3);
+}
+
+TEST(MatricesManagerCalculatorTest, CullsStickersOutOfView) {
+  CalculatorRunner runner(MakeNodeConfig(/*with_assets=*/true));
+  SetSidePackets(&runner);
+  SetAssetSidePackets(&runner);
+  // Stickers to the left of, below and behind the camera, around one in view
+  AddFrame({{1, -2.0f, 0.5f, 1.0f, 0.0f, 1.0f, 1},
+            {2, 0.5f, 0.5f, 1.0f, 0.0f, 1.0f, 1},
+            {3, 0.5f, -2.0f, 1.0f, 0.0f, 1.0f, 1},
+            {4, 0.5f, 0.5f, -1.0f, 0.0f, 1.0f, 1}},
+           0, &runner);
+  MP_ASSERT_OK(runner.Run());
+
+  EXPECT_EQ(DrawnAssetIds(runner), std::vector<int>({2}));
+  EXPECT_EQ(runner.GetCounter("MatricesManagerCulledStickers")->Get(), 3);
+  EXPECT_EQ(runner.GetCounter("MatricesManagerDrawnStickers")->Get(), 1);
+}
+
+TEST(MatricesManagerCalculatorTest, DrawsAllStickersWithoutAssets) {
+  CalculatorRunner runner(MakeNodeConfig());
+  SetSidePackets(&runner);
+  AddFrame({{1, -2.0f, 0.5f, 1.0f, 0.0f, 1.0f, 1},
+            {2, 0.5f, 0.5f, -1.0f, 0.0f, 1.0f, 1}},
+           0, &runner);
+  MP_ASSERT_OK(runner.Run());
+
+  // Without asset bounds, nothing is known to be out of view
+  EXPECT_EQ(DrawnAssetIds(runner), std::vector<int>({1, 2}));
+  EXPECT_EQ(runner.GetCounter("MatricesManagerCulledStickers")->Get(), 0);
+}
+
+}  // namespace
+}  // namespace mediapipe
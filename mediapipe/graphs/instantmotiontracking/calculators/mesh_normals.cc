@@ -0,0 +1,228 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/graphs/instantmotiontracking/calculators/mesh_normals.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "mediapipe/framework/port/threadpool.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace mediapipe {
+
+namespace {
+
+// Face normals are computed for four triangles at once. On ARM, only AArch64
+// has vectorized square roots and divisions, so 32-bit ARM uses the scalar
+// loop.
+#if defined(__SSE2__)
+struct SimdOps {
+  using Vec = __m128;
+  static Vec Load(const float* p) { return _mm_loadu_ps(p); }
+  static void Store(float* p, Vec v) { _mm_storeu_ps(p, v); }
+  static Vec Splat(float v) { return _mm_set1_ps(v); }
+  static Vec Add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+  static Vec Sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+  static Vec Mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+  static Vec Div(Vec a, Vec b) { return _mm_div_ps(a, b); }
+  static Vec Max(Vec a, Vec b) { return _mm_max_ps(a, b); }
+  static Vec Sqrt(Vec a) { return _mm_sqrt_ps(a); }
+};
+#define MEDIAPIPE_MESH_NORMALS_HAS_SIMD 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+struct SimdOps {
+  using Vec = float32x4_t;
+  static Vec Load(const float* p) { return vld1q_f32(p); }
+  static void Store(float* p, Vec v) { vst1q_f32(p, v); }
+  static Vec Splat(float v) { return vdupq_n_f32(v); }
+  static Vec Add(Vec a, Vec b) { return vaddq_f32(a, b); }
+  static Vec Sub(Vec a, Vec b) { return vsubq_f32(a, b); }
+  static Vec Mul(Vec a, Vec b) { return vmulq_f32(a, b); }
+  static Vec Div(Vec a, Vec b) { return vdivq_f32(a, b); }
+  static Vec Max(Vec a, Vec b) { return vmaxq_f32(a, b); }
+  static Vec Sqrt(Vec a) { return vsqrtq_f32(a); }
+};
+#define MEDIAPIPE_MESH_NORMALS_HAS_SIMD 1
+#endif
+
+constexpr int kLanes = 4;
+
+// Adds normal to the normal of vertex index
+inline void AddToVertexNormal(const TriangleMeshView& mesh, int index,
+                              const float normal[3]) {
+  float* vertex_normal = mesh.normals + index * mesh.vertex_stride;
+  vertex_normal[0] += normal[0];
+  vertex_normal[1] += normal[1];
+  vertex_normal[2] += normal[2];
+}
+
+void AccumulateFaceNormals(const TriangleMeshView& mesh,
+                           NormalWeighting weighting) {
+  const int triangle_count = mesh.index_count / 3;
+  const uint16* indices = mesh.indices;
+  int triangle = 0;
+#if defined(MEDIAPIPE_MESH_NORMALS_HAS_SIMD)
+  using Vec = SimdOps::Vec;
+  const Vec min_magnitude = SimdOps::Splat(FLT_MIN);
+  for (; triangle + kLanes <= triangle_count; triangle += kLanes) {
+    // Gather the corners of four triangles as [corner][axis][lane]
+    float corners[3][3][kLanes];
+    for (int lane = 0; lane < kLanes; ++lane) {
+      for (int corner = 0; corner < 3; ++corner) {
+        const float* position =
+            mesh.positions +
+            indices[(triangle + lane) * 3 + corner] * mesh.vertex_stride;
+        for (int axis = 0; axis < 3; ++axis) {
+          corners[corner][axis][lane] = position[axis];
+        }
+      }
+    }
+    // V2 - V1 and V3 - V1
+    Vec a[3];
+    Vec b[3];
+    for (int axis = 0; axis < 3; ++axis) {
+      const Vec v1 = SimdOps::Load(corners[0][axis]);
+      a[axis] = SimdOps::Sub(SimdOps::Load(corners[1][axis]), v1);
+      b[axis] = SimdOps::Sub(SimdOps::Load(corners[2][axis]), v1);
+    }
+    // Cross product
+    Vec normal[3] = {
+        SimdOps::Sub(SimdOps::Mul(a[1], b[2]), SimdOps::Mul(a[2], b[1])),
+        SimdOps::Sub(SimdOps::Mul(a[2], b[0]), SimdOps::Mul(a[0], b[2])),
+        SimdOps::Sub(SimdOps::Mul(a[0], b[1]), SimdOps::Mul(a[1], b[0])),
+    };
+    if (weighting == NormalWeighting::kUnweighted) {
+      // Degenerate triangles keep their zero normal.
+      const Vec magnitude = SimdOps::Max(
+          SimdOps::Sqrt(SimdOps::Add(
+              SimdOps::Add(SimdOps::Mul(normal[0], normal[0]),
+                           SimdOps::Mul(normal[1], normal[1])),
+              SimdOps::Mul(normal[2], normal[2]))),
+          min_magnitude);
+      for (int axis = 0; axis < 3; ++axis) {
+        normal[axis] = SimdOps::Div(normal[axis], magnitude);
+      }
+    }
+    float face_normals[3][kLanes];
+    for (int axis = 0; axis < 3; ++axis) {
+      SimdOps::Store(face_normals[axis], normal[axis]);
+    }
+
+    for (int lane = 0; lane < kLanes; ++lane) {
+      const float face_normal[3] = {face_normals[0][lane],
+                                    face_normals[1][lane],
+                                    face_normals[2][lane]};
+      for (int corner = 0; corner < 3; ++corner) {
+        AddToVertexNormal(mesh, indices[(triangle + lane) * 3 + corner],
+                          face_normal);
+      }
+    }
+  }
+#endif
+
+  for (; triangle < triangle_count; ++triangle) {
+    const uint16* triangle_indices = indices + triangle * 3;
+    const float* v1 = mesh.positions + triangle_indices[0] * mesh.vertex_stride;
+    const float* v2 = mesh.positions + triangle_indices[1] * mesh.vertex_stride;
+    const float* v3 = mesh.positions + triangle_indices[2] * mesh.vertex_stride;
+    // V2 - V1
+    const float ax = v2[0] - v1[0];
+    const float ay = v2[1] - v1[1];
+    const float az = v2[2] - v1[2];
+    // V3 - V1
+    const float bx = v3[0] - v1[0];
+    const float by = v3[1] - v1[1];
+    const float bz = v3[2] - v1[2];
+    // Cross product
+    float face_normal[3] = {ay * bz - az * by, az * bx - ax * bz,
+                            ax * by - ay * bx};
+    if (weighting == NormalWeighting::kUnweighted) {
+      const float magnitude = std::max(
+          std::sqrt(face_normal[0] * face_normal[0] +
+                    face_normal[1] * face_normal[1] +
+                    face_normal[2] * face_normal[2]),
+          FLT_MIN);
+      face_normal[0] /= magnitude;
+      face_normal[1] /= magnitude;
+      face_normal[2] /= magnitude;
+    }
+    for (int corner = 0; corner < 3; ++corner) {
+      AddToVertexNormal(mesh, triangle_indices[corner], face_normal);
+    }
+  }
+}
+
+}  // namespace
+
+void ComputeVertexNormals(const TriangleMeshView& mesh,
+                          NormalWeighting weighting) {
+  // Accumulate the normal sums directly in the output, which needs no scratch
+  // memory besides a few registers' worth of stack per triangle batch.
+  for (int i = 0; i < mesh.vertex_count; ++i) {
+    float* normal = mesh.normals + i * mesh.vertex_stride;
+    normal[0] = 0.0f;
+    normal[1] = 0.0f;
+    normal[2] = 0.0f;
+  }
+
+  AccumulateFaceNormals(mesh, weighting);
+
+  for (int i = 0; i < mesh.vertex_count; ++i) {
+    float* normal = mesh.normals + i * mesh.vertex_stride;
+    const float magnitude = std::sqrt(normal[0] * normal[0] +
+                                      normal[1] * normal[1] +
+                                      normal[2] * normal[2]);
+    if (magnitude > 0.0f) {
+      normal[0] /= magnitude;
+      normal[1] /= magnitude;
+      normal[2] /= magnitude;
+    }
+  }
+}
+
+void ComputeVertexNormals(const std::vector<TriangleMeshView>& meshes,
+                          NormalWeighting weighting, int num_threads) {
+  const int mesh_count = meshes.size();
+  num_threads = std::min(num_threads, mesh_count);
+  if (num_threads <= 1) {
+    for (const TriangleMeshView& mesh : meshes) {
+      ComputeVertexNormals(mesh, weighting);
+    }
+    return;
+  }
+
+  // Meshes are handed out in contiguous runs, one per thread, which keeps
+  // scheduling overhead negligible next to the per-mesh work.
+  ThreadPool thread_pool("mesh_normals", num_threads);
+  thread_pool.StartWorkers();
+  const int meshes_per_thread = (mesh_count + num_threads - 1) / num_threads;
+  for (int begin = 0; begin < mesh_count; begin += meshes_per_thread) {
+    const int end = std::min(begin + meshes_per_thread, mesh_count);
+    thread_pool.Schedule([&meshes, weighting, begin, end]() {
+      for (int i = begin; i < end; ++i) {
+        ComputeVertexNormals(meshes[i], weighting);
+      }
+    });
+  }
+  // The ThreadPool destructor waits for all scheduled work to finish.
+}
+
+}  // namespace mediapipe
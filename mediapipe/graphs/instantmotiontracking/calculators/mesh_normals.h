@@ -0,0 +1,65 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_MESH_NORMALS_H_
+#define MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_MESH_NORMALS_H_
+
+#include <vector>
+
+#include "mediapipe/framework/port/integral_types.h"
+
+namespace mediapipe {
+
+// How the face normals of the triangles sharing a vertex are combined.
+enum class NormalWeighting {
+  // Face normals are summed as they are, so larger triangles contribute
+  // proportionally more to the vertex normal.
+  kArea,
+  // Face normals are normalized before summing, so every triangle contributes
+  // equally.
+  kUnweighted,
+};
+
+// Strided view of an indexed triangle mesh. Positions and normals may be
+// separate packed arrays, or share an interleaved vertex array.
+struct TriangleMeshView {
+  // x, y, z of the first vertex
+  const float* positions = nullptr;
+  // Output x, y, z of the first vertex
+  float* normals = nullptr;
+  int vertex_count = 0;
+  // Number of floats between consecutive positions, and between consecutive
+  // normals
+  int vertex_stride = 3;
+  // Three vertex indices per triangle, all smaller than vertex_count
+  const uint16* indices = nullptr;
+  int index_count = 0;
+};
+
+// Computes smooth per-vertex normals for mesh. Every vertex normal is the
+// normalized sum of the face normals of all triangles sharing that vertex.
+// Vertices not used by any triangle get a zero normal. Uses SSE2 or NEON for
+// the face normals when available at compile time.
+void ComputeVertexNormals(const TriangleMeshView& mesh,
+                          NormalWeighting weighting);
+
+// Runs ComputeVertexNormals for every mesh, such as all frames of an
+// animation, distributing the meshes over num_threads threads. Meshes must not
+// share any normals.
+void ComputeVertexNormals(const std::vector<TriangleMeshView>& meshes,
+                          NormalWeighting weighting, int num_threads);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_MESH_NORMALS_H_
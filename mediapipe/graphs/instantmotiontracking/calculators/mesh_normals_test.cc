@@ -0,0 +1,238 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/graphs/instantmotiontracking/calculators/mesh_normals.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/integral_types.h"
+
+namespace mediapipe {
+namespace {
+
+// Interleaved vertices as in animation assets: position, two texture
+// coordinates, normal
+constexpr int kStride = 8;
+constexpr int kNormalOffset = 5;
+// Marks floats that must not be written
+constexpr float kUntouched = -7.0f;
+
+struct TestMesh {
+  std::vector<float> vertices;
+  std::vector<uint16> indices;
+
+  int vertex_count() const { return vertices.size() / kStride; }
+  const float* normal(int i) const {
+    return &vertices[i * kStride + kNormalOffset];
+  }
+
+  void AddVertex(float x, float y, float z) {
+    const float vertex[kStride] = {x,          y,          z,
+                                   kUntouched, kUntouched, kUntouched,
+                                   kUntouched, kUntouched};
+    vertices.insert(vertices.end(), vertex, vertex + kStride);
+  }
+
+  TriangleMeshView View() {
+    TriangleMeshView view;
+    view.positions = vertices.data();
+    view.normals = vertices.data() + kNormalOffset;
+    view.vertex_count = vertex_count();
+    view.vertex_stride = kStride;
+    view.indices = indices.data();
+    view.index_count = indices.size();
+    return view;
+  }
+};
+
+// Slightly bumpy grid of size x size vertices facing +z, truncated to
+// triangle_count triangles, so that no vertex normal is close to zero.
+TestMesh MakeGridMesh(int size, int triangle_count, uint32 seed) {
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<float> bump(-0.3f, 0.3f);
+  TestMesh mesh;
+  for (int y = 0; y < size; ++y) {
+    for (int x = 0; x < size; ++x) {
+      mesh.AddVertex(x + bump(random), y + bump(random), bump(random));
+    }
+  }
+  for (int y = 0; y + 1 < size; ++y) {
+    for (int x = 0; x + 1 < size; ++x) {
+      const uint16 corner = y * size + x;
+      const uint16 triangles[6] = {
+          corner, static_cast<uint16>(corner + 1),
+          static_cast<uint16>(corner + size),
+          static_cast<uint16>(corner + 1),
+          static_cast<uint16>(corner + size + 1),
+          static_cast<uint16>(corner + size)};
+      mesh.indices.insert(mesh.indices.end(), triangles, triangles + 6);
+    }
+  }
+  mesh.indices.resize(triangle_count * 3);
+  return mesh;
+}
+
+// Straightforward double precision version of ComputeVertexNormals
+std::vector<double> ReferenceNormals(const TestMesh& mesh,
+                                     NormalWeighting weighting) {
+  std::vector<double> normals(mesh.vertex_count() * 3, 0.0);
+  for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+    const float* v[3];
+    for (int corner = 0; corner < 3; ++corner) {
+      v[corner] = &mesh.vertices[mesh.indices[i + corner] * kStride];
+    }
+    double a[3];
+    double b[3];
+    for (int axis = 0; axis < 3; ++axis) {
+      a[axis] = double{v[1][axis]} - v[0][axis];
+      b[axis] = double{v[2][axis]} - v[0][axis];
+    }
+    double face_normal[3] = {a[1] * b[2] - a[2] * b[1],
+                             a[2] * b[0] - a[0] * b[2],
+                             a[0] * b[1] - a[1] * b[0]};
+    if (weighting == NormalWeighting::kUnweighted) {
+      const double magnitude =
+          std::sqrt(face_normal[0] * face_normal[0] +
+                    face_normal[1] * face_normal[1] +
+                    face_normal[2] * face_normal[2]);
+      for (double& value : face_normal) {
+        value /= magnitude;
+      }
+    }
+    for (int corner = 0; corner < 3; ++corner) {
+      for (int axis = 0; axis < 3; ++axis) {
+        normals[mesh.indices[i + corner] * 3 + axis] += face_normal[axis];
+      }
+    }
+  }
+  for (int i = 0; i < mesh.vertex_count(); ++i) {
+    double* normal = &normals[i * 3];
+    const double magnitude = std::sqrt(
+        normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+    if (magnitude > 0.0) {
+      for (int axis = 0; axis < 3; ++axis) {
+        normal[axis] /= magnitude;
+      }
+    }
+  }
+  return normals;
+}
+
+TEST(MeshNormalsTest, SingleTriangleFacesItsWindingDirection) {
+  TestMesh mesh;
+  mesh.AddVertex(0.0f, 0.0f, 0.0f);
+  mesh.AddVertex(2.0f, 0.0f, 0.0f);
+  mesh.AddVertex(0.0f, 2.0f, 0.0f);
+  mesh.indices = {0, 1, 2};
+  ComputeVertexNormals(mesh.View(), NormalWeighting::kArea);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(mesh.normal(i)[0], 0.0f);
+    EXPECT_EQ(mesh.normal(i)[1], 0.0f);
+    EXPECT_EQ(mesh.normal(i)[2], 1.0f);
+  }
+}
+
+TEST(MeshNormalsTest, WeightingCombinesFacesAsDocumented) {
+  // Vertex 0 is shared by a large triangle facing +z and a small one facing
+  // +y, whose face normals have magnitudes 16 and 1.
+  TestMesh mesh;
+  mesh.AddVertex(0.0f, 0.0f, 0.0f);
+  mesh.AddVertex(4.0f, 0.0f, 0.0f);
+  mesh.AddVertex(0.0f, 4.0f, 0.0f);
+  mesh.AddVertex(0.0f, 0.0f, 1.0f);
+  mesh.AddVertex(1.0f, 0.0f, 0.0f);
+  mesh.indices = {0, 1, 2, 0, 3, 4};
+
+  ComputeVertexNormals(mesh.View(), NormalWeighting::kArea);
+  const float area_magnitude = std::sqrt(16.0f * 16.0f + 1.0f);
+  EXPECT_FLOAT_EQ(mesh.normal(0)[0], 0.0f);
+  EXPECT_FLOAT_EQ(mesh.normal(0)[1], 1.0f / area_magnitude);
+  EXPECT_FLOAT_EQ(mesh.normal(0)[2], 16.0f / area_magnitude);
+
+  ComputeVertexNormals(mesh.View(), NormalWeighting::kUnweighted);
+  EXPECT_FLOAT_EQ(mesh.normal(0)[0], 0.0f);
+  EXPECT_FLOAT_EQ(mesh.normal(0)[1], std::sqrt(0.5f));
+  EXPECT_FLOAT_EQ(mesh.normal(0)[2], std::sqrt(0.5f));
+}
+
+TEST(MeshNormalsTest, UnusedAndDegenerateVerticesGetZeroNormals) {
+  TestMesh mesh;
+  // A degenerate triangle, all of whose corners lie on a line
+  mesh.AddVertex(0.0f, 0.0f, 0.0f);
+  mesh.AddVertex(1.0f, 1.0f, 1.0f);
+  mesh.AddVertex(2.0f, 2.0f, 2.0f);
+  // Used by no triangle
+  mesh.AddVertex(5.0f, 0.0f, 0.0f);
+  mesh.indices = {0, 1, 2};
+  for (const NormalWeighting weighting :
+       {NormalWeighting::kArea, NormalWeighting::kUnweighted}) {
+    ComputeVertexNormals(mesh.View(), weighting);
+    for (int i = 0; i < mesh.vertex_count(); ++i) {
+      for (int axis = 0; axis < 3; ++axis) {
+        EXPECT_EQ(mesh.normal(i)[axis], 0.0f) << "vertex " << i;
+      }
+    }
+  }
+}
+
+TEST(MeshNormalsTest, MatchesReference) {
+  // Triangle counts covering the vector loop, its scalar remainder, and both
+  const int kTriangleCounts[] = {1, 2, 3, 4, 5, 7, 8, 9, 100, 242};
+  for (const NormalWeighting weighting :
+       {NormalWeighting::kArea, NormalWeighting::kUnweighted}) {
+    for (const int triangle_count : kTriangleCounts) {
+      TestMesh mesh = MakeGridMesh(12, triangle_count, triangle_count);
+      const std::vector<double> expected = ReferenceNormals(mesh, weighting);
+      ComputeVertexNormals(mesh.View(), weighting);
+      for (int i = 0; i < mesh.vertex_count(); ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+          EXPECT_NEAR(mesh.normal(i)[axis], expected[i * 3 + axis], 1e-5)
+              << "weighting " << static_cast<int>(weighting) << ", "
+              << triangle_count << " triangles, vertex " << i << ", axis "
+              << axis;
+        }
+        // Positions and texture coordinates are left alone
+        EXPECT_EQ(mesh.vertices[i * kStride + 3], kUntouched);
+        EXPECT_EQ(mesh.vertices[i * kStride + 4], kUntouched);
+      }
+    }
+  }
+}
+
+TEST(MeshNormalsTest, ParallelMatchesSerial) {
+  constexpr int kMeshCount = 11;
+  std::vector<TestMesh> serial_meshes;
+  std::vector<TestMesh> parallel_meshes;
+  for (int i = 0; i < kMeshCount; ++i) {
+    serial_meshes.push_back(MakeGridMesh(8 + i, 2 * (7 + i) * (7 + i), i));
+  }
+  parallel_meshes = serial_meshes;
+
+  std::vector<TriangleMeshView> views;
+  for (int i = 0; i < kMeshCount; ++i) {
+    ComputeVertexNormals(serial_meshes[i].View(), NormalWeighting::kArea);
+    views.push_back(parallel_meshes[i].View());
+  }
+  ComputeVertexNormals(views, NormalWeighting::kArea, /*num_threads=*/4);
+  for (int i = 0; i < kMeshCount; ++i) {
+    EXPECT_EQ(parallel_meshes[i].vertices, serial_meshes[i].vertices)
+        << "mesh " << i;
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
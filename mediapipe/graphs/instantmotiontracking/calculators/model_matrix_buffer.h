@@ -0,0 +1,47 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_MODEL_MATRIX_BUFFER_H_
+#define MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_MODEL_MATRIX_BUFFER_H_
+
+#include <vector>
+
+#include "Eigen/Core"
+
+namespace mediapipe {
+
+// Number of floats in a single 4x4 model matrix
+constexpr int kModelMatrixSize = 16;
+
+// Contiguous list of column-major 4x4 model matrices together with the sticker
+// id of each matrix. Unlike TimedModelMatrixProtoList, the matrices can be
+// uploaded to OpenGL directly (e.g. as uniforms or instanced attributes).
+struct ModelMatrixBuffer {
+  // size() * kModelMatrixSize floats, aligned for SIMD access
+  std::vector<float, Eigen::aligned_allocator<float>> matrices;
+  std::vector<int> ids;
+
+  int size() const { return ids.size(); }
+  bool empty() const { return ids.empty(); }
+  void Resize(int count) {
+    matrices.resize(count * kModelMatrixSize);
+    ids.resize(count);
+  }
+  const float* matrix(int i) const { return &matrices[i * kModelMatrixSize]; }
+  float* mutable_matrix(int i) { return &matrices[i * kModelMatrixSize]; }
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_MODEL_MATRIX_BUFFER_H_
@@ -0,0 +1,216 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/graphs/instantmotiontracking/calculators/model_matrix_kernel.h"
+
+#include "mediapipe/graphs/instantmotiontracking/calculators/model_matrix_kernel_simd.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+namespace mediapipe {
+
+// Every sticker's model matrix is
+//
+//   | B * Ry(theta) * S   t |
+//   | 0                   1 |
+//
+// where B is the per-frame base rotation, Ry(theta) the user rotation around
+// the y-axis and S the diagonal scaling. Expanding B * Ry(theta) column-wise
+// gives (c * B0 - s * B2, B1, s * B0 + c * B2), so each matrix costs a handful
+// of multiply-adds with no per-sticker temporaries.
+
+void ModelMatrixBatch::Clear() {
+  sticker_id.clear();
+  anchor_x.clear();
+  anchor_y.clear();
+  anchor_z.clear();
+  cos_rotation.clear();
+  sin_rotation.clear();
+  scale_x.clear();
+  scale_y.clear();
+  scale_z.clear();
+}
+
+void ModelMatrixBatch::Add(int id, float x, float y, float z,
+                           float cos_rotation_value, float sin_rotation_value,
+                           float scale_x_value, float scale_y_value,
+                           float scale_z_value) {
+  sticker_id.push_back(id);
+  anchor_x.push_back(x);
+  anchor_y.push_back(y);
+  anchor_z.push_back(z);
+  cos_rotation.push_back(cos_rotation_value);
+  sin_rotation.push_back(sin_rotation_value);
+  scale_x.push_back(scale_x_value);
+  scale_y.push_back(scale_y_value);
+  scale_z.push_back(scale_z_value);
+}
+
+void ComputeModelMatricesReference(const ModelMatrixFrame& frame,
+                                   const ModelMatrixBatch& batch, int begin,
+                                   int end, float* model_matrices) {
+  const float* b = frame.base_rotation;
+  for (int i = begin; i < end; ++i) {
+    const float c = batch.cos_rotation[i];
+    const float s = batch.sin_rotation[i];
+    const float sx = batch.scale_x[i];
+    const float sy = batch.scale_y[i];
+    const float sz = batch.scale_z[i];
+    const float z = batch.anchor_z[i];
+    float* m = model_matrices + i * kModelMatrixSize;
+    for (int row = 0; row < 3; ++row) {
+      m[row] = (c * b[row] - s * b[6 + row]) * sx;
+      m[4 + row] = b[3 + row] * sy;
+      m[8 + row] = (s * b[row] + c * b[6 + row]) * sz;
+    }
+    m[3] = 0.0f;
+    m[7] = 0.0f;
+    m[11] = 0.0f;
+    m[12] = z * frame.translation_scale[0] * (1.0f - 2.0f * batch.anchor_x[i]);
+    m[13] = z * frame.translation_scale[1] * (1.0f - 2.0f * batch.anchor_y[i]);
+    m[14] = z * frame.translation_scale[2];
+    m[15] = 1.0f;
+  }
+}
+
+namespace {
+
+using model_matrix_kernel_internal::BatchView;
+
+#if defined(__SSE2__)
+struct Sse2Ops {
+  using Vec = __m128;
+  static constexpr int kLanes = 4;
+  static Vec Load(const float* p) { return _mm_loadu_ps(p); }
+  static Vec Splat(float v) { return _mm_set1_ps(v); }
+  static Vec Add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+  static Vec Sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+  static Vec Mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+  // Writes the 4 lanes of column (a, b, c, d) into consecutive matrices
+  static void StoreColumn(Vec a, Vec b, Vec c, Vec d, float* out) {
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+    _mm_storeu_ps(out, a);
+    _mm_storeu_ps(out + kModelMatrixSize, b);
+    _mm_storeu_ps(out + 2 * kModelMatrixSize, c);
+    _mm_storeu_ps(out + 3 * kModelMatrixSize, d);
+  }
+};
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+struct NeonOps {
+  using Vec = float32x4_t;
+  static constexpr int kLanes = 4;
+  static Vec Load(const float* p) { return vld1q_f32(p); }
+  static Vec Splat(float v) { return vdupq_n_f32(v); }
+  static Vec Add(Vec a, Vec b) { return vaddq_f32(a, b); }
+  static Vec Sub(Vec a, Vec b) { return vsubq_f32(a, b); }
+  static Vec Mul(Vec a, Vec b) { return vmulq_f32(a, b); }
+  static void StoreColumn(Vec a, Vec b, Vec c, Vec d, float* out) {
+    const float32x4x2_t ab = vtrnq_f32(a, b);
+    const float32x4x2_t cd = vtrnq_f32(c, d);
+    vst1q_f32(out, vcombine_f32(vget_low_f32(ab.val[0]),
+                                vget_low_f32(cd.val[0])));
+    vst1q_f32(out + kModelMatrixSize,
+              vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1])));
+    vst1q_f32(out + 2 * kModelMatrixSize,
+              vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0])));
+    vst1q_f32(out + 3 * kModelMatrixSize,
+              vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1])));
+  }
+};
+#endif
+
+// Whether the CPU running this binary supports AVX, including its support by
+// the operating system
+bool CpuSupportsAvx() {
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+  return __builtin_cpu_supports("avx");
+#else
+  return false;
+#endif
+}
+
+BatchView MakeBatchView(const ModelMatrixBatch& batch) {
+  BatchView view;
+  view.anchor_x = batch.anchor_x.data();
+  view.anchor_y = batch.anchor_y.data();
+  view.anchor_z = batch.anchor_z.data();
+  view.cos_rotation = batch.cos_rotation.data();
+  view.sin_rotation = batch.sin_rotation.data();
+  view.scale_x = batch.scale_x.data();
+  view.scale_y = batch.scale_y.data();
+  view.scale_z = batch.scale_z.data();
+  view.size = batch.size();
+  return view;
+}
+
+}  // namespace
+
+std::vector<ModelMatrixKernel> GetSupportedModelMatrixKernels() {
+  std::vector<ModelMatrixKernel> kernels;
+  if (model_matrix_kernel_internal::IsAvxKernelCompiled() && CpuSupportsAvx()) {
+    kernels.push_back(ModelMatrixKernel::kAvx);
+  }
+#if defined(__SSE2__)
+  kernels.push_back(ModelMatrixKernel::kSse2);
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  kernels.push_back(ModelMatrixKernel::kNeon);
+#endif
+  kernels.push_back(ModelMatrixKernel::kReference);
+  return kernels;
+}
+
+void ComputeModelMatrices(ModelMatrixKernel kernel,
+                          const ModelMatrixFrame& frame,
+                          const ModelMatrixBatch& batch,
+                          float* model_matrices) {
+  const BatchView view = MakeBatchView(batch);
+  int begin = 0;
+  switch (kernel) {
+    case ModelMatrixKernel::kAvx:
+      begin = model_matrix_kernel_internal::ComputeModelMatricesAvx(
+          frame, view, model_matrices);
+      break;
+#if defined(__SSE2__)
+    case ModelMatrixKernel::kSse2:
+      begin = model_matrix_kernel_internal::ComputeModelMatricesSimd<Sse2Ops>(
+          frame, view, model_matrices);
+      break;
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    case ModelMatrixKernel::kNeon:
+      begin = model_matrix_kernel_internal::ComputeModelMatricesSimd<NeonOps>(
+          frame, view, model_matrices);
+      break;
+#endif
+    default:
+      break;
+  }
+  ComputeModelMatricesReference(frame, batch, begin, batch.size(),
+                                model_matrices);
+}
+
+void ComputeModelMatrices(const ModelMatrixFrame& frame,
+                          const ModelMatrixBatch& batch,
+                          float* model_matrices) {
+  // The CPU is only inspected once, on the first call
+  static const ModelMatrixKernel kernel =
+      GetSupportedModelMatrixKernels().front();
+  ComputeModelMatrices(kernel, frame, batch, model_matrices);
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,96 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_MODEL_MATRIX_KERNEL_H_
+#define MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_MODEL_MATRIX_KERNEL_H_
+
+#include <vector>
+
+#include "mediapipe/graphs/instantmotiontracking/calculators/model_matrix_buffer.h"
+
+namespace mediapipe {
+
+// Transformation data shared by every sticker in a single frame.
+struct ModelMatrixFrame {
+  // Column-major 3x3 rotation applied after each sticker's own rotation. This
+  // is the device IMU rotation concatenated with the constant pre-rotation that
+  // turns the z-up model orientation into a y-up orientation.
+  float base_rotation[9];
+  // Multipliers converting a normalized anchor into OpenGL coordinate space:
+  //   x = anchor.z * translation_scale[0] * (1 - 2 * anchor.x)
+  //   y = anchor.z * translation_scale[1] * (1 - 2 * anchor.y)
+  //   z = anchor.z * translation_scale[2]
+  float translation_scale[3];
+};
+
+// Structure-of-arrays storage of the per-sticker data required to build model
+// matrices. All arrays always have the same length.
+struct ModelMatrixBatch {
+  std::vector<int> sticker_id;
+  // Normalized anchor coordinates
+  std::vector<float> anchor_x;
+  std::vector<float> anchor_y;
+  std::vector<float> anchor_z;
+  // Cosine and sine of the user rotation around the model's y-axis
+  std::vector<float> cos_rotation;
+  std::vector<float> sin_rotation;
+  // Combined render preset and user scaling on each model axis
+  std::vector<float> scale_x;
+  std::vector<float> scale_y;
+  std::vector<float> scale_z;
+
+  int size() const { return sticker_id.size(); }
+  // Removes all stickers while keeping the allocated storage
+  void Clear();
+  void Add(int id, float x, float y, float z, float cos_rotation_value,
+           float sin_rotation_value, float scale_x_value, float scale_y_value,
+           float scale_z_value);
+};
+
+// Instruction sets that model matrices can be computed with
+enum class ModelMatrixKernel {
+  kReference,
+  kSse2,
+  kAvx,
+  kNeon,
+};
+
+// Returns the kernels that this binary can run on the current CPU, widest
+// first. kReference is always supported. AVX is detected at runtime, while
+// SSE2 and NEON are supported whenever the binary is built with them.
+std::vector<ModelMatrixKernel> GetSupportedModelMatrixKernels();
+
+// Computes a column-major model matrix for every sticker in the batch, writing
+// batch.size() * kModelMatrixSize floats to model_matrices. Uses the widest
+// kernel supported and falls back to ComputeModelMatricesReference for any
+// remaining stickers.
+void ComputeModelMatrices(const ModelMatrixFrame& frame,
+                          const ModelMatrixBatch& batch,
+                          float* model_matrices);
+
+// Same as above, with a kernel from GetSupportedModelMatrixKernels()
+void ComputeModelMatrices(ModelMatrixKernel kernel,
+                          const ModelMatrixFrame& frame,
+                          const ModelMatrixBatch& batch,
+                          float* model_matrices);
+
+// Scalar implementation of ComputeModelMatrices for the stickers in
+// [begin, end), used as the reference for the vectorized kernels.
+void ComputeModelMatricesReference(const ModelMatrixFrame& frame,
+                                   const ModelMatrixBatch& batch, int begin,
+                                   int end, float* model_matrices);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_MODEL_MATRIX_KERNEL_H_
@@ -0,0 +1,79 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// AVX model matrix kernel. This file is compiled with AVX enabled on x86, and
+// is only called once the CPU has been checked for AVX support.
+
+#include "mediapipe/graphs/instantmotiontracking/calculators/model_matrix_kernel_simd.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace mediapipe {
+namespace model_matrix_kernel_internal {
+
+#if defined(__AVX__)
+namespace {
+
+inline void StoreTransposed(__m128 a, __m128 b, __m128 c, __m128 d,
+                            float* out) {
+  _MM_TRANSPOSE4_PS(a, b, c, d);
+  _mm_storeu_ps(out, a);
+  _mm_storeu_ps(out + kModelMatrixSize, b);
+  _mm_storeu_ps(out + 2 * kModelMatrixSize, c);
+  _mm_storeu_ps(out + 3 * kModelMatrixSize, d);
+}
+
+struct AvxOps {
+  using Vec = __m256;
+  static constexpr int kLanes = 8;
+  static Vec Load(const float* p) { return _mm256_loadu_ps(p); }
+  static Vec Splat(float v) { return _mm256_set1_ps(v); }
+  static Vec Add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+  static Vec Sub(Vec a, Vec b) { return _mm256_sub_ps(a, b); }
+  static Vec Mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+  // Writes the 8 lanes of column (a, b, c, d) into consecutive matrices
+  static void StoreColumn(Vec a, Vec b, Vec c, Vec d, float* out) {
+    StoreTransposed(_mm256_castps256_ps128(a), _mm256_castps256_ps128(b),
+                    _mm256_castps256_ps128(c), _mm256_castps256_ps128(d), out);
+    StoreTransposed(_mm256_extractf128_ps(a, 1), _mm256_extractf128_ps(b, 1),
+                    _mm256_extractf128_ps(c, 1), _mm256_extractf128_ps(d, 1),
+                    out + 4 * kModelMatrixSize);
+  }
+};
+
+}  // namespace
+
+int ComputeModelMatricesAvx(const ModelMatrixFrame& frame,
+                            const BatchView& batch, float* model_matrices) {
+  return ComputeModelMatricesSimd<AvxOps>(frame, batch, model_matrices);
+}
+
+bool IsAvxKernelCompiled() { return true; }
+
+#else
+
+int ComputeModelMatricesAvx(const ModelMatrixFrame& /*frame*/,
+                            const BatchView& /*batch*/,
+                            float* /*model_matrices*/) {
+  return 0;
+}
+
+bool IsAvxKernelCompiled() { return false; }
+
+#endif
+
+}  // namespace model_matrix_kernel_internal
+}  // namespace mediapipe
@@ -0,0 +1,83 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Measures the time to compute the model matrices of a frame against the
+// number of stickers, for every kernel supported by the CPU. Usage:
+//   bazel run -c opt //mediapipe/graphs/instantmotiontracking/calculators:model_matrix_kernel_benchmark
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/model_matrix_kernel.h"
+
+namespace mediapipe {
+namespace {
+
+const char* KernelName(ModelMatrixKernel kernel) {
+  switch (kernel) {
+    case ModelMatrixKernel::kReference:
+      return "Reference";
+    case ModelMatrixKernel::kSse2:
+      return "SSE2";
+    case ModelMatrixKernel::kAvx:
+      return "AVX";
+    case ModelMatrixKernel::kNeon:
+      return "NEON";
+  }
+  return "Unknown";
+}
+
+void BM_ComputeModelMatrices(benchmark::State& state,
+                             ModelMatrixKernel kernel) {
+  ModelMatrixFrame frame;
+  for (int i = 0; i < 9; ++i) {
+    frame.base_rotation[i] = (i % 4 == 0) ? 1.0f : 0.0f;
+  }
+  frame.translation_scale[0] = -5.2f;
+  frame.translation_scale[1] = -6.9f;
+  frame.translation_scale[2] = -10.0f;
+
+  const int num_stickers = state.range(0);
+  ModelMatrixBatch batch;
+  for (int i = 0; i < num_stickers; ++i) {
+    const float t = static_cast<float>(i) / num_stickers;
+    batch.Add(i, t, 1.0f - t, 1.0f + t, std::cos(t), std::sin(t), 5.0f, 5.0f,
+              5.0f);
+  }
+  std::vector<float> model_matrices(num_stickers * kModelMatrixSize);
+
+  for (auto _ : state) {
+    ComputeModelMatrices(kernel, frame, batch, model_matrices.data());
+    benchmark::DoNotOptimize(model_matrices.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * num_stickers);
+}
+
+// Registered at startup, as the kernels available depend on the CPU
+const bool kRegistered = [] {
+  for (const ModelMatrixKernel kernel : GetSupportedModelMatrixKernels()) {
+    benchmark::RegisterBenchmark(
+        (std::string("BM_ComputeModelMatrices/") + KernelName(kernel)).c_str(),
+        BM_ComputeModelMatrices, kernel)
+        ->RangeMultiplier(4)
+        ->Range(1, 4096);
+  }
+  return true;
+}();
+
+}  // namespace
+}  // namespace mediapipe
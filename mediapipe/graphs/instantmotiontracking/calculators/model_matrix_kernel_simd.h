@@ -0,0 +1,107 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Vectorized model matrix kernel shared by every instruction set. Only meant
+// to be included by the model_matrix_kernel translation units.
+
+#ifndef MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_MODEL_MATRIX_KERNEL_SIMD_H_
+#define MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_MODEL_MATRIX_KERNEL_SIMD_H_
+
+#include "mediapipe/graphs/instantmotiontracking/calculators/model_matrix_kernel.h"
+
+namespace mediapipe {
+namespace model_matrix_kernel_internal {
+
+// Raw view of a ModelMatrixBatch. Kernels built with wider instruction sets
+// than the rest of the binary only see these pointers, so that no inline
+// library code is ever instantiated with those instruction sets.
+struct BatchView {
+  const float* anchor_x;
+  const float* anchor_y;
+  const float* anchor_z;
+  const float* cos_rotation;
+  const float* sin_rotation;
+  const float* scale_x;
+  const float* scale_y;
+  const float* scale_z;
+  int size;
+};
+
+// Computes Ops::kLanes model matrices per iteration, returning the index of the
+// first sticker that has not been processed. Ops wraps the vector type and
+// intrinsics of one instruction set.
+template <typename Ops>
+inline int ComputeModelMatricesSimd(const ModelMatrixFrame& frame,
+                                    const BatchView& batch,
+                                    float* model_matrices) {
+  using Vec = typename Ops::Vec;
+  constexpr int kLanes = Ops::kLanes;
+  const float* b = frame.base_rotation;
+  Vec base[9];
+  for (int i = 0; i < 9; ++i) {
+    base[i] = Ops::Splat(b[i]);
+  }
+  const Vec zero = Ops::Splat(0.0f);
+  const Vec one = Ops::Splat(1.0f);
+  const Vec two = Ops::Splat(2.0f);
+  const Vec translation_x = Ops::Splat(frame.translation_scale[0]);
+  const Vec translation_y = Ops::Splat(frame.translation_scale[1]);
+  const Vec translation_z = Ops::Splat(frame.translation_scale[2]);
+
+  int i = 0;
+  for (; i + kLanes <= batch.size; i += kLanes) {
+    const Vec c = Ops::Load(batch.cos_rotation + i);
+    const Vec s = Ops::Load(batch.sin_rotation + i);
+    const Vec sx = Ops::Load(batch.scale_x + i);
+    const Vec sy = Ops::Load(batch.scale_y + i);
+    const Vec sz = Ops::Load(batch.scale_z + i);
+    const Vec z = Ops::Load(batch.anchor_z + i);
+    Vec column[3][3];
+    for (int row = 0; row < 3; ++row) {
+      column[0][row] = Ops::Mul(
+          Ops::Sub(Ops::Mul(c, base[row]), Ops::Mul(s, base[6 + row])), sx);
+      column[1][row] = Ops::Mul(base[3 + row], sy);
+      column[2][row] = Ops::Mul(
+          Ops::Add(Ops::Mul(s, base[row]), Ops::Mul(c, base[6 + row])), sz);
+    }
+    const Vec tx = Ops::Mul(
+        Ops::Mul(z, translation_x),
+        Ops::Sub(one, Ops::Mul(two, Ops::Load(batch.anchor_x + i))));
+    const Vec ty = Ops::Mul(
+        Ops::Mul(z, translation_y),
+        Ops::Sub(one, Ops::Mul(two, Ops::Load(batch.anchor_y + i))));
+    const Vec tz = Ops::Mul(z, translation_z);
+
+    float* out = model_matrices + i * kModelMatrixSize;
+    for (int col = 0; col < 3; ++col) {
+      Ops::StoreColumn(column[col][0], column[col][1], column[col][2], zero,
+                       out + 4 * col);
+    }
+    Ops::StoreColumn(tx, ty, tz, one, out + 12);
+  }
+  return i;
+}
+
+// Defined in model_matrix_kernel_avx.cc, which is the only file compiled with
+// AVX enabled. Returns 0, without computing anything, when AVX was not enabled
+// for that file.
+int ComputeModelMatricesAvx(const ModelMatrixFrame& frame,
+                            const BatchView& batch, float* model_matrices);
+// Whether model_matrix_kernel_avx.cc was compiled with AVX enabled
+bool IsAvxKernelCompiled();
+
+}  // namespace model_matrix_kernel_internal
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_CALCULATORS_MODEL_MATRIX_KERNEL_SIMD_H_
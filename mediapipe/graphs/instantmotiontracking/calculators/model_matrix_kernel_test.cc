@@ -0,0 +1,142 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/graphs/instantmotiontracking/calculators/model_matrix_kernel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+// Frame whose base rotation mixes all axes, so that a mixed up row or column
+// cannot go unnoticed
+ModelMatrixFrame MakeFrame() {
+  ModelMatrixFrame frame;
+  const float base_rotation[9] = {0.36f, 0.48f, -0.8f,   // column 0
+                                  -0.8f, 0.6f,  0.0f,    // column 1
+                                  0.48f, 0.64f, 0.6f};   // column 2
+  std::copy(base_rotation, base_rotation + 9, frame.base_rotation);
+  frame.translation_scale[0] = -5.2f;
+  frame.translation_scale[1] = -6.9f;
+  frame.translation_scale[2] = -10.0f;
+  return frame;
+}
+
+ModelMatrixBatch MakeBatch(int size) {
+  std::mt19937 random(size);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  ModelMatrixBatch batch;
+  for (int i = 0; i < size; ++i) {
+    const float rotation = unit(random) * 6.28f;
+    batch.Add(i, unit(random), unit(random), 0.5f + unit(random),
+              std::cos(rotation), std::sin(rotation),
+              1.0f + 160.0f * unit(random), 1.0f + 160.0f * unit(random),
+              1.0f + 160.0f * unit(random));
+  }
+  return batch;
+}
+
+// Sizes covering empty batches, partial vectors and several full vectors of
+// every kernel width
+const int kBatchSizes[] = {0, 1, 3, 4, 5, 8, 9, 15, 16, 17, 100};
+
+TEST(ModelMatrixKernelTest, ReferenceIsAlwaysSupported) {
+  const std::vector<ModelMatrixKernel> kernels =
+      GetSupportedModelMatrixKernels();
+  ASSERT_FALSE(kernels.empty());
+  EXPECT_EQ(kernels.back(), ModelMatrixKernel::kReference);
+}
+
+TEST(ModelMatrixKernelTest, ReferenceMatchesMatrixProduct) {
+  const ModelMatrixFrame frame = MakeFrame();
+  const ModelMatrixBatch batch = MakeBatch(1);
+  float matrix[kModelMatrixSize];
+  ComputeModelMatricesReference(frame, batch, 0, 1, matrix);
+
+  // B * Ry(theta) * S, with B and the result column-major
+  const float* b = frame.base_rotation;
+  const float c = batch.cos_rotation[0];
+  const float s = batch.sin_rotation[0];
+  const float rotation_y[9] = {c, 0.0f, -s, 0.0f, 1.0f, 0.0f, s, 0.0f, c};
+  const float scale[3] = {batch.scale_x[0], batch.scale_y[0],
+                          batch.scale_z[0]};
+  for (int col = 0; col < 3; ++col) {
+    for (int row = 0; row < 3; ++row) {
+      float expected = 0.0f;
+      for (int k = 0; k < 3; ++k) {
+        expected += b[k * 3 + row] * rotation_y[col * 3 + k];
+      }
+      expected *= scale[col];
+      EXPECT_NEAR(matrix[col * 4 + row], expected, 1e-4f * scale[col])
+          << "row " << row << ", column " << col;
+    }
+    EXPECT_EQ(matrix[col * 4 + 3], 0.0f);
+  }
+  const float z = batch.anchor_z[0];
+  EXPECT_FLOAT_EQ(matrix[12], z * frame.translation_scale[0] *
+                                  (1.0f - 2.0f * batch.anchor_x[0]));
+  EXPECT_FLOAT_EQ(matrix[13], z * frame.translation_scale[1] *
+                                  (1.0f - 2.0f * batch.anchor_y[0]));
+  EXPECT_FLOAT_EQ(matrix[14], z * frame.translation_scale[2]);
+  EXPECT_EQ(matrix[15], 1.0f);
+}
+
+TEST(ModelMatrixKernelTest, EveryKernelMatchesReference) {
+  const ModelMatrixFrame frame = MakeFrame();
+  for (const ModelMatrixKernel kernel : GetSupportedModelMatrixKernels()) {
+    for (const int size : kBatchSizes) {
+      const ModelMatrixBatch batch = MakeBatch(size);
+      std::vector<float> expected(size * kModelMatrixSize);
+      ComputeModelMatricesReference(frame, batch, 0, size, expected.data());
+      // Padding catches writes past the last matrix
+      std::vector<float> actual(size * kModelMatrixSize + kModelMatrixSize,
+                                -1.0f);
+      ComputeModelMatrices(kernel, frame, batch, actual.data());
+      for (int i = 0; i < size * kModelMatrixSize; ++i) {
+        // The same operations in the same order, up to fused multiply-adds
+        EXPECT_NEAR(actual[i], expected[i],
+                    1e-5f * (1.0f + std::abs(expected[i])))
+            << "kernel " << static_cast<int>(kernel) << ", batch size "
+            << size << ", matrix " << i / kModelMatrixSize << ", entry "
+            << i % kModelMatrixSize;
+      }
+      for (size_t i = size * kModelMatrixSize; i < actual.size(); ++i) {
+        EXPECT_EQ(actual[i], -1.0f) << "kernel " << static_cast<int>(kernel)
+                                    << " wrote past batch size " << size;
+      }
+    }
+  }
+}
+
+TEST(ModelMatrixKernelTest, DefaultKernelMatchesReference) {
+  const ModelMatrixFrame frame = MakeFrame();
+  const ModelMatrixBatch batch = MakeBatch(37);
+  std::vector<float> expected(batch.size() * kModelMatrixSize);
+  ComputeModelMatricesReference(frame, batch, 0, batch.size(),
+                                expected.data());
+  std::vector<float> actual(batch.size() * kModelMatrixSize);
+  ComputeModelMatrices(frame, batch, actual.data());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    EXPECT_NEAR(actual[i], expected[i],
+                1e-5f * (1.0f + std::abs(expected[i])));
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
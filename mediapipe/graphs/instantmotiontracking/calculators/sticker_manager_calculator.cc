@@ -12,27 +12,55 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <map>
 #include <vector>
 #include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/logging.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/graphs/instantmotiontracking/calculators/transformations.h"
 #include "mediapipe/graphs/instantmotiontracking/calculators/sticker_buffer.pb.h"
 
 namespace mediapipe {
 
+namespace {
+
+// Returns true if both stickers would produce identical output data
+bool IsSameSticker(const instantmotiontracking::Sticker& a,
+                   const instantmotiontracking::Sticker& b) {
+  return a.id() == b.id() && a.x() == b.x() && a.y() == b.y() &&
+         a.rotation() == b.rotation() && a.scale() == b.scale() &&
+         a.renderid() == b.renderid();
+}
+
+}  // namespace
+
 constexpr char kStringTag[] = "STRING";
 constexpr char kProtoDataString[] = "PROTO";
+constexpr char kDeltaDataString[] = "DELTA";
 constexpr char kAnchorsTag[] = "ANCHORS";
 constexpr char kUserRotationsTag[] = "USER_ROTATIONS";
 constexpr char kUserScalingsTag[] = "USER_SCALINGS";
 constexpr char kRenderDescriptorsTag[] = "RENDER_DATA";
+constexpr char kDeltaResyncsCounter[] = "StickerManagerDeltaResyncs";
+constexpr char kDeltasIgnoredCounter[] = "StickerManagerDeltasIgnored";
 
 // This calculator takes in the sticker protobuffer data and parses each individual
 // sticker object into anchors, user rotations and scalings, in addition to basic
 // render data represented in integer form.
 //
-// Input:
-//  PROTO - String of sticker data in appropriate protobuf format [REQUIRED]
+// The calculator keeps a persistent table of all stickers, which is updated
+// either by a full StickerRoll (PROTO) or by incremental StickerDelta messages
+// (DELTA). Output packets are only emitted when the contents of the table
+// change, so downstream calculators must hold on to the last packet received.
+//
+// A delta out of sequence with the table version (e.g. after a dropped or
+// reordered packet) does not fail the graph: the table is kept as it is, and
+// further deltas are ignored until a full state delta replaces the table.
+//
+// Input (exactly one of the following):
+//  PROTO - String of sticker data in StickerRoll protobuf format
+//  DELTA - String of sticker changes in StickerDelta protobuf format
 // Output:
 //  ANCHORS - Anchors with initial normalized X,Y coordinates [REQUIRED]
 //  USER_ROTATIONS - UserRotations with radians of rotation from user [REQUIRED]
@@ -42,7 +70,7 @@ constexpr char kRenderDescriptorsTag[] = "RENDER_DATA";
 // Example config:
 // node {
 //   calculator: "StickerManagerCalculator"
-//   input_stream: "PROTO:sticker_proto_string"
+//   input_stream: "DELTA:sticker_delta_string"
 //   output_stream: "ANCHORS:initial_anchor_data"
 //   output_stream: "USER_ROTATIONS:user_rotation_data"
 //   output_stream: "USER_SCALINGS:user_scaling_data"
@@ -52,13 +80,19 @@ constexpr char kRenderDescriptorsTag[] = "RENDER_DATA";
 class StickerManagerCalculator : public CalculatorBase {
  public:
   static ::mediapipe::Status GetContract(CalculatorContract* cc) {
-    RET_CHECK(cc->Inputs().HasTag(kProtoDataString));
+    RET_CHECK(cc->Inputs().HasTag(kProtoDataString)
+      != cc->Inputs().HasTag(kDeltaDataString))
+        << "Exactly one of PROTO or DELTA must be provided";
     RET_CHECK(cc->Outputs().HasTag(kAnchorsTag)
       && cc->Outputs().HasTag(kUserRotationsTag)
       && cc->Outputs().HasTag(kUserScalingsTag)
       && cc->Outputs().HasTag(kRenderDescriptorsTag));
 
-    cc->Inputs().Tag(kProtoDataString).Set<std::string>();
+    if (cc->Inputs().HasTag(kProtoDataString)) {
+      cc->Inputs().Tag(kProtoDataString).Set<std::string>();
+    } else {
+      cc->Inputs().Tag(kDeltaDataString).Set<std::string>();
+    }
     cc->Outputs().Tag(kAnchorsTag).Set<std::vector<Anchor>>();
     cc->Outputs().Tag(kUserRotationsTag).Set<std::vector<UserRotation>>();
     cc->Outputs().Tag(kUserScalingsTag).Set<std::vector<UserScaling>>();
@@ -73,27 +107,40 @@ class StickerManagerCalculator : public CalculatorBase {
   }
 
   ::mediapipe::Status Process(CalculatorContext* cc) final {
-    std::string sticker_proto_string =
-      cc->Inputs().Tag(kProtoDataString).Get<std::string>();
+    bool table_changed = false;
+    if (cc->Inputs().HasTag(kProtoDataString)) {
+      MP_RETURN_IF_ERROR(ApplyStickerRoll(
+          cc->Inputs().Tag(kProtoDataString).Get<std::string>(),
+          &table_changed));
+    } else {
+      MP_RETURN_IF_ERROR(ApplyStickerDelta(
+          cc, cc->Inputs().Tag(kDeltaDataString).Get<std::string>(),
+          &table_changed));
+    }
+
+    // The first packet is always emitted so that downstream calculators start
+    // from a defined (possibly empty) sticker set.
+    if (!table_changed && has_emitted_) {
+      return ::mediapipe::OkStatus();
+    }
+    has_emitted_ = true;
 
     std::vector<Anchor> initial_anchor_data;
     std::vector<UserRotation> user_rotation_data;
     std::vector<UserScaling> user_scaling_data;
     std::vector<int> render_data;
+    initial_anchor_data.reserve(sticker_table_.size());
+    user_rotation_data.reserve(sticker_table_.size());
+    user_scaling_data.reserve(sticker_table_.size());
+    render_data.reserve(sticker_table_.size());
 
-    instantmotiontracking::StickerRoll sticker_roll;
-    bool parse_success = sticker_roll.ParseFromString(sticker_proto_string);
-
-    // Ensure parsing was a success
-    RET_CHECK(parse_success) << "Error parsing sticker protobuf data";
-
-    for (int i = 0; i < sticker_roll.sticker().size(); i++) {
+    for (const auto& id_and_sticker : sticker_table_) {
       // Declare empty structures for sticker data
       Anchor initial_anchor;
       UserRotation user_rotation;
       UserScaling user_scaling;
       // Get individual Sticker object as defined by Protobuffer
-      instantmotiontracking::Sticker sticker = sticker_roll.sticker(i);
+      const instantmotiontracking::Sticker& sticker = id_and_sticker.second;
       // Set individual data structure ids to associate with this sticker
       initial_anchor.sticker_id = sticker.id();
       user_rotation.sticker_id = sticker.id();
@@ -103,37 +150,39 @@ class StickerManagerCalculator : public CalculatorBase {
       initial_anchor.z = 1.0f; // default to 1.0 in normalized 3d space
       user_rotation.rotation_radians = sticker.rotation();
       user_scaling.scale_factor = sticker.scale();
-      float render_id = sticker.renderid();
       // Set all vector data with sticker attributes
       initial_anchor_data.emplace_back(initial_anchor);
       user_rotation_data.emplace_back(user_rotation);
       user_scaling_data.emplace_back(user_scaling);
-      render_data.emplace_back(render_id);
+      render_data.emplace_back(sticker.renderid());
     }
 
     if (cc->Outputs().HasTag(kAnchorsTag)) {
       cc->Outputs()
           .Tag(kAnchorsTag)
-          .AddPacket(MakePacket<std::vector<Anchor>>(initial_anchor_data)
+          .AddPacket(MakePacket<std::vector<Anchor>>(
+                         std::move(initial_anchor_data))
                          .At(cc->InputTimestamp()));
     }
     if (cc->Outputs().HasTag(kUserRotationsTag)) {
       cc->Outputs()
           .Tag(kUserRotationsTag)
-          .AddPacket(MakePacket<std::vector<UserRotation>>(user_rotation_data)
+          .AddPacket(MakePacket<std::vector<UserRotation>>(
+                         std::move(user_rotation_data))
                          .At(cc->InputTimestamp()));
     }
     if (cc->Outputs().HasTag(kUserScalingsTag)) {
       cc->Outputs()
           .Tag(kUserScalingsTag)
-          .AddPacket(MakePacket<std::vector<UserScaling>>(user_scaling_data)
+          .AddPacket(MakePacket<std::vector<UserScaling>>(
+                         std::move(user_scaling_data))
                          .At(cc->InputTimestamp()));
     }
     if (cc->Outputs().HasTag(kRenderDescriptorsTag)) {
       cc->Outputs()
           .Tag(kRenderDescriptorsTag)
           .AddPacket(
-              MakePacket<std::vector<int>>(render_data)
+              MakePacket<std::vector<int>>(std::move(render_data))
                   .At(cc->InputTimestamp()));
     }
 
@@ -143,7 +192,141 @@ class StickerManagerCalculator : public CalculatorBase {
   ::mediapipe::Status Close(CalculatorContext* cc) final {
     return ::mediapipe::OkStatus();
   }
+
+ private:
+  // Replaces the sticker table with the contents of a serialized StickerRoll
+  ::mediapipe::Status ApplyStickerRoll(const std::string& sticker_proto_string,
+                                       bool* table_changed);
+  // Applies a serialized StickerDelta to the sticker table
+  ::mediapipe::Status ApplyStickerDelta(CalculatorContext* cc,
+                                        const std::string& sticker_delta_string,
+                                        bool* table_changed);
+  // Replaces the sticker table with the given stickers
+  void ReplaceStickerTable(
+      const google::protobuf::RepeatedPtrField<instantmotiontracking::Sticker>&
+          stickers,
+      bool* table_changed);
+  // Inserts or overwrites a sticker, returning true if the table changed
+  bool UpsertSticker(const instantmotiontracking::Sticker& sticker);
+
+  // All current stickers keyed (and therefore ordered) by sticker id
+  std::map<int, instantmotiontracking::Sticker> sticker_table_;
+  // Last full StickerRoll received, used to skip re-parsing identical data
+  std::string last_sticker_proto_string_;
+  // Version of the sticker table as defined by the last applied StickerDelta
+  int64 table_version_ = 0;
+  // False after a delta out of sequence, until the next full state delta
+  bool table_in_sync_ = true;
+  bool has_emitted_ = false;
 };
 
+::mediapipe::Status StickerManagerCalculator::ApplyStickerRoll(
+    const std::string& sticker_proto_string, bool* table_changed) {
+  // Identical serialized data cannot change the table
+  if (has_emitted_ && sticker_proto_string == last_sticker_proto_string_) {
+    return ::mediapipe::OkStatus();
+  }
+  last_sticker_proto_string_ = sticker_proto_string;
+
+  instantmotiontracking::StickerRoll sticker_roll;
+  bool parse_success = sticker_roll.ParseFromString(sticker_proto_string);
+
+  // Ensure parsing was a success
+  RET_CHECK(parse_success) << "Error parsing sticker protobuf data";
+
+  ReplaceStickerTable(sticker_roll.sticker(), table_changed);
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status StickerManagerCalculator::ApplyStickerDelta(
+    CalculatorContext* cc, const std::string& sticker_delta_string,
+    bool* table_changed) {
+  instantmotiontracking::StickerDelta sticker_delta;
+  bool parse_success = sticker_delta.ParseFromString(sticker_delta_string);
+
+  // Ensure parsing was a success
+  RET_CHECK(parse_success) << "Error parsing sticker delta protobuf data";
+
+  if (sticker_delta.full_state()) {
+    if (!table_in_sync_) {
+      cc->GetCounter(kDeltaResyncsCounter)->Increment();
+    }
+    ReplaceStickerTable(sticker_delta.added(), table_changed);
+    table_version_ = sticker_delta.version();
+    table_in_sync_ = true;
+    return ::mediapipe::OkStatus();
+  }
+
+  // A missing delta would leave the table silently wrong, so the last
+  // consistent table is kept until the next full state instead
+  const bool has_changes = sticker_delta.added_size() > 0 ||
+                           sticker_delta.updated_size() > 0 ||
+                           sticker_delta.removed_id_size() > 0;
+  const int64 expected_version =
+      has_changes ? table_version_ + 1 : table_version_;
+  if (table_in_sync_ && sticker_delta.version() != expected_version) {
+    LOG(WARNING) << "Sticker delta version " << sticker_delta.version()
+                 << " is out of sequence with table version "
+                 << table_version_ << ", waiting for a full state";
+    table_in_sync_ = false;
+  }
+  if (!table_in_sync_) {
+    cc->GetCounter(kDeltasIgnoredCounter)->Increment();
+    return ::mediapipe::OkStatus();
+  }
+  if (!has_changes) {
+    return ::mediapipe::OkStatus();
+  }
+  table_version_ = sticker_delta.version();
+
+  for (const int sticker_id : sticker_delta.removed_id()) {
+    *table_changed |= sticker_table_.erase(sticker_id) > 0;
+  }
+  for (const instantmotiontracking::Sticker& sticker : sticker_delta.added()) {
+    RET_CHECK(sticker_table_.find(sticker.id()) == sticker_table_.end())
+        << "Sticker " << sticker.id() << " was added more than once";
+    *table_changed |= UpsertSticker(sticker);
+  }
+  for (const instantmotiontracking::Sticker& sticker : sticker_delta.updated()) {
+    RET_CHECK(sticker_table_.find(sticker.id()) != sticker_table_.end())
+        << "Sticker " << sticker.id() << " was updated before being added";
+    *table_changed |= UpsertSticker(sticker);
+  }
+  return ::mediapipe::OkStatus();
+}
+
+void StickerManagerCalculator::ReplaceStickerTable(
+    const google::protobuf::RepeatedPtrField<instantmotiontracking::Sticker>&
+        stickers,
+    bool* table_changed) {
+  std::map<int, instantmotiontracking::Sticker> previous_table;
+  previous_table.swap(sticker_table_);
+  for (const instantmotiontracking::Sticker& sticker : stickers) {
+    sticker_table_.emplace(sticker.id(), sticker);
+  }
+
+  // Compare against the previous table to detect additions, removals and edits
+  *table_changed = previous_table.size() != sticker_table_.size() ||
+                   !std::equal(previous_table.begin(), previous_table.end(),
+                               sticker_table_.begin(),
+                               [](const auto& a, const auto& b) {
+                                 return a.first == b.first &&
+                                        IsSameSticker(a.second, b.second);
+                               });
+}
+
+bool StickerManagerCalculator::UpsertSticker(
+    const instantmotiontracking::Sticker& sticker) {
+  auto inserted = sticker_table_.emplace(sticker.id(), sticker);
+  if (inserted.second) {
+    return true;
+  }
+  if (IsSameSticker(inserted.first->second, sticker)) {
+    return false;
+  }
+  inserted.first->second = sticker;
+  return true;
+}
+
 REGISTER_CALCULATOR(StickerManagerCalculator);
 }  // namespace mediapipe
@@ -0,0 +1,206 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/integral_types.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/sticker_buffer.pb.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/transformations.h"
+
+namespace mediapipe {
+namespace {
+
+using ::instantmotiontracking::Sticker;
+using ::instantmotiontracking::StickerDelta;
+using ::testing::HasSubstr;
+
+CalculatorGraphConfig::Node MakeNodeConfig() {
+  return ParseTextProtoOrDie<CalculatorGraphConfig::Node>(R"(
+    calculator: "StickerManagerCalculator"
+    input_stream: "DELTA:sticker_delta_string"
+    output_stream: "ANCHORS:initial_anchor_data"
+    output_stream: "USER_ROTATIONS:user_rotation_data"
+    output_stream: "USER_SCALINGS:user_scaling_data"
+    output_stream: "RENDER_DATA:sticker_render_data"
+  )");
+}
+
+Sticker MakeSticker(int id, float x, float y, int render_id = 0) {
+  Sticker sticker;
+  sticker.set_id(id);
+  sticker.set_x(x);
+  sticker.set_y(y);
+  sticker.set_rotation(0.25f * id);
+  sticker.set_scale(1.0f + id);
+  sticker.set_renderid(render_id);
+  return sticker;
+}
+
+StickerDelta MakeDelta(int64 version, const std::vector<Sticker>& added,
+                       const std::vector<Sticker>& updated = {},
+                       const std::vector<int>& removed_ids = {}) {
+  StickerDelta delta;
+  delta.set_version(version);
+  for (const Sticker& sticker : added) {
+    *delta.add_added() = sticker;
+  }
+  for (const Sticker& sticker : updated) {
+    *delta.add_updated() = sticker;
+  }
+  for (const int id : removed_ids) {
+    delta.add_removed_id(id);
+  }
+  return delta;
+}
+
+StickerDelta MakeFullState(int64 version, const std::vector<Sticker>& stickers) {
+  StickerDelta delta = MakeDelta(version, stickers);
+  delta.set_full_state(true);
+  return delta;
+}
+
+void AddDelta(const StickerDelta& delta, int64 timestamp,
+              CalculatorRunner* runner) {
+  runner->MutableInputs()->Tag("DELTA").packets.push_back(
+      MakePacket<std::string>(delta.SerializeAsString())
+          .At(Timestamp(timestamp)));
+}
+
+const std::vector<Packet>& AnchorPackets(const CalculatorRunner& runner) {
+  return runner.Outputs().Tag("ANCHORS").packets;
+}
+
+// Returns the sticker ids of an ANCHORS packet, in order
+std::vector<int> AnchorIds(const Packet& packet) {
+  std::vector<int> ids;
+  for (const Anchor& anchor : packet.Get<std::vector<Anchor>>()) {
+    ids.push_back(anchor.sticker_id);
+  }
+  return ids;
+}
+
+TEST(StickerManagerCalculatorTest, AddsUpdatesAndRemovesStickers) {
+  CalculatorRunner runner(MakeNodeConfig());
+  AddDelta(MakeDelta(1, {MakeSticker(2, 0.2f, 0.3f, 1),
+                         MakeSticker(1, 0.5f, 0.5f)}),
+           0, &runner);
+  AddDelta(MakeDelta(2, {}, {MakeSticker(1, 0.7f, 0.1f)}), 1, &runner);
+  AddDelta(MakeDelta(3, {MakeSticker(3, 0.4f, 0.6f, 1)}, {}, {2}), 2,
+           &runner);
+  MP_ASSERT_OK(runner.Run());
+
+  const std::vector<Packet>& anchor_packets = AnchorPackets(runner);
+  ASSERT_EQ(anchor_packets.size(), 3u);
+  // Stickers are output in id order
+  EXPECT_EQ(AnchorIds(anchor_packets[0]), std::vector<int>({1, 2}));
+  const std::vector<Anchor>& updated_anchors =
+      anchor_packets[1].Get<std::vector<Anchor>>();
+  ASSERT_EQ(updated_anchors.size(), 2u);
+  EXPECT_FLOAT_EQ(updated_anchors[0].x, 0.7f);
+  EXPECT_FLOAT_EQ(updated_anchors[0].y, 0.1f);
+  EXPECT_FLOAT_EQ(updated_anchors[0].z, 1.0f);
+  EXPECT_EQ(AnchorIds(anchor_packets[2]), std::vector<int>({1, 3}));
+
+  // All outputs describe the same stickers
+  const std::vector<UserRotation>& rotations =
+      runner.Outputs().Tag("USER_ROTATIONS").packets[2]
+          .Get<std::vector<UserRotation>>();
+  const std::vector<UserScaling>& scalings =
+      runner.Outputs().Tag("USER_SCALINGS").packets[2]
+          .Get<std::vector<UserScaling>>();
+  const std::vector<int>& render_data =
+      runner.Outputs().Tag("RENDER_DATA").packets[2].Get<std::vector<int>>();
+  ASSERT_EQ(rotations.size(), 2u);
+  ASSERT_EQ(scalings.size(), 2u);
+  EXPECT_EQ(rotations[1].sticker_id, 3);
+  EXPECT_FLOAT_EQ(rotations[1].rotation_radians, 0.75f);
+  EXPECT_EQ(scalings[1].sticker_id, 3);
+  EXPECT_FLOAT_EQ(scalings[1].scale_factor, 4.0f);
+  EXPECT_EQ(render_data, std::vector<int>({0, 1}));
+}
+
+TEST(StickerManagerCalculatorTest, EmitsNothingWhileTableIsUnchanged) {
+  CalculatorRunner runner(MakeNodeConfig());
+  // The first packet is emitted even for an empty table
+  AddDelta(MakeDelta(0, {}), 0, &runner);
+  AddDelta(MakeDelta(0, {}), 1, &runner);
+  AddDelta(MakeDelta(1, {MakeSticker(1, 0.5f, 0.5f)}), 2, &runner);
+  AddDelta(MakeDelta(1, {}), 3, &runner);
+  // An update to the values the sticker already has
+  AddDelta(MakeDelta(2, {}, {MakeSticker(1, 0.5f, 0.5f)}), 4, &runner);
+  // A full state holding the same stickers
+  AddDelta(MakeFullState(3, {MakeSticker(1, 0.5f, 0.5f)}), 5, &runner);
+  MP_ASSERT_OK(runner.Run());
+
+  const std::vector<Packet>& anchor_packets = AnchorPackets(runner);
+  ASSERT_EQ(anchor_packets.size(), 2u);
+  EXPECT_EQ(anchor_packets[0].Timestamp(), Timestamp(0));
+  EXPECT_TRUE(AnchorIds(anchor_packets[0]).empty());
+  EXPECT_EQ(anchor_packets[1].Timestamp(), Timestamp(2));
+  EXPECT_EQ(AnchorIds(anchor_packets[1]), std::vector<int>({1}));
+}
+
+TEST(StickerManagerCalculatorTest, FailsOnDuplicateAdd) {
+  CalculatorRunner runner(MakeNodeConfig());
+  AddDelta(MakeDelta(1, {MakeSticker(1, 0.5f, 0.5f)}), 0, &runner);
+  AddDelta(MakeDelta(2, {MakeSticker(1, 0.2f, 0.2f)}), 1, &runner);
+  const ::mediapipe::Status status = runner.Run();
+  EXPECT_FALSE(status.ok());
+  EXPECT_THAT(status.ToString(), HasSubstr("added more than once"));
+}
+
+TEST(StickerManagerCalculatorTest, FailsOnUpdateBeforeAdd) {
+  CalculatorRunner runner(MakeNodeConfig());
+  AddDelta(MakeDelta(1, {}, {MakeSticker(1, 0.5f, 0.5f)}), 0, &runner);
+  const ::mediapipe::Status status = runner.Run();
+  EXPECT_FALSE(status.ok());
+  EXPECT_THAT(status.ToString(), HasSubstr("updated before being added"));
+}
+
+TEST(StickerManagerCalculatorTest, ResyncsOnFullStateAfterDeltaGap) {
+  CalculatorRunner runner(MakeNodeConfig());
+  AddDelta(MakeDelta(1, {MakeSticker(1, 0.5f, 0.5f)}), 0, &runner);
+  // Version 2 was lost, so this and later deltas cannot be applied. Sticker 2
+  // is then updated without having been added as far as the table knows,
+  // which must not fail the graph either.
+  AddDelta(MakeDelta(3, {MakeSticker(2, 0.2f, 0.2f)}), 1, &runner);
+  AddDelta(MakeDelta(4, {}, {MakeSticker(2, 0.3f, 0.3f)}), 2, &runner);
+  AddDelta(MakeFullState(4, {MakeSticker(1, 0.5f, 0.5f),
+                             MakeSticker(2, 0.3f, 0.3f)}),
+           3, &runner);
+  // Deltas apply again on top of the full state
+  AddDelta(MakeDelta(5, {}, {}, {1}), 4, &runner);
+  MP_ASSERT_OK(runner.Run());
+
+  const std::vector<Packet>& anchor_packets = AnchorPackets(runner);
+  ASSERT_EQ(anchor_packets.size(), 3u);
+  EXPECT_EQ(anchor_packets[0].Timestamp(), Timestamp(0));
+  EXPECT_EQ(AnchorIds(anchor_packets[0]), std::vector<int>({1}));
+  EXPECT_EQ(anchor_packets[1].Timestamp(), Timestamp(3));
+  EXPECT_EQ(AnchorIds(anchor_packets[1]), std::vector<int>({1, 2}));
+  EXPECT_FLOAT_EQ(anchor_packets[1].Get<std::vector<Anchor>>()[1].x, 0.3f);
+  EXPECT_EQ(anchor_packets[2].Timestamp(), Timestamp(4));
+  EXPECT_EQ(AnchorIds(anchor_packets[2]), std::vector<int>({2}));
+  EXPECT_EQ(runner.GetCounter("StickerManagerDeltaResyncs")->Get(), 1);
+  EXPECT_EQ(runner.GetCounter("StickerManagerDeltasIgnored")->Get(), 2);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,79 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Compresses an image into an ETC2 texture in a KTX file, which
+// GlAnimationOverlayCalculator uploads without decoding. Usage:
+//   texture_asset_converter --input_path=robot_texture.jpg
+//       --output_path=robot_texture.ktx
+
+#include <cstdlib>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/port/commandlineflags.h"
+#include "mediapipe/framework/port/file_helpers.h"
+#include "mediapipe/framework/port/opencv_imgcodecs_inc.h"
+#include "mediapipe/framework/port/opencv_imgproc_inc.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/graphs/instantmotiontracking/calculators/compressed_texture.h"
+
+DEFINE_string(input_path, "", "Path of the image to compress.");
+DEFINE_string(output_path, "", "Path to write the KTX texture to.");
+
+::mediapipe::Status ConvertTextureAsset() {
+  const cv::Mat image = cv::imread(FLAGS_input_path, cv::IMREAD_UNCHANGED);
+  if (image.empty()) {
+    return ::mediapipe::InvalidArgumentError(
+        absl::StrCat("Failed to read image: ", FLAGS_input_path));
+  }
+  cv::Mat rgba;
+  switch (image.channels()) {
+    case 1:
+      cv::cvtColor(image, rgba, cv::COLOR_GRAY2RGBA);
+      break;
+    case 3:
+      cv::cvtColor(image, rgba, cv::COLOR_BGR2RGBA);
+      break;
+    case 4:
+      cv::cvtColor(image, rgba, cv::COLOR_BGRA2RGBA);
+      break;
+    default:
+      return ::mediapipe::InvalidArgumentError(
+          absl::StrCat("Unsupported number of channels: ", image.channels()));
+  }
+  if (rgba.depth() != CV_8U) {
+    return ::mediapipe::InvalidArgumentError(
+        absl::StrCat("Image is not 8 bits per channel: ", FLAGS_input_path));
+  }
+
+  // Rows are kept top to bottom, as in textures created from ImageFrames
+  uint32 gl_internal_format = 0;
+  const std::string blocks = mediapipe::EncodeEtc2(
+      rgba.ptr<uint8>(), rgba.cols, rgba.rows, &gl_internal_format);
+  return mediapipe::file::SetContents(
+      FLAGS_output_path,
+      mediapipe::CompressedTexture::SerializeKtx(gl_internal_format, rgba.cols,
+                                                 rgba.rows, blocks));
+}
+
+int main(int argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  ::mediapipe::Status status = ConvertTextureAsset();
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to convert texture asset: " << status.message();
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,341 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Measures the tracking CPU saved and the anchor accuracy lost by analyzing
+// only every Nth frame of a recorded clip. For every analysis interval, the
+// clip goes through FrameSkipCalculator, motion analysis and box tracking with
+// the options of BoxTrackingSubgraph, with five boxes laid out as the five on
+// a die. On skipped frames, anchors are extrapolated with AnchorMotionFilter
+// as in TrackedAnchorManagerCalculator. Recorded clips carry no IMU rotation,
+// so the rotation compensation of skipped frames is left out, and the errors
+// are an upper bound for the app. Clips are analyzed at their recorded
+// resolution, so should be scaled to the tracking resolution beforehand.
+// Usage:
+//   bazel run -c opt //mediapipe/graphs/instantmotiontracking/subgraphs/calculators:analysis_interval_benchmark -- --input_video_path=clip.mp4
+//
+// For every analysis interval, prints:
+//   cpu msec/frame: process CPU time per camera frame, including decoding,
+//     which the "decode" row gives on its own.
+//   mean error, max error: distance between the anchor centers and those
+//     tracked on every frame, in normalized screen units, over all frames.
+//   lost: boxes lost by the tracker before the last frame.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/commandlineflags.h"
+#include "mediapipe/framework/port/integral_types.h"
+#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/graphs/instantmotiontracking/subgraphs/calculators/anchor_motion_filter.h"
+#include "mediapipe/util/tracking/box_tracker.pb.h"
+
+DEFINE_string(input_video_path, "", "Path of the recorded clip to track.");
+DEFINE_string(analysis_intervals, "1,2,3",
+              "Comma-separated numbers of frames per analyzed frame. The "
+              "first one is the reference for the errors.");
+DEFINE_double(box_size, 0.2, "Normalized tracking box edge length.");
+
+namespace mediapipe {
+namespace {
+
+// Box centers, in normalized coordinates
+constexpr float kBoxCenters[][2] = {
+    {0.5f, 0.5f}, {0.25f, 0.25f}, {0.75f, 0.25f}, {0.25f, 0.75f},
+    {0.75f, 0.75f}};
+constexpr int kNumBoxes = sizeof(kBoxCenters) / sizeof(kBoxCenters[0]);
+
+// Decodes the clip, and if track is set, skips, analyzes and tracks its frames
+// as BoxTrackingSubgraph does
+CalculatorGraphConfig MakeGraphConfig(bool track) {
+  constexpr char kDecodeConfig[] = R"(
+    input_side_packet: "input_video_path"
+    input_side_packet: "analysis_interval"
+    input_side_packet: "initial_pos"
+    node {
+      calculator: "OpenCvVideoDecoderCalculator"
+      input_side_packet: "INPUT_FILE_PATH:input_video_path"
+      output_stream: "VIDEO:input_video"
+    }
+  )";
+  constexpr char kTrackConfig[] = R"(
+    node {
+      calculator: "FrameSkipCalculator"
+      input_stream: "VIDEO:input_video"
+      output_stream: "VIDEO:analyzed_video"
+      input_side_packet: "ANALYSIS_INTERVAL:analysis_interval"
+    }
+    node {
+      calculator: "MotionAnalysisCalculator"
+      input_stream: "VIDEO:analyzed_video"
+      output_stream: "CAMERA:camera_motion"
+      output_stream: "FLOW:region_flow"
+      node_options: {
+        [type.googleapis.com/mediapipe.MotionAnalysisCalculatorOptions]: {
+          analysis_options {
+            analysis_policy: ANALYSIS_POLICY_CAMERA_MOBILE
+            flow_options {
+              fast_estimation_min_block_size: 100
+              top_inlier_sets: 1
+              frac_inlier_error_threshold: 3e-3
+              downsample_mode: DOWNSAMPLE_TO_INPUT_SIZE
+              verification_distance: 5.0
+              verify_long_feature_acceleration: true
+              verify_long_feature_trigger_ratio: 0.1
+              tracking_options {
+                max_features: 500
+                adaptive_extraction_levels: 2
+                min_eig_val_settings {
+                  adaptive_lowest_quality_level: 2e-4
+                }
+                klt_tracker_implementation: KLT_OPENCV
+              }
+            }
+          }
+        }
+      }
+    }
+    node {
+      calculator: "FlowPackagerCalculator"
+      input_stream: "FLOW:region_flow"
+      input_stream: "CAMERA:camera_motion"
+      output_stream: "TRACKING:tracking_data"
+      node_options: {
+        [type.googleapis.com/mediapipe.FlowPackagerCalculatorOptions]: {
+          flow_packager_options: {
+            binary_tracking_data_support: false
+          }
+        }
+      }
+    }
+    node {
+      calculator: "BoxTrackerCalculator"
+      input_stream: "TRACKING:tracking_data"
+      input_stream: "TRACK_TIME:tracking_data"
+      input_side_packet: "INITIAL_POS:initial_pos"
+      output_stream: "BOXES:boxes"
+      node_options: {
+        [type.googleapis.com/mediapipe.BoxTrackerCalculatorOptions]: {
+          tracker_options: {
+            track_step_options {
+              track_object_and_camera: true
+              tracking_degrees: TRACKING_DEGREE_OBJECT_SCALE
+              inlier_spring_force: 0.0
+              static_motion_temporal_ratio: 3e-2
+            }
+          }
+          visualize_tracking_data: false
+          streaming_track_data_cache_size: 100
+        }
+      }
+    }
+  )";
+  return ParseTextProtoOrDie<CalculatorGraphConfig>(
+      track ? absl::StrCat(kDecodeConfig, kTrackConfig) : kDecodeConfig);
+}
+
+TimedBoxProtoList MakeInitialBoxes() {
+  TimedBoxProtoList boxes;
+  for (int i = 0; i < kNumBoxes; ++i) {
+    TimedBoxProto* box = boxes.add_box();
+    box->set_left(kBoxCenters[i][0] - 0.5f * FLAGS_box_size);
+    box->set_right(kBoxCenters[i][0] + 0.5f * FLAGS_box_size);
+    box->set_top(kBoxCenters[i][1] - 0.5f * FLAGS_box_size);
+    box->set_bottom(kBoxCenters[i][1] + 0.5f * FLAGS_box_size);
+    box->set_id(i);
+    box->set_time_msec(0);
+  }
+  return boxes;
+}
+
+// Normalized anchor centers of every box ID on a frame
+using FrameAnchors = absl::flat_hash_map<int, std::pair<float, float>>;
+
+struct ClipRun {
+  double cpu_msec_per_frame = 0.0;
+  std::vector<Timestamp> frame_timestamps;
+  // Anchors of every frame, in the order of frame_timestamps
+  std::vector<FrameAnchors> anchors;
+  int lost = 0;
+};
+
+// Runs the clip analyzing every analysis_interval frames, or only decodes it
+// if analysis_interval is 0, and follows the anchors through skipped frames
+::mediapipe::Status RunClip(const std::string& path, int analysis_interval,
+                            ClipRun* run) {
+  // Tracked anchors of the analyzed frames, by timestamp value
+  absl::flat_hash_map<int64, FrameAnchors> tracked_anchors;
+  CalculatorGraph graph;
+  MP_RETURN_IF_ERROR(graph.Initialize(MakeGraphConfig(analysis_interval > 0)));
+  MP_RETURN_IF_ERROR(graph.ObserveOutputStream(
+      "input_video", [run](const Packet& packet) {
+        run->frame_timestamps.push_back(packet.Timestamp());
+        return ::mediapipe::OkStatus();
+      }));
+  if (analysis_interval > 0) {
+    MP_RETURN_IF_ERROR(graph.ObserveOutputStream(
+        "boxes", [&tracked_anchors](const Packet& packet) {
+          FrameAnchors& anchors = tracked_anchors[packet.Timestamp().Value()];
+          for (const TimedBoxProto& box :
+               packet.Get<TimedBoxProtoList>().box()) {
+            anchors[box.id()] = {(box.left() + box.right()) * 0.5f,
+                                 (box.top() + box.bottom()) * 0.5f};
+          }
+          return ::mediapipe::OkStatus();
+        }));
+  }
+
+  const std::clock_t start_clock = std::clock();
+  MP_RETURN_IF_ERROR(graph.StartRun(
+      {{"input_video_path", MakePacket<std::string>(path)},
+       {"analysis_interval", MakePacket<int>(std::max(analysis_interval, 1))},
+       {"initial_pos", MakePacket<TimedBoxProtoList>(MakeInitialBoxes())}}));
+  MP_RETURN_IF_ERROR(graph.WaitUntilDone());
+  const double cpu_msec =
+      1000.0 * (std::clock() - start_clock) / CLOCKS_PER_SEC;
+  RET_CHECK(!run->frame_timestamps.empty()) << "The clip has no frames.";
+  run->cpu_msec_per_frame = cpu_msec / run->frame_timestamps.size();
+
+  // Anchors take the tracked box centers on analyzed frames, and are
+  // extrapolated from them on skipped ones, as in
+  // TrackedAnchorManagerCalculator
+  absl::flat_hash_map<int, AnchorMotionFilter> motion_filters;
+  for (const Timestamp& timestamp : run->frame_timestamps) {
+    const double time_seconds = timestamp.Seconds();
+    FrameAnchors anchors;
+    auto tracked = tracked_anchors.find(timestamp.Value());
+    const bool analyzed = tracked != tracked_anchors.end();
+    if (analyzed) {
+      for (const auto& anchor : tracked->second) {
+        auto filter = motion_filters.find(anchor.first);
+        if (filter == motion_filters.end()) {
+          motion_filters[anchor.first].Reset(anchor.second.first,
+                                             anchor.second.second, 1.0f,
+                                             time_seconds);
+        } else {
+          filter->second.Update(anchor.second.first, anchor.second.second,
+                                1.0f, time_seconds);
+        }
+        anchors[anchor.first] = anchor.second;
+      }
+    } else {
+      for (auto& filter : motion_filters) {
+        filter.second.Extrapolate(time_seconds);
+        anchors[filter.first] = {filter.second.x(), filter.second.y()};
+      }
+    }
+    run->anchors.push_back(std::move(anchors));
+  }
+  if (analysis_interval > 0) {
+    // The last analyzed frame tells which boxes are still tracked
+    int num_tracked = 0;
+    for (auto it = run->frame_timestamps.rbegin();
+         it != run->frame_timestamps.rend(); ++it) {
+      auto tracked = tracked_anchors.find(it->Value());
+      if (tracked != tracked_anchors.end()) {
+        num_tracked = tracked->second.size();
+        break;
+      }
+    }
+    run->lost = kNumBoxes - num_tracked;
+  }
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status RunBenchmark() {
+  RET_CHECK(!FLAGS_input_video_path.empty()) << "--input_video_path is empty.";
+  RET_CHECK_GT(FLAGS_box_size, 0.0);
+  std::vector<int> analysis_intervals;
+  for (absl::string_view interval :
+       absl::StrSplit(FLAGS_analysis_intervals, ',')) {
+    int analysis_interval;
+    RET_CHECK(absl::SimpleAtoi(interval, &analysis_interval) &&
+              analysis_interval >= 1)
+        << "Invalid analysis interval: " << interval;
+    analysis_intervals.push_back(analysis_interval);
+  }
+
+  ClipRun decode_run;
+  MP_RETURN_IF_ERROR(RunClip(FLAGS_input_video_path, 0, &decode_run));
+  std::cout << absl::StrFormat("%d frames\n",
+                               decode_run.frame_timestamps.size());
+  std::cout << absl::StrFormat("%-9s %-15s %-11s %-10s %s\n", "interval",
+                               "cpu msec/frame", "mean error", "max error",
+                               "lost");
+  std::cout << absl::StrFormat("%-9s %-15.3f\n", "decode",
+                               decode_run.cpu_msec_per_frame);
+
+  ClipRun reference;
+  for (size_t i = 0; i < analysis_intervals.size(); ++i) {
+    ClipRun run;
+    MP_RETURN_IF_ERROR(
+        RunClip(FLAGS_input_video_path, analysis_intervals[i], &run));
+    if (i == 0) {
+      reference = run;
+    }
+    RET_CHECK_EQ(run.anchors.size(), reference.anchors.size())
+        << "The clip decoded to a different number of frames.";
+    double error_sum = 0.0;
+    double max_error = 0.0;
+    int num_errors = 0;
+    for (size_t frame = 0; frame < run.anchors.size(); ++frame) {
+      for (const auto& anchor : run.anchors[frame]) {
+        auto expected = reference.anchors[frame].find(anchor.first);
+        if (expected == reference.anchors[frame].end()) {
+          continue;
+        }
+        const double error =
+            std::hypot(anchor.second.first - expected->second.first,
+                       anchor.second.second - expected->second.second);
+        error_sum += error;
+        max_error = std::max(max_error, error);
+        ++num_errors;
+      }
+    }
+    std::cout << absl::StrFormat(
+        "%-9d %-15.3f %-11.4f %-10.4f %d/%d\n", analysis_intervals[i],
+        run.cpu_msec_per_frame, num_errors > 0 ? error_sum / num_errors : 0.0,
+        max_error, run.lost, kNumBoxes);
+  }
+  return ::mediapipe::OkStatus();
+}
+
+}  // namespace
+}  // namespace mediapipe
+
+int main(int argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  ::mediapipe::Status status = mediapipe::RunBenchmark();
+  if (!status.ok()) {
+    LOG(ERROR) << "Analysis interval benchmark failed: " << status.message();
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
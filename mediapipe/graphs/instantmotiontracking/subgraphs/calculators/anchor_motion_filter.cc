@@ -0,0 +1,175 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/graphs/instantmotiontracking/subgraphs/calculators/anchor_motion_filter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mediapipe {
+
+namespace {
+
+// Axis indices into AnchorMotionFilter::axes_
+constexpr int kX = 0;
+constexpr int kY = 1;
+constexpr int kLogScale = 2;
+
+// Noise parameters, in normalized screen units (or log scale units) and
+// seconds. Positions are measured to within about 1% of the screen, and scales
+// to within about 5%. The process noise is the spectral density of the
+// acceleration, which allows for quick hand-held camera motion.
+constexpr float kPositionMeasurementNoise = 1e-4f;
+constexpr float kLogScaleMeasurementNoise = 2.5e-3f;
+constexpr float kPositionProcessNoise = 0.5f;
+constexpr float kLogScaleProcessNoise = 0.1f;
+// Initial velocity variance of a sticker that was just placed
+constexpr float kInitialVelocityVariance = 1.0f;
+// Velocity is damped by this factor whenever a lost box is predicted or a
+// stale estimate coasts, so that such stickers come to rest instead of
+// drifting away. Extrapolating stickers that are deliberately not measured
+// keeps their velocity.
+constexpr float kMissedUpdateVelocityDamping = 0.5f;
+// Longest time step to extrapolate over, in seconds
+constexpr double kMaxTimeStep = 0.5;
+
+}  // namespace
+
+void AnchorMotionFilter::Axis::Reset(float measured_position) {
+  position = measured_position;
+  velocity = 0.0f;
+  variance_pp = 0.0f;
+  variance_pv = 0.0f;
+  variance_vv = kInitialVelocityVariance;
+}
+
+void AnchorMotionFilter::Axis::Predict(float dt, float process_noise) {
+  // x' = F x, P' = F P F^T + Q, with F = [1 dt; 0 1] and Q the discretized
+  // white noise acceleration covariance.
+  position += velocity * dt;
+  const float dt2 = dt * dt;
+  variance_pp += 2.0f * dt * variance_pv + dt2 * variance_vv +
+                 process_noise * dt2 * dt / 3.0f;
+  variance_pv += dt * variance_vv + process_noise * dt2 * 0.5f;
+  variance_vv += process_noise * dt;
+}
+
+void AnchorMotionFilter::Axis::Update(float measured_position,
+                                      float measurement_noise) {
+  // Only the position is measured, so the gain is the first column of P over
+  // the innovation variance.
+  const float innovation_variance = variance_pp + measurement_noise;
+  const float gain_p = variance_pp / innovation_variance;
+  const float gain_v = variance_pv / innovation_variance;
+  const float innovation = measured_position - position;
+  position += gain_p * innovation;
+  velocity += gain_v * innovation;
+  // P' = (I - K H) P
+  variance_vv -= gain_v * variance_pv;
+  variance_pv *= 1.0f - gain_p;
+  variance_pp *= 1.0f - gain_p;
+}
+
+void AnchorMotionFilter::Reset(float x, float y, float scale,
+                               double time_seconds) {
+  axes_[kX].Reset(x);
+  axes_[kY].Reset(y);
+  axes_[kLogScale].Reset(std::log(scale));
+  time_seconds_ = time_seconds;
+}
+
+bool AnchorMotionFilter::Advance(double time_seconds) {
+  const double dt = std::min(time_seconds - time_seconds_, kMaxTimeStep);
+  time_seconds_ = time_seconds;
+  if (dt <= 0.0) {
+    return false;
+  }
+  axes_[kX].Predict(dt, kPositionProcessNoise);
+  axes_[kY].Predict(dt, kPositionProcessNoise);
+  axes_[kLogScale].Predict(dt, kLogScaleProcessNoise);
+  return true;
+}
+
+void AnchorMotionFilter::Predict(double time_seconds) {
+  Coast(time_seconds);
+  // Keep the predicted box on screen
+  axes_[kX].position = std::min(std::max(axes_[kX].position, 0.0f), 1.0f);
+  axes_[kY].position = std::min(std::max(axes_[kY].position, 0.0f), 1.0f);
+}
+
+void AnchorMotionFilter::Extrapolate(double time_seconds) {
+  Advance(time_seconds);
+}
+
+void AnchorMotionFilter::Coast(double time_seconds) {
+  if (Advance(time_seconds)) {
+    for (Axis& axis : axes_) {
+      axis.velocity *= kMissedUpdateVelocityDamping;
+    }
+  }
+}
+
+void AnchorMotionFilter::Update(float x, float y, float scale,
+                                double time_seconds) {
+  Advance(time_seconds);
+  axes_[kX].Update(x, kPositionMeasurementNoise);
+  axes_[kY].Update(y, kPositionMeasurementNoise);
+  axes_[kLogScale].Update(std::log(scale), kLogScaleMeasurementNoise);
+}
+
+void AnchorMotionFilter::Translate(float dx, float dy) {
+  axes_[kX].position += dx;
+  axes_[kY].position += dy;
+}
+
+float AnchorMotionFilter::scale() const {
+  return std::exp(axes_[kLogScale].position);
+}
+
+bool RotateScreenPoint(const Eigen::Matrix3f& previous_rotation,
+                       const Eigen::Matrix3f& rotation, float tan_half_fov_x,
+                       float tan_half_fov_y, float* x, float* y) {
+  // View ray through the screen point, in remapped device coordinates (x left,
+  // y up, camera looking along +z)
+  const Eigen::Vector3f ray((1.0f - 2.0f * *x) * tan_half_fov_x,
+                            (1.0f - 2.0f * *y) * tan_half_fov_y, 1.0f);
+  // The direction stays fixed in the world while the device rotates
+  const Eigen::Vector3f rotated_ray =
+      rotation.transpose() * (previous_rotation * ray);
+  if (rotated_ray.z() <= 0.0f) {
+    return false;
+  }
+  *x = 0.5f * (1.0f - rotated_ray.x() / (rotated_ray.z() * tan_half_fov_x));
+  *y = 0.5f * (1.0f - rotated_ray.y() / (rotated_ray.z() * tan_half_fov_y));
+  return true;
+}
+
+Eigen::Matrix3f ScreenRotationHomography(
+    const Eigen::Matrix3f& previous_rotation, const Eigen::Matrix3f& rotation,
+    float tan_half_fov_x, float tan_half_fov_y) {
+  // Maps homogeneous screen points to view rays as in RotateScreenPoint, and
+  // back
+  Eigen::Matrix3f screen_to_ray;
+  screen_to_ray << -2.0f * tan_half_fov_x, 0.0f, tan_half_fov_x,
+                   0.0f, -2.0f * tan_half_fov_y, tan_half_fov_y,
+                   0.0f, 0.0f, 1.0f;
+  Eigen::Matrix3f ray_to_screen;
+  ray_to_screen << -0.5f / tan_half_fov_x, 0.0f, 0.5f,
+                   0.0f, -0.5f / tan_half_fov_y, 0.5f,
+                   0.0f, 0.0f, 1.0f;
+  return ray_to_screen * rotation.transpose() * previous_rotation *
+         screen_to_ray;
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,107 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_SUBGRAPHS_CALCULATORS_ANCHOR_MOTION_FILTER_H_
+#define MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_SUBGRAPHS_CALCULATORS_ANCHOR_MOTION_FILTER_H_
+
+#include "Eigen/Core"
+
+namespace mediapipe {
+
+// Constant-velocity Kalman filter over the normalized screen position and scale
+// of a tracked sticker anchor. Each of x, y and log(scale) is filtered
+// independently, with a position and velocity state per axis. Filtering the
+// scale logarithmically makes growing and shrinking symmetric.
+//
+// Measurements come from the box tracker. When a sticker's box is lost, the
+// filter predicts where the box should be re-acquired, damping its velocity.
+// Stickers that are deliberately not measured, on skipped frames or while
+// parked, are extrapolated at constant velocity instead, and coast to a stop
+// once they have gone unmeasured for too long.
+class AnchorMotionFilter {
+ public:
+  // Starts tracking at the given anchor coordinates, at rest.
+  void Reset(float x, float y, float scale, double time_seconds);
+
+  // Advances the estimate to time_seconds after a missed measurement, damping
+  // the velocity and keeping the predicted position on screen.
+  void Predict(double time_seconds);
+
+  // Advances the estimate to time_seconds at constant velocity, letting the
+  // position leave the screen, for stickers that are deliberately not
+  // measured.
+  void Extrapolate(double time_seconds);
+
+  // Advances the estimate to time_seconds, damping the velocity like Predict()
+  // but letting the position leave the screen like Extrapolate(), for stickers
+  // that have not been measured for so long that their velocity is stale.
+  void Coast(double time_seconds);
+
+  // Advances the estimate to time_seconds, and corrects it with the measured
+  // anchor coordinates.
+  void Update(float x, float y, float scale, double time_seconds);
+
+  // Moves the position estimate by (dx, dy), such as to compensate for a known
+  // camera rotation, without affecting the velocity.
+  void Translate(float dx, float dy);
+
+  float x() const { return axes_[0].position; }
+  float y() const { return axes_[1].position; }
+  float scale() const;
+  // Estimated velocities, in normalized screen (or log scale) units per second
+  float x_velocity() const { return axes_[0].velocity; }
+  float y_velocity() const { return axes_[1].velocity; }
+  float log_scale_velocity() const { return axes_[2].velocity; }
+
+ private:
+  // Position and velocity, along with their covariance, along one axis
+  struct Axis {
+    float position = 0.0f;
+    float velocity = 0.0f;
+    float variance_pp = 0.0f;
+    float variance_pv = 0.0f;
+    float variance_vv = 0.0f;
+
+    void Reset(float measured_position);
+    void Predict(float dt, float process_noise);
+    void Update(float measured_position, float measurement_noise);
+  };
+
+  // Predicts up to time_seconds, returning false if no time has passed.
+  bool Advance(double time_seconds);
+
+  Axis axes_[3];
+  double time_seconds_ = 0.0;
+};
+
+// Moves a normalized screen point ([0.0-1.0], y pointing down) by the change
+// in device orientation from previous_rotation to rotation. Both rotations map
+// device to world coordinates, with the device coordinate system remapped to
+// AXIS_MINUS_X and AXIS_Y as in the IMU_ROTATION streams, so that the camera
+// looks along +z. tan_half_fov_x and tan_half_fov_y describe the camera
+// frustum. Returns false if the point moved behind the camera.
+bool RotateScreenPoint(const Eigen::Matrix3f& previous_rotation,
+                       const Eigen::Matrix3f& rotation, float tan_half_fov_x,
+                       float tan_half_fov_y, float* x, float* y);
+
+// Returns the homography that moves normalized screen points by the change in
+// device orientation from previous_rotation to rotation, like
+// RotateScreenPoint but without checking for points behind the camera.
+Eigen::Matrix3f ScreenRotationHomography(
+    const Eigen::Matrix3f& previous_rotation, const Eigen::Matrix3f& rotation,
+    float tan_half_fov_x, float tan_half_fov_y);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_SUBGRAPHS_CALCULATORS_ANCHOR_MOTION_FILTER_H_
@@ -0,0 +1,106 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/graphs/instantmotiontracking/subgraphs/calculators/anchor_motion_filter.h"
+
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr double kFrameSeconds = 1.0 / 30.0;
+
+// Measures a sticker moving right at 0.3 screen widths per second for a
+// second, leaving the filter at x = 0.5 at time 1.0
+AnchorMotionFilter MakeMovingFilter() {
+  AnchorMotionFilter filter;
+  filter.Reset(0.2f, 0.5f, 1.0f, 0.0);
+  for (int frame = 1; frame <= 30; ++frame) {
+    const double time_seconds = frame * kFrameSeconds;
+    filter.Update(0.2f + 0.3f * time_seconds, 0.5f, 1.0f, time_seconds);
+  }
+  return filter;
+}
+
+TEST(AnchorMotionFilterTest, UpdateFollowsConstantVelocity) {
+  const AnchorMotionFilter filter = MakeMovingFilter();
+  EXPECT_NEAR(filter.x(), 0.5f, 0.01f);
+  EXPECT_NEAR(filter.y(), 0.5f, 1e-4f);
+  EXPECT_NEAR(filter.scale(), 1.0f, 1e-4f);
+  EXPECT_NEAR(filter.x_velocity(), 0.3f, 0.03f);
+}
+
+TEST(AnchorMotionFilterTest, ExtrapolateKeepsVelocity) {
+  AnchorMotionFilter filter = MakeMovingFilter();
+  const float velocity = filter.x_velocity();
+  const float x = filter.x();
+  // Deliberately skipped frames, such as every other frame analyzed
+  for (int frame = 1; frame <= 3; ++frame) {
+    filter.Extrapolate(1.0 + frame * kFrameSeconds);
+  }
+  EXPECT_FLOAT_EQ(filter.x_velocity(), velocity);
+  EXPECT_NEAR(filter.x(), x + 3.0f * kFrameSeconds * velocity, 1e-5f);
+}
+
+TEST(AnchorMotionFilterTest, ExtrapolateLeavesScreen) {
+  AnchorMotionFilter filter = MakeMovingFilter();
+  const float velocity = filter.x_velocity();
+  for (int step = 1; step <= 4; ++step) {
+    filter.Extrapolate(1.0 + step * 0.5);
+  }
+  EXPECT_GT(filter.x(), 1.0f);
+  EXPECT_FLOAT_EQ(filter.x_velocity(), velocity);
+}
+
+TEST(AnchorMotionFilterTest, PredictDampsVelocityAndStaysOnScreen) {
+  AnchorMotionFilter filter = MakeMovingFilter();
+  const float velocity = filter.x_velocity();
+  filter.Predict(1.0 + kFrameSeconds);
+  EXPECT_LT(filter.x_velocity(), velocity);
+  EXPECT_GT(filter.x_velocity(), 0.0f);
+  for (int step = 1; step <= 10; ++step) {
+    filter.Predict(1.0 + step * 0.5);
+  }
+  EXPECT_LE(filter.x(), 1.0f);
+  EXPECT_NEAR(filter.x_velocity(), 0.0f, 1e-3f);
+}
+
+TEST(AnchorMotionFilterTest, CoastDampsVelocityAndLeavesScreen) {
+  AnchorMotionFilter filter = MakeMovingFilter();
+  const float velocity = filter.x_velocity();
+  // A sticker that was extrapolated off the right edge of the screen
+  filter.Translate(0.6f, 0.0f);
+  filter.Coast(1.0 + kFrameSeconds);
+  EXPECT_LT(filter.x_velocity(), velocity);
+  EXPECT_GT(filter.x_velocity(), 0.0f);
+  for (int step = 1; step <= 10; ++step) {
+    filter.Coast(1.0 + step * 0.5);
+  }
+  EXPECT_GT(filter.x(), 1.0f);
+  EXPECT_NEAR(filter.x_velocity(), 0.0f, 1e-3f);
+}
+
+TEST(AnchorMotionFilterTest, NoTimeStepLeavesEstimateAlone) {
+  AnchorMotionFilter filter = MakeMovingFilter();
+  const float velocity = filter.x_velocity();
+  const float x = filter.x();
+  filter.Predict(1.0);
+  filter.Extrapolate(1.0);
+  filter.Coast(1.0);
+  EXPECT_EQ(filter.x(), x);
+  EXPECT_EQ(filter.x_velocity(), velocity);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,300 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Measures the box tracking cost and the stability of the scale estimated
+// from the tracked boxes against the tracking box size, on a recorded clip.
+// Motion analysis runs once per clip, with the options of BoxTrackingSubgraph,
+// and its tracking data is then replayed through BoxTrackerCalculator for
+// every box size, with five boxes laid out as the five on a die. Clips are
+// analyzed at their recorded resolution, so should be scaled to the tracking
+// resolution beforehand. Usage:
+//   bazel run -c opt //mediapipe/graphs/instantmotiontracking/subgraphs/calculators:box_size_benchmark -- --input_video_path=clip.mp4
+//
+// For every box size, prints:
+//   msec/frame: BoxTrackerCalculator time per frame, including the cost of
+//     replaying the tracking data, which the "none" row gives on its own.
+//   jitter: RMS frame to frame change of the log of the box scale, estimated
+//     from the box width and height together, as for stickers.
+//   drift: mean absolute log of the box scale on the last frame, which is the
+//     scale error for clips in which the scene keeps its distance.
+//   lost: boxes lost by the tracker before the last frame.
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_split.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/commandlineflags.h"
+#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/util/tracking/box_tracker.pb.h"
+
+DEFINE_string(input_video_path, "", "Path of the recorded clip to track.");
+DEFINE_string(box_sizes, "0.05,0.1,0.2,0.3,0.4",
+              "Comma-separated normalized tracking box edge lengths.");
+DEFINE_double(box_aspect_ratio, 1.0,
+              "Ratio between the width and height of the tracking boxes.");
+
+namespace mediapipe {
+namespace {
+
+// Box centers, in normalized coordinates
+constexpr float kBoxCenters[][2] = {
+    {0.5f, 0.5f}, {0.25f, 0.25f}, {0.75f, 0.25f}, {0.25f, 0.75f},
+    {0.75f, 0.75f}};
+constexpr int kNumBoxes = sizeof(kBoxCenters) / sizeof(kBoxCenters[0]);
+
+// Decodes the clip, and runs motion analysis and flow packaging as in
+// BoxTrackingSubgraph
+CalculatorGraphConfig MakeAnalysisGraphConfig() {
+  return ParseTextProtoOrDie<CalculatorGraphConfig>(R"(
+    input_side_packet: "input_video_path"
+    output_stream: "tracking_data"
+    node {
+      calculator: "OpenCvVideoDecoderCalculator"
+      input_side_packet: "INPUT_FILE_PATH:input_video_path"
+      output_stream: "VIDEO:input_video"
+    }
+    node {
+      calculator: "MotionAnalysisCalculator"
+      input_stream: "VIDEO:input_video"
+      output_stream: "CAMERA:camera_motion"
+      output_stream: "FLOW:region_flow"
+      node_options: {
+        [type.googleapis.com/mediapipe.MotionAnalysisCalculatorOptions]: {
+          analysis_options {
+            analysis_policy: ANALYSIS_POLICY_CAMERA_MOBILE
+            flow_options {
+              fast_estimation_min_block_size: 100
+              top_inlier_sets: 1
+              frac_inlier_error_threshold: 3e-3
+              downsample_mode: DOWNSAMPLE_TO_INPUT_SIZE
+              verification_distance: 5.0
+              verify_long_feature_acceleration: true
+              verify_long_feature_trigger_ratio: 0.1
+              tracking_options {
+                max_features: 500
+                adaptive_extraction_levels: 2
+                min_eig_val_settings {
+                  adaptive_lowest_quality_level: 2e-4
+                }
+                klt_tracker_implementation: KLT_OPENCV
+              }
+            }
+          }
+        }
+      }
+    }
+    node {
+      calculator: "FlowPackagerCalculator"
+      input_stream: "FLOW:region_flow"
+      input_stream: "CAMERA:camera_motion"
+      output_stream: "TRACKING:tracking_data"
+      node_options: {
+        [type.googleapis.com/mediapipe.FlowPackagerCalculatorOptions]: {
+          flow_packager_options: {
+            binary_tracking_data_support: false
+          }
+        }
+      }
+    }
+  )");
+}
+
+// Tracks boxes with the options of BoxTrackingSubgraph
+CalculatorGraphConfig MakeTrackingGraphConfig() {
+  return ParseTextProtoOrDie<CalculatorGraphConfig>(R"(
+    input_stream: "tracking_data"
+    input_stream: "start_pos"
+    output_stream: "boxes"
+    node {
+      calculator: "BoxTrackerCalculator"
+      input_stream: "TRACKING:tracking_data"
+      input_stream: "TRACK_TIME:tracking_data"
+      input_stream: "START_POS:start_pos"
+      output_stream: "BOXES:boxes"
+      node_options: {
+        [type.googleapis.com/mediapipe.BoxTrackerCalculatorOptions]: {
+          tracker_options: {
+            track_step_options {
+              track_object_and_camera: true
+              tracking_degrees: TRACKING_DEGREE_OBJECT_SCALE
+              inlier_spring_force: 0.0
+              static_motion_temporal_ratio: 3e-2
+            }
+          }
+          visualize_tracking_data: false
+          streaming_track_data_cache_size: 100
+        }
+      }
+    }
+  )");
+}
+
+::mediapipe::Status AnalyzeClip(const std::string& path,
+                                std::vector<Packet>* tracking_data) {
+  CalculatorGraph graph;
+  MP_RETURN_IF_ERROR(graph.Initialize(MakeAnalysisGraphConfig()));
+  MP_RETURN_IF_ERROR(graph.ObserveOutputStream(
+      "tracking_data", [tracking_data](const Packet& packet) {
+        tracking_data->push_back(packet);
+        return ::mediapipe::OkStatus();
+      }));
+  MP_RETURN_IF_ERROR(
+      graph.StartRun({{"input_video_path", MakePacket<std::string>(path)}}));
+  return graph.WaitUntilDone();
+}
+
+struct BoxSizeResult {
+  double msec_per_frame = 0.0;
+  double jitter = 0.0;
+  double drift = 0.0;
+  int lost = 0;
+};
+
+// Tracks kNumBoxes boxes of the given dimensions through the clip, or no
+// boxes at all if box_width is 0
+::mediapipe::Status TrackBoxes(const std::vector<Packet>& tracking_data,
+                               float box_width, float box_height,
+                               BoxSizeResult* result) {
+  RET_CHECK(!tracking_data.empty()) << "The clip has no frames.";
+  absl::flat_hash_map<int, double> log_scales;
+  double squared_log_scale_changes = 0.0;
+  int num_log_scale_changes = 0;
+  int num_tracked_last_frame = 0;
+  const Timestamp last_timestamp = tracking_data.back().Timestamp();
+
+  CalculatorGraph graph;
+  MP_RETURN_IF_ERROR(graph.Initialize(MakeTrackingGraphConfig()));
+  MP_RETURN_IF_ERROR(graph.ObserveOutputStream(
+      "boxes", [&](const Packet& packet) {
+        for (const TimedBoxProto& box :
+             packet.Get<TimedBoxProtoList>().box()) {
+          const double log_scale =
+              0.5 * std::log(box_width * box_height /
+                             ((box.right() - box.left()) *
+                              (box.bottom() - box.top())));
+          auto previous = log_scales.find(box.id());
+          if (previous != log_scales.end()) {
+            const double change = log_scale - previous->second;
+            squared_log_scale_changes += change * change;
+            ++num_log_scale_changes;
+          }
+          log_scales[box.id()] = log_scale;
+          if (packet.Timestamp() == last_timestamp) {
+            result->drift += std::abs(log_scale);
+            ++num_tracked_last_frame;
+          }
+        }
+        return ::mediapipe::OkStatus();
+      }));
+
+  const absl::Time start_time = absl::Now();
+  MP_RETURN_IF_ERROR(graph.StartRun({}));
+  auto start_pos = absl::make_unique<TimedBoxProtoList>();
+  if (box_width > 0.0f) {
+    for (int i = 0; i < kNumBoxes; ++i) {
+      TimedBoxProto* box = start_pos->add_box();
+      box->set_left(kBoxCenters[i][0] - 0.5f * box_width);
+      box->set_right(kBoxCenters[i][0] + 0.5f * box_width);
+      box->set_top(kBoxCenters[i][1] - 0.5f * box_height);
+      box->set_bottom(kBoxCenters[i][1] + 0.5f * box_height);
+      box->set_id(i);
+      box->set_time_msec(tracking_data.front().Timestamp().Microseconds() /
+                         1000);
+    }
+  }
+  MP_RETURN_IF_ERROR(graph.AddPacketToInputStream(
+      "start_pos",
+      Adopt(start_pos.release()).At(tracking_data.front().Timestamp())));
+  MP_RETURN_IF_ERROR(graph.CloseInputStream("start_pos"));
+  for (const Packet& packet : tracking_data) {
+    MP_RETURN_IF_ERROR(graph.AddPacketToInputStream("tracking_data", packet));
+  }
+  MP_RETURN_IF_ERROR(graph.CloseAllInputStreams());
+  MP_RETURN_IF_ERROR(graph.WaitUntilDone());
+
+  result->msec_per_frame =
+      absl::ToDoubleMilliseconds(absl::Now() - start_time) /
+      tracking_data.size();
+  if (num_log_scale_changes > 0) {
+    result->jitter =
+        std::sqrt(squared_log_scale_changes / num_log_scale_changes);
+  }
+  if (num_tracked_last_frame > 0) {
+    result->drift /= num_tracked_last_frame;
+  }
+  result->lost = box_width > 0.0f ? kNumBoxes - num_tracked_last_frame : 0;
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status RunBenchmark() {
+  RET_CHECK(!FLAGS_input_video_path.empty()) << "--input_video_path is empty.";
+  RET_CHECK_GT(FLAGS_box_aspect_ratio, 0.0);
+  std::vector<float> box_sizes;
+  for (absl::string_view size : absl::StrSplit(FLAGS_box_sizes, ',')) {
+    float box_size;
+    RET_CHECK(absl::SimpleAtof(size, &box_size) && box_size > 0.0f)
+        << "Invalid box size: " << size;
+    box_sizes.push_back(box_size);
+  }
+
+  std::vector<Packet> tracking_data;
+  MP_RETURN_IF_ERROR(AnalyzeClip(FLAGS_input_video_path, &tracking_data));
+  std::cout << absl::StrFormat("%d frames\n", tracking_data.size());
+  std::cout << absl::StrFormat("%-8s %-11s %-8s %-8s %s\n", "box", "msec/frame",
+                               "jitter", "drift", "lost");
+
+  BoxSizeResult baseline;
+  MP_RETURN_IF_ERROR(TrackBoxes(tracking_data, 0.0f, 0.0f, &baseline));
+  std::cout << absl::StrFormat("%-8s %-11.3f\n", "none",
+                               baseline.msec_per_frame);
+  // The box keeps the given area, as tracking boxes of stickers do
+  const float stretch = std::sqrt(FLAGS_box_aspect_ratio);
+  for (const float box_size : box_sizes) {
+    BoxSizeResult result;
+    MP_RETURN_IF_ERROR(TrackBoxes(tracking_data, box_size * stretch,
+                                  box_size / stretch, &result));
+    std::cout << absl::StrFormat("%-8.3f %-11.3f %-8.4f %-8.4f %d/%d\n",
+                                 box_size, result.msec_per_frame,
+                                 result.jitter, result.drift, result.lost,
+                                 kNumBoxes);
+  }
+  return ::mediapipe::OkStatus();
+}
+
+}  // namespace
+}  // namespace mediapipe
+
+int main(int argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  ::mediapipe::Status status = mediapipe::RunBenchmark();
+  if (!status.ok()) {
+    LOG(ERROR) << "Box size benchmark failed: " << status.message();
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,89 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+
+namespace mediapipe {
+
+constexpr char kCancelIdsTag[] = "CANCEL_IDS";
+constexpr char kCancelIdTag[] = "CANCEL_ID";
+
+// This calculator adapts the batched cancellations of the
+// TrackedAnchorManagerCalculator to the BoxTrackerCalculator, which cancels a
+// single box per CANCEL_OBJECT_ID packet. Each batch is expanded into one
+// packet per ID, at consecutive timestamps starting at the batch timestamp, or
+// right after the last packet sent if a previous batch already got that far.
+//
+// The box tracker therefore does not consume a batch at once: it still gets
+// one packet per cancelled box, and cancellations past the first of a frame
+// apply at later timestamps. Only the streams leading into
+// BoxTrackingSubgraph carry a single packet per frame. The timestamp juggling
+// is confined to the tracker's back edge, where it does not interfere with
+// any other stream.
+//
+// Input:
+//  CANCEL_IDS - IDs of all tracking boxes to remove at this frame [REQUIRED]
+// Output:
+//  CANCEL_ID - Single integer ID of tracking box to remove [REQUIRED]
+//
+// Example config:
+// node {
+//   calculator: "CancelIdExpanderCalculator"
+//   input_stream: "CANCEL_IDS:cancel_object_ids"
+//   output_stream: "CANCEL_ID:cancel_object_id"
+// }
+
+class CancelIdExpanderCalculator : public CalculatorBase {
+private:
+  // Timestamp of the last CANCEL_ID packet sent
+  Timestamp last_timestamp_ = Timestamp::Unstarted();
+
+public:
+  static ::mediapipe::Status GetContract(CalculatorContract* cc) {
+    RET_CHECK(cc->Inputs().HasTag(kCancelIdsTag));
+    RET_CHECK(cc->Outputs().HasTag(kCancelIdTag));
+
+    cc->Inputs().Tag(kCancelIdsTag).Set<std::vector<int>>();
+    cc->Outputs().Tag(kCancelIdTag).Set<int>();
+
+    return ::mediapipe::OkStatus();
+  }
+
+  ::mediapipe::Status Open(CalculatorContext* cc) override {
+    return ::mediapipe::OkStatus();
+  }
+
+  ::mediapipe::Status Process(CalculatorContext* cc) override;
+};
+REGISTER_CALCULATOR(CancelIdExpanderCalculator);
+
+::mediapipe::Status CancelIdExpanderCalculator::Process(CalculatorContext* cc) {
+  const std::vector<int>& cancel_ids =
+      cc->Inputs().Tag(kCancelIdsTag).Get<std::vector<int>>();
+  Timestamp timestamp = cc->InputTimestamp();
+  for (int cancel_id : cancel_ids) {
+    if (timestamp <= last_timestamp_) {
+      timestamp = last_timestamp_.NextAllowedInStream();
+    }
+    cc->Outputs().Tag(kCancelIdTag).AddPacket(
+        MakePacket<int>(cancel_id).At(timestamp));
+    last_timestamp_ = timestamp;
+  }
+  return ::mediapipe::OkStatus();
+}
+}
@@ -0,0 +1,97 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+
+namespace mediapipe {
+
+constexpr char kVideoTag[] = "VIDEO";
+constexpr char kAnalysisIntervalSidePacketTag[] = "ANALYSIS_INTERVAL";
+// Every frame is analyzed unless ANALYSIS_INTERVAL says otherwise
+constexpr int kDefaultAnalysisInterval = 1;
+
+// This calculator passes on every Nth frame of a video stream and drops the
+// others, so that motion analysis and box tracking run at a fraction of the
+// camera frame rate. Downstream, the TrackedAnchorManagerCalculator receives no
+// boxes for the dropped frames, and extrapolates its anchors there from their
+// last tracked motion and the IMU rotation since.
+//
+// The number of analyzed and skipped frames is counted, so that the tracking
+// cost saved can be weighed against the accuracy lost.
+//
+// Input:
+//  VIDEO - Frames of any type [REQUIRED]
+// Input Side Packets:
+//  ANALYSIS_INTERVAL - Number of frames per analyzed frame, 1 analyzing
+//  every frame (default 1) [OPTIONAL]
+// Output:
+//  VIDEO - First frame of every ANALYSIS_INTERVAL frames [REQUIRED]
+//
+// Example config:
+// node {
+//   calculator: "FrameSkipCalculator"
+//   input_stream: "VIDEO:input_video"
+//   output_stream: "VIDEO:analyzed_video"
+//   input_side_packet: "ANALYSIS_INTERVAL:analysis_interval"
+// }
+
+class FrameSkipCalculator : public CalculatorBase {
+private:
+  int analysis_interval = kDefaultAnalysisInterval;
+  // Number of frames received since the last analyzed frame
+  int frames_since_analysis = 0;
+
+public:
+  static ::mediapipe::Status GetContract(CalculatorContract* cc) {
+    RET_CHECK(cc->Inputs().HasTag(kVideoTag)
+      && cc->Outputs().HasTag(kVideoTag));
+
+    cc->Inputs().Tag(kVideoTag).SetAny();
+    cc->Outputs().Tag(kVideoTag).SetSameAs(&cc->Inputs().Tag(kVideoTag));
+    if (cc->InputSidePackets().HasTag(kAnalysisIntervalSidePacketTag)) {
+      cc->InputSidePackets().Tag(kAnalysisIntervalSidePacketTag).Set<int>();
+    }
+
+    return ::mediapipe::OkStatus();
+  }
+
+  ::mediapipe::Status Open(CalculatorContext* cc) override {
+    cc->SetOffset(TimestampDiff(0));
+    if (cc->InputSidePackets().HasTag(kAnalysisIntervalSidePacketTag)) {
+      analysis_interval =
+          cc->InputSidePackets().Tag(kAnalysisIntervalSidePacketTag).Get<int>();
+      RET_CHECK_GE(analysis_interval, 1);
+    }
+    // Analyze the first frame
+    frames_since_analysis = analysis_interval;
+    return ::mediapipe::OkStatus();
+  }
+
+  ::mediapipe::Status Process(CalculatorContext* cc) override {
+    if (frames_since_analysis < analysis_interval) {
+      ++frames_since_analysis;
+      cc->GetCounter("FrameSkipSkippedFrames")->Increment();
+      return ::mediapipe::OkStatus();
+    }
+    frames_since_analysis = 1;
+    cc->GetCounter("FrameSkipAnalyzedFrames")->Increment();
+    cc->Outputs().Tag(kVideoTag).AddPacket(
+        cc->Inputs().Tag(kVideoTag).Value());
+    return ::mediapipe::OkStatus();
+  }
+};
+REGISTER_CALCULATOR(FrameSkipCalculator);
+}
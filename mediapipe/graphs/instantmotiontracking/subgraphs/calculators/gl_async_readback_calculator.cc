@@ -0,0 +1,520 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/gpu/gl_calculator_helper.h"
+#include "mediapipe/gpu/gpu_buffer_format.h"
+#include "mediapipe/gpu/shader_util.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr char kImageGpuTag[] = "IMAGE_GPU";
+constexpr char kImageTag[] = "IMAGE";
+constexpr char kLuminanceTag[] = "LUMINANCE";
+constexpr char kNumBuffersSidePacketTag[] = "NUM_BUFFERS";
+// Number of pixel buffers in flight unless NUM_BUFFERS says otherwise
+constexpr int kDefaultNumBuffers = 3;
+// Longest time to wait for the oldest readback when all buffers are in flight
+constexpr GLuint64 kStallTimeoutNanos = 1000000000;
+// Rows of pixels are packed with the default GL_PACK_ALIGNMENT
+constexpr int kPackAlignment = 4;
+
+// Counters describing the readback pipeline
+constexpr char kFramesCounter[] = "GlAsyncReadbackFrames";
+constexpr char kLatencyMicrosCounter[] = "GlAsyncReadbackLatencyMicros";
+constexpr char kStallsCounter[] = "GlAsyncReadbackStalls";
+constexpr char kStallMicrosCounter[] = "GlAsyncReadbackStallMicros";
+
+// Asynchronous readback requires pixel pack buffers and fence syncs, which
+// come with OpenGL ES 3.0 and OpenGL 3.2, both at compile time and at run time.
+#if defined(GL_PIXEL_PACK_BUFFER) && defined(GL_SYNC_GPU_COMMANDS_COMPLETE)
+#define GL_ASYNC_READBACK 1
+#endif
+
+enum { ATTRIB_VERTEX, NUM_ATTRIBUTES };
+
+// Full-screen quad, drawn as a triangle strip
+const GLfloat kSquareVertices[] = {
+    -1.0f, -1.0f,  // bottom left
+    1.0f,  -1.0f,  // bottom right
+    -1.0f, 1.0f,   // top left
+    1.0f,  1.0f,   // top right
+};
+
+// Each fragment of the luminance program packs the BT.601 luma of four
+// horizontally adjacent input pixels into its four channels. Rows are kept in
+// texture memory order, so the packed plane reads back as a GRAY8 image.
+const GLchar kLuminanceVertexShader[] = R"(
+  attribute vec4 position;
+
+  void main() {
+    gl_Position = position;
+  }
+)";
+
+const GLchar kLuminanceFragmentShader[] = R"(
+#ifdef GL_FRAGMENT_PRECISION_HIGH
+  precision highp float;
+#else
+  precision mediump float;
+#endif
+
+  uniform sampler2D inputTexture;
+  // Size of one input pixel in texture coordinates
+  uniform vec2 inputPixelSize;
+
+  const vec3 kLumaWeights = vec3(0.299, 0.587, 0.114);
+
+  float Luma(float x, float y) {
+    return dot(texture2D(inputTexture, vec2(x, y) * inputPixelSize).rgb,
+               kLumaWeights);
+  }
+
+  void main() {
+    // Center of the first of the four input pixels
+    float x = gl_FragCoord.x * 4.0 - 1.5;
+    float y = gl_FragCoord.y;
+    gl_FragColor =
+        vec4(Luma(x, y), Luma(x + 1.0, y), Luma(x + 2.0, y), Luma(x + 3.0, y));
+  }
+)";
+
+}  // namespace
+
+// This calculator converts GpuBuffers into ImageFrames, like the
+// GpuBufferToImageFrameCalculator, without waiting for the GPU. Each frame is
+// read into one of a ring of pixel buffer objects, and a fence is inserted
+// behind the read. The frame is delivered on a later call, once its fence has
+// signaled, so that the CPU image of frame N-1 is typically output while frame
+// N is still being rendered.
+//
+// Output packets keep the timestamp of their input, but lag behind it by up to
+// NUM_BUFFERS - 1 frames. Only when all buffers are in flight does the
+// calculator wait for the oldest one, which is counted as a stall. Remaining
+// frames are flushed on Close.
+//
+// The following counters are maintained:
+//  GlAsyncReadbackFrames - Frames delivered
+//  GlAsyncReadbackLatencyMicros - Total time from issuing to delivering frames
+//  GlAsyncReadbackStalls - Number of times the calculator had to wait for a
+//  readback
+//  GlAsyncReadbackStallMicros - Total time spent waiting
+//
+// Without OpenGL ES 3.0, frames are read back synchronously.
+//
+// When only luminance is needed, the LUMINANCE output has a shader pack the
+// luma of four pixels into each RGBA texel before reading back, so that a
+// quarter of the data crosses the bus and no color conversion is left to the
+// CPU.
+//
+// Input:
+//  IMAGE_GPU - GpuBuffer to read back [REQUIRED]
+// Input Side Packets:
+//  NUM_BUFFERS - Number of pixel buffers in flight, at least 2 (default 3)
+//  [OPTIONAL]
+// Output (exactly one of):
+//  IMAGE - ImageFrame read back from IMAGE_GPU
+//  LUMINANCE - GRAY8 ImageFrame of the luma of IMAGE_GPU
+//
+// Example config:
+// node {
+//   calculator: "GlAsyncReadbackCalculator"
+//   input_stream: "IMAGE_GPU:downscaled_input_video"
+//   output_stream: "LUMINANCE:downscaled_input_video_gray"
+// }
+
+class GlAsyncReadbackCalculator : public CalculatorBase {
+ public:
+  ~GlAsyncReadbackCalculator() override;
+
+  static ::mediapipe::Status GetContract(CalculatorContract* cc);
+  ::mediapipe::Status Open(CalculatorContext* cc) override;
+  ::mediapipe::Status Process(CalculatorContext* cc) override;
+  ::mediapipe::Status Close(CalculatorContext* cc) override;
+
+ private:
+  // Pixels to read from the framebuffer, and the frame they make up
+  struct ReadFormat {
+    ImageFormat::Format format = ImageFormat::UNKNOWN;
+    int width = 0;
+    int height = 0;
+    // Width of the framebuffer to read, in pixels of gl_format and gl_type
+    GLsizei read_width = 0;
+    GLenum gl_format = GL_RGBA;
+    GLenum gl_type = GL_UNSIGNED_BYTE;
+  };
+
+  ::mediapipe::Status GlSetupLuminanceProgram();
+  // Binds a framebuffer holding the pixels of input to read, packed into
+  // luminance for the LUMINANCE output. texture must be released once read.
+  ::mediapipe::Status BindReadFramebuffer(const GpuBuffer& input,
+                                          GlTexture* texture,
+                                          ReadFormat* read_format);
+  // Reads input into an ImageFrame, waiting for the GPU to finish.
+  ::mediapipe::Status ReadBackSync(CalculatorContext* cc,
+                                   const GpuBuffer& input);
+
+#if GL_ASYNC_READBACK
+  // A frame being read back into a pixel buffer
+  struct Readback {
+    GLuint pixel_buffer = 0;
+    GLsizeiptr buffer_size = 0;
+    GLsync fence = nullptr;
+    ReadFormat read_format;
+    Timestamp timestamp;
+    absl::Time issue_time;
+  };
+
+  // Starts reading input into the next pixel buffer, which must be free.
+  ::mediapipe::Status IssueReadback(const GpuBuffer& input,
+                                    Timestamp timestamp);
+  // Outputs the oldest readback in flight once its fence has signaled, waiting
+  // for it if wait is true. Sets delivered to whether it was output.
+  ::mediapipe::Status DeliverOldest(CalculatorContext* cc, bool wait,
+                                    bool* delivered);
+
+  std::vector<Readback> readbacks_;
+  // Index into readbacks_ of the next buffer to read into
+  int next_readback_ = 0;
+  int num_pending_ = 0;
+#endif  // GL_ASYNC_READBACK
+
+  GlCalculatorHelper helper_;
+  bool use_pixel_buffers_ = false;
+  // Tag of the output stream, kImageTag or kLuminanceTag
+  const char* output_tag_ = kImageTag;
+  GLuint luminance_program_ = 0;
+  GLint input_pixel_size_uniform_ = -1;
+  GLuint vertex_buffer_ = 0;
+};
+REGISTER_CALCULATOR(GlAsyncReadbackCalculator);
+
+// static
+::mediapipe::Status GlAsyncReadbackCalculator::GetContract(
+    CalculatorContract* cc) {
+  RET_CHECK(cc->Inputs().HasTag(kImageGpuTag));
+  RET_CHECK(cc->Outputs().HasTag(kImageTag) !=
+            cc->Outputs().HasTag(kLuminanceTag))
+      << "Exactly one of IMAGE and LUMINANCE must be output.";
+
+  cc->Inputs().Tag(kImageGpuTag).Set<GpuBuffer>();
+  if (cc->Outputs().HasTag(kImageTag)) {
+    cc->Outputs().Tag(kImageTag).Set<ImageFrame>();
+  } else {
+    cc->Outputs().Tag(kLuminanceTag).Set<ImageFrame>();
+  }
+  if (cc->InputSidePackets().HasTag(kNumBuffersSidePacketTag)) {
+    cc->InputSidePackets().Tag(kNumBuffersSidePacketTag).Set<int>();
+  }
+
+  MP_RETURN_IF_ERROR(GlCalculatorHelper::UpdateContract(cc));
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status GlAsyncReadbackCalculator::Open(CalculatorContext* cc) {
+  MP_RETURN_IF_ERROR(helper_.Open(cc));
+  if (cc->Outputs().HasTag(kLuminanceTag)) {
+    output_tag_ = kLuminanceTag;
+    MP_RETURN_IF_ERROR(helper_.RunInGlContext(
+        [this]() { return GlSetupLuminanceProgram(); }));
+  }
+
+#if GL_ASYNC_READBACK
+  int num_buffers = kDefaultNumBuffers;
+  if (cc->InputSidePackets().HasTag(kNumBuffersSidePacketTag)) {
+    num_buffers =
+        cc->InputSidePackets().Tag(kNumBuffersSidePacketTag).Get<int>();
+    RET_CHECK_GE(num_buffers, 2)
+        << "At least two buffers are needed to read back asynchronously.";
+  }
+  use_pixel_buffers_ = helper_.GetGlVersion() != GlVersion::kGLES2;
+  if (use_pixel_buffers_) {
+    readbacks_.resize(num_buffers);
+  }
+#endif  // GL_ASYNC_READBACK
+
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status GlAsyncReadbackCalculator::Process(CalculatorContext* cc) {
+  const auto& input = cc->Inputs().Tag(kImageGpuTag).Get<GpuBuffer>();
+  return helper_.RunInGlContext([this, &cc, &input]() -> ::mediapipe::Status {
+    if (!use_pixel_buffers_) {
+      return ReadBackSync(cc, input);
+    }
+#if GL_ASYNC_READBACK
+    bool delivered = false;
+    // The oldest buffer can only be reused once its frame has been delivered
+    if (num_pending_ == static_cast<int>(readbacks_.size())) {
+      MP_RETURN_IF_ERROR(DeliverOldest(cc, /*wait=*/true, &delivered));
+    }
+    MP_RETURN_IF_ERROR(IssueReadback(input, cc->InputTimestamp()));
+    // Deliver everything that has completed in the meantime, in order
+    do {
+      MP_RETURN_IF_ERROR(DeliverOldest(cc, /*wait=*/false, &delivered));
+    } while (delivered && num_pending_ > 0);
+#endif  // GL_ASYNC_READBACK
+    return ::mediapipe::OkStatus();
+  });
+}
+
+::mediapipe::Status GlAsyncReadbackCalculator::Close(CalculatorContext* cc) {
+#if GL_ASYNC_READBACK
+  return helper_.RunInGlContext([this, &cc]() -> ::mediapipe::Status {
+    bool delivered = false;
+    while (num_pending_ > 0) {
+      MP_RETURN_IF_ERROR(DeliverOldest(cc, /*wait=*/true, &delivered));
+    }
+    return ::mediapipe::OkStatus();
+  });
+#else
+  return ::mediapipe::OkStatus();
+#endif  // GL_ASYNC_READBACK
+}
+
+GlAsyncReadbackCalculator::~GlAsyncReadbackCalculator() {
+  helper_.RunInGlContext([this] {
+    if (luminance_program_) {
+      glDeleteProgram(luminance_program_);
+      luminance_program_ = 0;
+    }
+    if (vertex_buffer_) {
+      glDeleteBuffers(1, &vertex_buffer_);
+      vertex_buffer_ = 0;
+    }
+#if GL_ASYNC_READBACK
+    for (Readback& readback : readbacks_) {
+      if (readback.fence) {
+        glDeleteSync(readback.fence);
+        readback.fence = nullptr;
+      }
+      if (readback.pixel_buffer) {
+        glDeleteBuffers(1, &readback.pixel_buffer);
+        readback.pixel_buffer = 0;
+      }
+    }
+    readbacks_.clear();
+#endif  // GL_ASYNC_READBACK
+  });
+}
+
+::mediapipe::Status GlAsyncReadbackCalculator::GlSetupLuminanceProgram() {
+  const GLint attr_location[NUM_ATTRIBUTES] = {
+      ATTRIB_VERTEX,
+  };
+  const GLchar* attr_name[NUM_ATTRIBUTES] = {
+      "position",
+  };
+  GlhCreateProgram(kLuminanceVertexShader, kLuminanceFragmentShader,
+                   NUM_ATTRIBUTES, &attr_name[0], attr_location,
+                   &luminance_program_);
+  RET_CHECK(luminance_program_) << "Problem initializing the program.";
+  glUseProgram(luminance_program_);
+  glUniform1i(glGetUniformLocation(luminance_program_, "inputTexture"), 1);
+  input_pixel_size_uniform_ =
+      glGetUniformLocation(luminance_program_, "inputPixelSize");
+  glUseProgram(0);
+
+  glGenBuffers(1, &vertex_buffer_);
+  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(kSquareVertices), kSquareVertices,
+               GL_STATIC_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status GlAsyncReadbackCalculator::BindReadFramebuffer(
+    const GpuBuffer& input, GlTexture* texture, ReadFormat* read_format) {
+  GlTexture src = helper_.CreateSourceTexture(input);
+  read_format->width = src.width();
+  read_format->height = src.height();
+  if (!luminance_program_) {
+    const auto& info = GlTextureInfoForGpuBufferFormat(input.format(), 0,
+                                                       helper_.GetGlVersion());
+    read_format->format = ImageFormatForGpuBufferFormat(input.format());
+    read_format->read_width = src.width();
+    read_format->gl_format = info.gl_format;
+    read_format->gl_type = info.gl_type;
+    helper_.BindFramebuffer(src);
+    *texture = src;
+    return ::mediapipe::OkStatus();
+  }
+
+  // A GRAY8 row of the default 4 byte alignment is exactly one row of packed
+  // RGBA texels
+  read_format->format = ImageFormat::GRAY8;
+  read_format->read_width = (src.width() + 3) / 4;
+  read_format->gl_format = GL_RGBA;
+  read_format->gl_type = GL_UNSIGNED_BYTE;
+  *texture = helper_.CreateDestinationTexture(read_format->read_width,
+                                              src.height());
+  helper_.BindFramebuffer(*texture);
+
+  glUseProgram(luminance_program_);
+  glUniform2f(input_pixel_size_uniform_, 1.0f / src.width(),
+              1.0f / src.height());
+  glActiveTexture(GL_TEXTURE1);
+  glBindTexture(src.target(), src.name());
+  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+  glEnableVertexAttribArray(ATTRIB_VERTEX);
+  glVertexAttribPointer(ATTRIB_VERTEX, 2, GL_FLOAT, 0, 0, nullptr);
+  glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+  glDisableVertexAttribArray(ATTRIB_VERTEX);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindTexture(src.target(), 0);
+  glActiveTexture(GL_TEXTURE0);
+  glUseProgram(0);
+  src.Release();
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status GlAsyncReadbackCalculator::ReadBackSync(
+    CalculatorContext* cc, const GpuBuffer& input) {
+  GlTexture texture;
+  ReadFormat read_format;
+  MP_RETURN_IF_ERROR(BindReadFramebuffer(input, &texture, &read_format));
+  auto frame = absl::make_unique<ImageFrame>(
+      read_format.format, read_format.width, read_format.height,
+      ImageFrame::kGlDefaultAlignmentBoundary);
+  glReadPixels(0, 0, read_format.read_width, read_format.height,
+               read_format.gl_format, read_format.gl_type,
+               frame->MutablePixelData());
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  texture.Release();
+  cc->GetCounter(kFramesCounter)->Increment();
+  cc->Outputs().Tag(output_tag_).Add(frame.release(), cc->InputTimestamp());
+  return ::mediapipe::OkStatus();
+}
+
+#if GL_ASYNC_READBACK
+::mediapipe::Status GlAsyncReadbackCalculator::IssueReadback(
+    const GpuBuffer& input, Timestamp timestamp) {
+  Readback& readback = readbacks_[next_readback_];
+  RET_CHECK(readback.fence == nullptr);
+
+  GlTexture texture;
+  ReadFormat& read_format = readback.read_format;
+  MP_RETURN_IF_ERROR(BindReadFramebuffer(input, &texture, &read_format));
+  readback.timestamp = timestamp;
+  const int row_size =
+      read_format.width *
+      ImageFrame::NumberOfChannelsForFormat(read_format.format) *
+      ImageFrame::ByteDepthForFormat(read_format.format);
+  const GLsizeiptr buffer_size =
+      static_cast<GLsizeiptr>(read_format.height) *
+      ((row_size + kPackAlignment - 1) / kPackAlignment * kPackAlignment);
+
+  if (!readback.pixel_buffer) {
+    glGenBuffers(1, &readback.pixel_buffer);
+    RET_CHECK(readback.pixel_buffer) << "Problem creating pixel buffer.";
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pixel_buffer);
+  if (readback.buffer_size != buffer_size) {
+    glBufferData(GL_PIXEL_PACK_BUFFER, buffer_size, nullptr, GL_STREAM_READ);
+    readback.buffer_size = buffer_size;
+  }
+
+  // With a pixel pack buffer bound, glReadPixels only queues the copy, and the
+  // pointer argument is an offset into the buffer.
+  glReadPixels(0, 0, read_format.read_width, read_format.height,
+               read_format.gl_format, read_format.gl_type, nullptr);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  RET_CHECK(readback.fence) << "Problem creating readback fence.";
+  // Make sure the GPU gets to the fence without anyone waiting on it.
+  glFlush();
+  texture.Release();
+
+  readback.issue_time = absl::Now();
+  next_readback_ = (next_readback_ + 1) % readbacks_.size();
+  ++num_pending_;
+  return ::mediapipe::OkStatus();
+}
+
+::mediapipe::Status GlAsyncReadbackCalculator::DeliverOldest(
+    CalculatorContext* cc, bool wait, bool* delivered) {
+  *delivered = false;
+  if (num_pending_ == 0) {
+    return ::mediapipe::OkStatus();
+  }
+  const int num_buffers = readbacks_.size();
+  Readback& readback =
+      readbacks_[(next_readback_ - num_pending_ + num_buffers) % num_buffers];
+
+  GLenum status = glClientWaitSync(readback.fence, 0, 0);
+  if (status == GL_TIMEOUT_EXPIRED) {
+    if (!wait) {
+      return ::mediapipe::OkStatus();
+    }
+    const absl::Time stall_start = absl::Now();
+    status = glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                              kStallTimeoutNanos);
+    cc->GetCounter(kStallsCounter)->Increment();
+    cc->GetCounter(kStallMicrosCounter)
+        ->IncrementBy(absl::ToInt64Microseconds(absl::Now() - stall_start));
+  }
+  RET_CHECK(status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+      << "Problem waiting for readback of frame " << readback.timestamp
+      << ", status " << status;
+  glDeleteSync(readback.fence);
+  readback.fence = nullptr;
+  --num_pending_;
+
+  const ReadFormat& read_format = readback.read_format;
+  auto frame = absl::make_unique<ImageFrame>(
+      read_format.format, read_format.width, read_format.height,
+      ImageFrame::kGlDefaultAlignmentBoundary);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pixel_buffer);
+  const char* pixels = static_cast<const char*>(glMapBufferRange(
+      GL_PIXEL_PACK_BUFFER, 0, readback.buffer_size, GL_MAP_READ_BIT));
+  if (!pixels) {
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return ::mediapipe::InternalError("Problem mapping pixel buffer.");
+  }
+  const int row_size = frame->Width() * frame->NumberOfChannels() *
+                       frame->ByteDepth();
+  const int buffer_row_size =
+      (row_size + kPackAlignment - 1) / kPackAlignment * kPackAlignment;
+  uint8* dst = frame->MutablePixelData();
+  for (int row = 0; row < read_format.height; ++row) {
+    std::memcpy(dst + row * frame->WidthStep(), pixels + row * buffer_row_size,
+                row_size);
+  }
+  glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  cc->GetCounter(kFramesCounter)->Increment();
+  const absl::Duration latency = absl::Now() - readback.issue_time;
+  cc->GetCounter(kLatencyMicrosCounter)
+      ->IncrementBy(absl::ToInt64Microseconds(latency));
+  cc->Outputs().Tag(output_tag_).Add(frame.release(), readback.timestamp);
+  *delivered = true;
+  return ::mediapipe::OkStatus();
+}
+#endif  // GL_ASYNC_READBACK
+
+}  // namespace mediapipe
@@ -0,0 +1,164 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+
+#include "Eigen/Core"
+#include "absl/memory/memory.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/graphs/instantmotiontracking/subgraphs/calculators/anchor_motion_filter.h"
+#include "mediapipe/util/tracking/motion_models.pb.h"
+
+namespace mediapipe {
+
+constexpr char kVideoTag[] = "VIDEO";
+constexpr char kIMUMatrixTag[] = "IMU_ROTATION";
+constexpr char kHomographyTag[] = "HOMOGRAPHY";
+constexpr char kFOVSidePacketTag[] = "FOV";
+constexpr char kAspectRatioSidePacketTag[] = "ASPECT_RATIO";
+
+// This calculator predicts the image motion caused by rotating the device
+// between consecutive analyzed frames, to seed the feature tracking of the
+// MotionAnalysisCalculator. Under fast rotations, features then only need to be
+// searched for around where the rotation moved them, instead of around where
+// they were.
+//
+// Rotations are turned into homographies with a pinhole camera model of the
+// device's field of view, centered on the frame, with square pixels. Following
+// the convention of CameraMotion, each homography maps pixel locations in the
+// frame at its timestamp to the previous analyzed frame, however many frames
+// were skipped in between. The identity is output for the first frame, for
+// skipped frames, whenever the IMU rotation of a frame or its predecessor is
+// missing, and should the frame size differ from its predecessor's, as the
+// homography is expressed in the pixels of both frames.
+//
+// Input:
+//  VIDEO - ImageFrame analyzed by the MotionAnalysisCalculator, which provides
+//  the pixel dimensions and the timestamps to output at [REQUIRED]
+//  IMU_ROTATION - float[9] of row-major device rotation matrix [REQUIRED]
+// Input Side Packets:
+//  FOV - Vertical field of view for device [REQUIRED]
+//  ASPECT_RATIO - Aspect ratio of device [REQUIRED]
+// Output:
+//  HOMOGRAPHY - Homography to seed feature tracking with [REQUIRED]
+//
+// Example config:
+// node {
+//   calculator: "ImuSeedHomographyCalculator"
+//   input_stream: "VIDEO:downscaled_input_video_gray"
+//   input_stream: "IMU_ROTATION:imu_rotation_matrix"
+//   output_stream: "HOMOGRAPHY:seed_homography"
+//   input_side_packet: "FOV:vertical_fov_radians"
+//   input_side_packet: "ASPECT_RATIO:aspect_ratio"
+// }
+
+class ImuSeedHomographyCalculator : public CalculatorBase {
+private:
+  // Device rotation of the previous analyzed frame, if it had one
+  Eigen::Matrix3f previous_imu_rotation;
+  bool has_previous_imu_rotation = false;
+  // Pixel dimensions of the previous analyzed frame
+  int previous_width = 0;
+  int previous_height = 0;
+  // Tangents of the half field of view angles
+  float tan_half_fov_x = 0.0f;
+  float tan_half_fov_y = 0.0f;
+
+public:
+  static ::mediapipe::Status GetContract(CalculatorContract* cc) {
+    RET_CHECK(cc->Inputs().HasTag(kVideoTag)
+      && cc->Inputs().HasTag(kIMUMatrixTag));
+    RET_CHECK(cc->InputSidePackets().HasTag(kFOVSidePacketTag)
+      && cc->InputSidePackets().HasTag(kAspectRatioSidePacketTag));
+    RET_CHECK(cc->Outputs().HasTag(kHomographyTag));
+
+    cc->Inputs().Tag(kVideoTag).Set<ImageFrame>();
+    cc->Inputs().Tag(kIMUMatrixTag).Set<float[]>();
+    cc->InputSidePackets().Tag(kFOVSidePacketTag).Set<float>();
+    cc->InputSidePackets().Tag(kAspectRatioSidePacketTag).Set<float>();
+    cc->Outputs().Tag(kHomographyTag).Set<Homography>();
+
+    return ::mediapipe::OkStatus();
+  }
+
+  ::mediapipe::Status Open(CalculatorContext* cc) override {
+    cc->SetOffset(TimestampDiff(0));
+    const float vertical_fov_radians =
+        cc->InputSidePackets().Tag(kFOVSidePacketTag).Get<float>();
+    const float aspect_ratio =
+        cc->InputSidePackets().Tag(kAspectRatioSidePacketTag).Get<float>();
+    tan_half_fov_y = std::tan(vertical_fov_radians * 0.5f);
+    tan_half_fov_x = tan_half_fov_y * aspect_ratio;
+    return ::mediapipe::OkStatus();
+  }
+
+  ::mediapipe::Status Process(CalculatorContext* cc) override;
+};
+REGISTER_CALCULATOR(ImuSeedHomographyCalculator);
+
+::mediapipe::Status ImuSeedHomographyCalculator::Process(CalculatorContext* cc) {
+  auto homography = absl::make_unique<Homography>();
+  // Frames skipped before analysis come without VIDEO. The rotation is only
+  // taken over from analyzed frames, so that the seed spans every skipped
+  // frame since the last one analyzed.
+  if (cc->Inputs().Tag(kVideoTag).IsEmpty()) {
+    cc->Outputs().Tag(kHomographyTag).Add(homography.release(),
+                                          cc->InputTimestamp());
+    return ::mediapipe::OkStatus();
+  }
+  if (cc->Inputs().Tag(kIMUMatrixTag).IsEmpty()) {
+    has_previous_imu_rotation = false;
+    cc->Outputs().Tag(kHomographyTag).Add(homography.release(),
+                                          cc->InputTimestamp());
+    return ::mediapipe::OkStatus();
+  }
+
+  const auto& imu_matrix = cc->Inputs().Tag(kIMUMatrixTag).Get<float[]>();
+  // Input matrix is row-major, Eigen defaults to column-major
+  const Eigen::Matrix3f imu_rotation =
+      Eigen::Map<const Eigen::Matrix<float, 3, 3, Eigen::RowMajor>>(
+          imu_matrix);
+  const ImageFrame& frame = cc->Inputs().Tag(kVideoTag).Get<ImageFrame>();
+  if (has_previous_imu_rotation && frame.Width() == previous_width &&
+      frame.Height() == previous_height) {
+    // Swapping the rotations maps the current frame to the previous one
+    const Eigen::Matrix3f screen_homography = ScreenRotationHomography(
+        imu_rotation, previous_imu_rotation, tan_half_fov_x, tan_half_fov_y);
+    const Eigen::DiagonalMatrix<float, 3> screen_to_pixels(
+        frame.Width(), frame.Height(), 1.0f);
+    Eigen::Matrix3f pixel_homography =
+        screen_to_pixels * screen_homography * screen_to_pixels.inverse();
+    pixel_homography /= pixel_homography(2, 2);
+    homography->set_h_00(pixel_homography(0, 0));
+    homography->set_h_01(pixel_homography(0, 1));
+    homography->set_h_02(pixel_homography(0, 2));
+    homography->set_h_10(pixel_homography(1, 0));
+    homography->set_h_11(pixel_homography(1, 1));
+    homography->set_h_12(pixel_homography(1, 2));
+    homography->set_h_20(pixel_homography(2, 0));
+    homography->set_h_21(pixel_homography(2, 1));
+  }
+  previous_imu_rotation = imu_rotation;
+  has_previous_imu_rotation = true;
+  previous_width = frame.Width();
+  previous_height = frame.Height();
+
+  cc->Outputs().Tag(kHomographyTag).Add(homography.release(),
+                                        cc->InputTimestamp());
+  return ::mediapipe::OkStatus();
+}
+}
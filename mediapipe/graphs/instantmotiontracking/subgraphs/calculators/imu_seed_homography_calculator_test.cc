@@ -0,0 +1,123 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <vector>
+
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/util/tracking/motion_models.pb.h"
+
+namespace mediapipe {
+namespace {
+
+// Device yaw per frame, in radians
+constexpr float kYawPerFrame = 0.02f;
+
+CalculatorGraphConfig::Node MakeNodeConfig() {
+  return ParseTextProtoOrDie<CalculatorGraphConfig::Node>(R"(
+    calculator: "ImuSeedHomographyCalculator"
+    input_stream: "VIDEO:video"
+    input_stream: "IMU_ROTATION:imu_rotation"
+    output_stream: "HOMOGRAPHY:homography"
+    input_side_packet: "FOV:vertical_fov_radians"
+    input_side_packet: "ASPECT_RATIO:aspect_ratio"
+  )");
+}
+
+// Adds the row-major rotation of a device turning about its vertical axis
+void AddImuRotation(int frame, CalculatorRunner* runner) {
+  const float yaw = kYawPerFrame * frame;
+  float* rotation = new float[9]{std::cos(yaw),  0.0f, std::sin(yaw),
+                                 0.0f,           1.0f, 0.0f,
+                                 -std::sin(yaw), 0.0f, std::cos(yaw)};
+  runner->MutableInputs()->Tag("IMU_ROTATION").packets.push_back(
+      Adopt(reinterpret_cast<float(*)[]>(rotation)).At(Timestamp(frame)));
+}
+
+void AddVideoFrame(int frame, CalculatorRunner* runner) {
+  runner->MutableInputs()->Tag("VIDEO").packets.push_back(
+      MakePacket<ImageFrame>(ImageFormat::GRAY8, 160, 213)
+          .At(Timestamp(frame)));
+}
+
+// Runs the calculator over IMU rotations at imu_frames and frames analyzed at
+// video_frames, returning the homography output at last_frame
+Homography RunCalculator(const std::vector<int>& imu_frames,
+                         const std::vector<int>& video_frames,
+                         int last_frame) {
+  CalculatorRunner runner(MakeNodeConfig());
+  runner.MutableSidePackets()->Tag("FOV") = MakePacket<float>(1.19f);
+  runner.MutableSidePackets()->Tag("ASPECT_RATIO") = MakePacket<float>(0.75f);
+  for (const int frame : imu_frames) {
+    AddImuRotation(frame, &runner);
+  }
+  for (const int frame : video_frames) {
+    AddVideoFrame(frame, &runner);
+  }
+  MP_EXPECT_OK(runner.Run());
+  for (const Packet& packet : runner.Outputs().Tag("HOMOGRAPHY").packets) {
+    if (packet.Timestamp() == Timestamp(last_frame)) {
+      return packet.Get<Homography>();
+    }
+  }
+  ADD_FAILURE() << "No homography at frame " << last_frame;
+  return Homography();
+}
+
+void ExpectHomographiesNear(const Homography& actual,
+                            const Homography& expected) {
+  EXPECT_NEAR(actual.h_00(), expected.h_00(), 1e-4);
+  EXPECT_NEAR(actual.h_01(), expected.h_01(), 1e-4);
+  EXPECT_NEAR(actual.h_02(), expected.h_02(), 1e-2);
+  EXPECT_NEAR(actual.h_10(), expected.h_10(), 1e-4);
+  EXPECT_NEAR(actual.h_11(), expected.h_11(), 1e-4);
+  EXPECT_NEAR(actual.h_12(), expected.h_12(), 1e-2);
+  EXPECT_NEAR(actual.h_20(), expected.h_20(), 1e-6);
+  EXPECT_NEAR(actual.h_21(), expected.h_21(), 1e-6);
+}
+
+TEST(ImuSeedHomographyCalculatorTest, FirstFrameIsIdentity) {
+  const Homography homography = RunCalculator({0}, {0}, 0);
+  ExpectHomographiesNear(homography, Homography());
+}
+
+TEST(ImuSeedHomographyCalculatorTest, SeedFollowsDeviceRotation) {
+  const Homography homography = RunCalculator({0, 1}, {0, 1}, 1);
+  // Turning the device moves the image sideways by a few pixels
+  EXPECT_GT(std::abs(homography.h_02()), 1.0f);
+}
+
+TEST(ImuSeedHomographyCalculatorTest, SeedSpansSkippedFrames) {
+  // Frames 1 and 2 are skipped, but their IMU rotations still come in
+  const Homography skipping = RunCalculator({0, 1, 2, 3}, {0, 3}, 3);
+  // The seed of frame 3 maps it back to frame 0 as if nothing came between
+  const Homography direct = RunCalculator({0, 3}, {0, 3}, 3);
+  ExpectHomographiesNear(skipping, direct);
+  // and not just back to frame 2
+  const Homography last_step = RunCalculator({2, 3}, {2, 3}, 3);
+  EXPECT_GT(std::abs(skipping.h_02() - last_step.h_02()), 1.0f);
+}
+
+TEST(ImuSeedHomographyCalculatorTest, SkippedFramesGetIdentity) {
+  const Homography homography = RunCalculator({0, 1, 2}, {0, 2}, 1);
+  ExpectHomographiesNear(homography, Homography());
+}
+
+}  // namespace
+}  // namespace mediapipe
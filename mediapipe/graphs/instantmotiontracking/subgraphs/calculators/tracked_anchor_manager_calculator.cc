@@ -12,6 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cmath>
+
+#include "Eigen/Core"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/detection.pb.h"
 #include "mediapipe/framework/formats/location_data.pb.h"
@@ -19,6 +25,8 @@
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/util/tracking/box_tracker.h"
 #include "mediapipe/graphs/instantmotiontracking/calculators/transformations.h"
+#include "mediapipe/graphs/instantmotiontracking/subgraphs/calculators/anchor_motion_filter.h"
+#include "mediapipe/graphs/instantmotiontracking/subgraphs/calculators/tracking_scheduler.h"
 
 namespace mediapipe {
 
@@ -26,9 +34,27 @@ constexpr char kSentinelTag[] = "SENTINEL";
 constexpr char kAnchorsTag[] = "ANCHORS";
 constexpr char kBoxesInputTag[] = "BOXES";
 constexpr char kBoxesOutputTag[] = "START_POS";
-constexpr char kCancelTag[] = "CANCEL_ID";
-// TODO: Find optimal Height/Width (0.1-0.3)
-constexpr float kBoxEdgeSize = 0.2f; // Used to establish tracking box dimensions
+constexpr char kCancelTag[] = "CANCEL_IDS";
+constexpr char kIMUMatrixTag[] = "IMU_ROTATION";
+constexpr char kFOVSidePacketTag[] = "FOV";
+constexpr char kAspectRatioSidePacketTag[] = "ASPECT_RATIO";
+constexpr char kUserScalingsTag[] = "USER_SCALINGS";
+constexpr char kRendersTag[] = "RENDER_DATA";
+constexpr char kGifAspectRatioTag[] = "GIF_ASPECT_RATIO";
+constexpr char kMaxTrackedBoxesSidePacketTag[] = "MAX_TRACKED_BOXES";
+// Number of boxes tracked per frame unless MAX_TRACKED_BOXES says otherwise
+constexpr int kDefaultMaxTrackedBoxes = 8;
+// Frames a sticker may go without a measurement before its velocity is
+// considered stale, twice the longest cadence of the TrackingScheduler. Past
+// this, its motion filter coasts to a stop instead of extrapolating further
+constexpr int kMaxExtrapolatedFrames = 16;
+// Normalized edge length of the tracking box of a sticker at a user scale
+// factor and z of 1.0, before accounting for its aspect ratio
+constexpr float kBoxEdgeSize = 0.2f;
+// Bounds on either normalized box dimension at a z of 1.0. Smaller boxes hold
+// too few features to track reliably, larger ones mostly track background
+constexpr float kMinBoxEdgeSize = 0.1f;
+constexpr float kMaxBoxEdgeSize = 0.4f;
 constexpr float kUsToMs = 1000.0f; // Used to convert from microseconds to millis
 
 // This calculator manages the regions being tracked for each individual sticker
@@ -37,15 +63,69 @@ constexpr float kUsToMs = 1000.0f; // Used to convert from microseconds to milli
 // will be automatically removed upon the next iteration of the graph to optimize
 // performance and remove all sticker artifacts
 //
+// Anchors, tracked boxes and previous anchors are matched by sticker ID through
+// hash indices built once per frame, so each frame costs time linear in the
+// number of stickers. All boxes to add and cancel are batched into a single
+// START_POS and CANCEL_IDS packet at the frame timestamp. BoxTrackingSubgraph
+// still hands cancellations to its tracker one ID at a time.
+//
+// The motion of every sticker is followed by an AnchorMotionFilter. When a
+// sticker's box is lost, its new tracking box is seeded where the filter
+// predicts the sticker to be, at its current scale, instead of at its last
+// known position and default scale. Given the IMU rotation, camera rotations
+// are compensated for before predicting.
+//
+// Tracking boxes follow the screen footprint of their sticker rather than a
+// fixed size: their area grows with the user scale factor, and their shape
+// matches the GIF aspect ratio for GIF stickers (render ID 0), and is square on
+// screen otherwise. A sticker keeps the box dimensions it was last seeded with,
+// so that z can be estimated from the tracked width and height together
+// without jumping when the user rescales the sticker.
+//
+// Not every sticker is tracked on every frame. A TrackingScheduler gives each
+// sticker a cadence from its visibility, box size and estimated speed, and
+// hands out boxes by how overdue stickers are, so that none is starved. Visible
+// stickers keep their box in the tracker while there is room, static ones
+// included, so their tracks are not re-initialized. Off-screen stickers, and
+// static ones once the budget runs out, are parked, with their box canceled,
+// and extrapolated by their motion filter until they are due for their next
+// measurement. At most MAX_TRACKED_BOXES boxes are tracked per frame, so that
+// the tracking cost stays bounded as stickers are added. A sticker that goes
+// unmeasured for more than kMaxExtrapolatedFrames frames coasts to a stop
+// rather than drifting away at its last velocity.
+//
+// Frames may also be skipped by the tracking subgraph altogether, in which
+// case no BOXES packet arrives for them. Boxes are only considered lost when a
+// BOXES packet comes without them; on skipped frames, stickers keep their boxes
+// and are extrapolated from their last tracked motion and the IMU rotation.
+//
 // Input:
 //  SENTINEL - ID of sticker which has an anchor that must be reset (-1 when no
 // anchor must be reset) [REQUIRED]
-//  ANCHORS - Initial anchor data (tracks changes and where to re/position) [REQUIRED]
-//  BOXES - Used in cycle, boxes being tracked meant to update positions [OPTIONAL
-//  - provided by subgraph]
+//  ANCHORS - Initial anchor data (tracks changes and where to re/position). Only
+//  sent when the sticker set changes, the last packet is held otherwise [REQUIRED]
+//  BOXES - Used in cycle, boxes being tracked meant to update positions, absent
+//  on frames the tracking subgraph skips [OPTIONAL - provided by subgraph]
+//  IMU_ROTATION - float[9] of row-major device rotation matrix, used to predict
+//  sticker motion caused by camera rotation [OPTIONAL]
+//  USER_SCALINGS - UserScalings with corresponding scale factor, used to size
+//  tracking boxes [OPTIONAL]
+//  RENDER_DATA - Render ids of each sticker, in the same order as the initial
+//  anchors [OPTIONAL]
+//  (USER_SCALINGS and RENDER_DATA are only sent when the sticker set changes,
+//  the last packets are held otherwise)
+//  GIF_ASPECT_RATIO - Aspect ratio of the GIF image, used to shape the boxes
+//  of GIF stickers [OPTIONAL]
+// Input Side Packets:
+//  FOV - Vertical field of view for device [REQUIRED with IMU_ROTATION]
+//  ASPECT_RATIO - Aspect ratio of device, used to keep boxes in proportion on
+//  screen [REQUIRED with IMU_ROTATION, OPTIONAL otherwise]
+//  MAX_TRACKED_BOXES - Maximum number of boxes tracked per frame, or 0 for no
+//  limit (default 8) [OPTIONAL]
 // Output:
 //  START_POS - Positions of boxes being tracked (can be overwritten with ID) [REQUIRED]
-//  CANCEL_ID - Single integer ID of tracking box to remove from tracker subgraph [OPTIONAL]
+//  CANCEL_IDS - IDs of all tracking boxes to remove from tracker subgraph, only
+//  sent when there are any [OPTIONAL]
 //  ANCHORS - Updated set of anchors with tracked and normalized X,Y,Z [REQUIRED]
 //
 // Example config:
@@ -54,19 +134,100 @@ constexpr float kUsToMs = 1000.0f; // Used to convert from microseconds to milli
 //   input_stream: "SENTINEL:sticker_sentinel"
 //   input_stream: "ANCHORS:initial_anchor_data"
 //   input_stream: "BOXES:boxes"
+//   input_stream: "IMU_ROTATION:imu_rotation_matrix"
+//   input_stream: "USER_SCALINGS:user_scaling_data"
+//   input_stream: "RENDER_DATA:sticker_render_data"
+//   input_stream: "GIF_ASPECT_RATIO:gif_aspect_ratio"
 //   input_stream_info: {
 //     tag_index: 'BOXES'
 //     back_edge: true
 //   }
 //   output_stream: "START_POS:start_pos"
-//   output_stream: "CANCEL_ID:cancel_object_id"
+//   output_stream: "CANCEL_IDS:cancel_object_ids"
 //   output_stream: "ANCHORS:tracked_scaled_anchor_data"
+//   input_side_packet: "FOV:vertical_fov_radians"
+//   input_side_packet: "ASPECT_RATIO:aspect_ratio"
 // }
 
+namespace {
+
+// Normalized tracking box dimensions of a sticker at a z of 1.0
+struct BoxGeometry {
+  float width = kBoxEdgeSize;
+  float height = kBoxEdgeSize;
+};
+
+// Returns the tracking box dimensions for a sticker with the given user scale
+// factor and on-screen aspect ratio (width / height), on a screen with the
+// given aspect ratio. The box area follows the sticker footprint, which grows
+// linearly with the scale factor along each axis.
+BoxGeometry GetBoxGeometry(float user_scale_factor, float sticker_aspect_ratio,
+                           float screen_aspect_ratio) {
+  const float edge = kBoxEdgeSize * user_scale_factor;
+  const float stretch = std::sqrt(sticker_aspect_ratio / screen_aspect_ratio);
+  BoxGeometry geometry;
+  geometry.width =
+      std::min(std::max(edge * stretch, kMinBoxEdgeSize), kMaxBoxEdgeSize);
+  geometry.height =
+      std::min(std::max(edge / stretch, kMinBoxEdgeSize), kMaxBoxEdgeSize);
+  return geometry;
+}
+
+// Adds a tracking box centered on anchor to boxes, sized so that the box keeps
+// corresponding to the anchor scale (geometry at a scale of 1.0)
+void AddTrackingBox(const Anchor& anchor, const BoxGeometry& geometry,
+                    int64 time_msec, TimedBoxProtoList* boxes) {
+  const float half_width = geometry.width * 0.5f / anchor.z;
+  const float half_height = geometry.height * 0.5f / anchor.z;
+  TimedBoxProto* box = boxes->add_box();
+  box->set_left(anchor.x - half_width);
+  box->set_right(anchor.x + half_width);
+  box->set_top(anchor.y - half_height);
+  box->set_bottom(anchor.y + half_height);
+  box->set_id(anchor.sticker_id);
+  box->set_time_msec(time_msec);
+}
+
+}  // namespace
+
 class TrackedAnchorManagerCalculator : public CalculatorBase {
 private:
-  // Previous graph iteration anchor data
-  std::vector<Anchor> previous_anchor_data;
+  // Tracking state of a single sticker
+  struct TrackedSticker {
+    AnchorMotionFilter motion_filter;
+    // Box dimensions the sticker was last seeded with
+    BoxGeometry box_geometry;
+    // True while the tracker holds a box for the sticker, false while the
+    // sticker is parked or its box was lost
+    bool has_box = false;
+    int frames_since_measurement = 0;
+  };
+
+  // Tracking state of every sticker being tracked, by sticker ID
+  absl::flat_hash_map<int, TrackedSticker> tracked_stickers;
+  // Last initial anchor data received from the ANCHORS stream
+  std::vector<Anchor> current_anchor_data;
+  // Last user scale factors received, by sticker ID
+  absl::flat_hash_map<int, float> user_scale_factors;
+  // Last render ids received, in the order of current_anchor_data
+  std::vector<int> render_data;
+  // Last GIF aspect ratio received
+  float gif_aspect_ratio = 1.0f;
+  // Aspect ratio of the device screen
+  float screen_aspect_ratio = 1.0f;
+  // Device rotation of the previous graph iteration, if IMU data is provided
+  Eigen::Matrix3f previous_imu_rotation;
+  bool has_previous_imu_rotation = false;
+  // Tangents of the half field of view angles
+  float tan_half_fov_x = 0.0f;
+  float tan_half_fov_y = 0.0f;
+  // Decides which stickers are tracked on each frame
+  TrackingScheduler scheduler{kDefaultMaxTrackedBoxes};
+
+  // Shifts all motion estimates by the camera rotation since the last frame
+  void CompensateImuRotation(const Eigen::Matrix3f& imu_rotation);
+  // Box dimensions a sticker's tracking box would currently be seeded with
+  BoxGeometry GetStickerBoxGeometry(int sticker_id, int anchor_index) const;
 
 public:
   static ::mediapipe::Status GetContract(CalculatorContract* cc) {
@@ -81,18 +242,54 @@ public:
     if (cc->Inputs().HasTag(kBoxesInputTag)) {
       cc->Inputs().Tag(kBoxesInputTag).Set<TimedBoxProtoList>();
     }
+    if (cc->Inputs().HasTag(kIMUMatrixTag)) {
+      RET_CHECK(cc->InputSidePackets().HasTag(kFOVSidePacketTag)
+        && cc->InputSidePackets().HasTag(kAspectRatioSidePacketTag));
+      cc->Inputs().Tag(kIMUMatrixTag).Set<float[]>();
+      cc->InputSidePackets().Tag(kFOVSidePacketTag).Set<float>();
+    }
+    if (cc->InputSidePackets().HasTag(kAspectRatioSidePacketTag)) {
+      cc->InputSidePackets().Tag(kAspectRatioSidePacketTag).Set<float>();
+    }
+    if (cc->InputSidePackets().HasTag(kMaxTrackedBoxesSidePacketTag)) {
+      cc->InputSidePackets().Tag(kMaxTrackedBoxesSidePacketTag).Set<int>();
+    }
+    if (cc->Inputs().HasTag(kUserScalingsTag)) {
+      cc->Inputs().Tag(kUserScalingsTag).Set<std::vector<UserScaling>>();
+    }
+    if (cc->Inputs().HasTag(kRendersTag)) {
+      cc->Inputs().Tag(kRendersTag).Set<std::vector<int>>();
+    }
+    if (cc->Inputs().HasTag(kGifAspectRatioTag)) {
+      cc->Inputs().Tag(kGifAspectRatioTag).Set<float>();
+    }
 
     cc->Outputs().Tag(kAnchorsTag).Set<std::vector<Anchor>>();
     cc->Outputs().Tag(kBoxesOutputTag).Set<TimedBoxProtoList>();
 
     if (cc->Outputs().HasTag(kCancelTag)) {
-      cc->Outputs().Tag(kCancelTag).Set<int>();
+      cc->Outputs().Tag(kCancelTag).Set<std::vector<int>>();
     }
 
     return ::mediapipe::OkStatus();
   }
 
   ::mediapipe::Status Open(CalculatorContext* cc) override {
+    if (cc->InputSidePackets().HasTag(kAspectRatioSidePacketTag)) {
+      screen_aspect_ratio =
+          cc->InputSidePackets().Tag(kAspectRatioSidePacketTag).Get<float>();
+      RET_CHECK_GT(screen_aspect_ratio, 0.0f);
+    }
+    if (cc->Inputs().HasTag(kIMUMatrixTag)) {
+      const float vertical_fov_radians =
+          cc->InputSidePackets().Tag(kFOVSidePacketTag).Get<float>();
+      tan_half_fov_y = std::tan(vertical_fov_radians * 0.5f);
+      tan_half_fov_x = tan_half_fov_y * screen_aspect_ratio;
+    }
+    if (cc->InputSidePackets().HasTag(kMaxTrackedBoxesSidePacketTag)) {
+      scheduler = TrackingScheduler(
+          cc->InputSidePackets().Tag(kMaxTrackedBoxesSidePacketTag).Get<int>());
+    }
     return ::mediapipe::OkStatus();
   }
 
@@ -101,95 +298,241 @@ public:
 REGISTER_CALCULATOR(TrackedAnchorManagerCalculator);
 
 ::mediapipe::Status TrackedAnchorManagerCalculator::Process(CalculatorContext* cc) {
-  mediapipe::Timestamp timestamp = cc->InputTimestamp();
+  const mediapipe::Timestamp timestamp = cc->InputTimestamp();
+  const int64 time_msec = timestamp.Microseconds() / kUsToMs;
+  const double time_seconds = timestamp.Seconds();
   const int sticker_sentinel = cc->Inputs().Tag(kSentinelTag).Get<int>();
-  std::vector<Anchor> current_anchor_data = cc->Inputs().Tag(kAnchorsTag).Get<std::vector<Anchor>>();
+  if (!cc->Inputs().Tag(kAnchorsTag).IsEmpty()) {
+    current_anchor_data = cc->Inputs().Tag(kAnchorsTag).Get<std::vector<Anchor>>();
+  }
+  if (cc->Inputs().HasTag(kUserScalingsTag) &&
+      !cc->Inputs().Tag(kUserScalingsTag).IsEmpty()) {
+    const auto& user_scalings =
+        cc->Inputs().Tag(kUserScalingsTag).Get<std::vector<UserScaling>>();
+    user_scale_factors.clear();
+    for (const UserScaling& user_scaling : user_scalings) {
+      user_scale_factors[user_scaling.sticker_id] = user_scaling.scale_factor;
+    }
+  }
+  if (cc->Inputs().HasTag(kRendersTag) &&
+      !cc->Inputs().Tag(kRendersTag).IsEmpty()) {
+    render_data = cc->Inputs().Tag(kRendersTag).Get<std::vector<int>>();
+  }
+  if (cc->Inputs().HasTag(kGifAspectRatioTag) &&
+      !cc->Inputs().Tag(kGifAspectRatioTag).IsEmpty()) {
+    const float aspect_ratio =
+        cc->Inputs().Tag(kGifAspectRatioTag).Get<float>();
+    if (aspect_ratio > 0.0f) {
+      gif_aspect_ratio = aspect_ratio;
+    }
+  }
   auto pos_boxes = absl::make_unique<TimedBoxProtoList>();
+  auto cancel_ids = absl::make_unique<std::vector<int>>();
   std::vector<Anchor> tracked_scaled_anchor_data;
+  tracked_scaled_anchor_data.reserve(current_anchor_data.size());
 
-  // Delete any boxes being tracked without an associated anchor
-  for (const TimedBoxProto& box : cc->Inputs().Tag(kBoxesInputTag)
-       .Get<TimedBoxProtoList>().box()) {
-    bool anchor_exists = false;
-    for (Anchor anchor : current_anchor_data) {
-      if (box.id() == anchor.sticker_id) {
-        anchor_exists = true;
-        break;
+  absl::flat_hash_set<int> anchor_ids;
+  anchor_ids.reserve(current_anchor_data.size());
+  for (const Anchor& anchor : current_anchor_data) {
+    anchor_ids.insert(anchor.sticker_id);
+  }
+
+  // Index the boxes being tracked, pointing into the input packet, and delete
+  // any boxes being tracked without an associated anchor
+  absl::flat_hash_map<int, const TimedBoxProto*> tracked_boxes;
+  const bool has_box_list = cc->Inputs().HasTag(kBoxesInputTag) &&
+                            !cc->Inputs().Tag(kBoxesInputTag).IsEmpty();
+  if (has_box_list) {
+    const TimedBoxProtoList& box_list =
+        cc->Inputs().Tag(kBoxesInputTag).Get<TimedBoxProtoList>();
+    tracked_boxes.reserve(box_list.box_size());
+    for (const TimedBoxProto& box : box_list.box()) {
+      if (anchor_ids.contains(box.id())) {
+        tracked_boxes.emplace(box.id(), &box);
+      } else {
+        cancel_ids->push_back(box.id());
       }
     }
-    if (!anchor_exists) {
-      cc->Outputs().Tag(kCancelTag).AddPacket(MakePacket<int>(box.id()).At(timestamp++));
-    }
+  }
+
+  if (cc->Inputs().HasTag(kIMUMatrixTag) &&
+      !cc->Inputs().Tag(kIMUMatrixTag).IsEmpty()) {
+    const auto& imu_matrix = cc->Inputs().Tag(kIMUMatrixTag).Get<float[]>();
+    // Input matrix is row-major, Eigen defaults to column-major
+    const Eigen::Matrix3f imu_rotation =
+        Eigen::Map<const Eigen::Matrix<float, 3, 3, Eigen::RowMajor>>(
+            imu_matrix);
+    CompensateImuRotation(imu_rotation);
   }
 
   // Perform tracking or updating for each anchor position
-  for (Anchor anchor : current_anchor_data) {
+  const int num_anchors = current_anchor_data.size();
+  for (int i = 0; i < num_anchors; ++i) {
+    Anchor anchor = current_anchor_data[i];
     // Check if anchor position is being reset by user in this graph iteration
     if (sticker_sentinel == anchor.sticker_id) {
-      // Delete associated tracking box
-      // TODO: BoxTrackingSubgraph should accept vector to avoid breaking timestamp rules
-      cc->Outputs().Tag(kCancelTag).AddPacket(MakePacket<int>(anchor.sticker_id).At(timestamp++));
-      // Add a tracking box
-      TimedBoxProto* box = pos_boxes->add_box();
-      box->set_left(anchor.x - kBoxEdgeSize * 0.5f);
-      box->set_right(anchor.x + kBoxEdgeSize * 0.5f);
-      box->set_top(anchor.y - kBoxEdgeSize * 0.5f);
-      box->set_bottom(anchor.y + kBoxEdgeSize * 0.5f);
-      box->set_id(anchor.sticker_id);
-      box->set_time_msec((timestamp++).Microseconds() / kUsToMs);
       // Default value for normalized z (scale factor)
       anchor.z = 1.0;
+      // Delete associated tracking box and add a new one
+      cancel_ids->push_back(anchor.sticker_id);
+      TrackedSticker& sticker = tracked_stickers[anchor.sticker_id];
+      sticker.box_geometry = GetStickerBoxGeometry(anchor.sticker_id, i);
+      AddTrackingBox(anchor, sticker.box_geometry, time_msec, pos_boxes.get());
+      sticker.motion_filter.Reset(anchor.x, anchor.y, anchor.z, time_seconds);
+      sticker.has_box = true;
+      sticker.frames_since_measurement = 0;
     }
     // Anchor position was not reset by user
     else {
-      // Attempt to update anchor position from tracking subgraph (TimedBoxProto)
-      bool updated_from_tracker = false;
-      const TimedBoxProtoList box_list = cc->Inputs().Tag(kBoxesInputTag).Get<TimedBoxProtoList>();
-      for (const auto& box : box_list.box())
-      {
-        if (box.id() == anchor.sticker_id) {
-          // Get center x normalized coordinate [0.0-1.0]
-          anchor.x = (box.left() + box.right()) * 0.5f;
-          // Get center y normalized coordinate [0.0-1.0]
-          anchor.y = (box.top() + box.bottom()) * 0.5f;
-          // Get center z coordinate [z starts at normalized 1.0 and scales 
-          // inversely with box-width]
-          // TODO: Look into issues with uniform scaling on x-axis and y-axis
-          anchor.z = kBoxEdgeSize / (box.right() - box.left());
-          updated_from_tracker = true;
-          break;
+      auto sticker = tracked_stickers.find(anchor.sticker_id);
+      const bool is_new = sticker == tracked_stickers.end();
+      // Attempt to update anchor position from tracking subgraph
+      // (TimedBoxProto). Boxes of parked stickers may still come back once
+      // after being canceled, and are ignored
+      auto tracked_box = tracked_boxes.find(anchor.sticker_id);
+      if (tracked_box != tracked_boxes.end() &&
+          (is_new || sticker->second.has_box)) {
+        const TimedBoxProto& box = *tracked_box->second;
+        // Get center x normalized coordinate [0.0-1.0]
+        anchor.x = (box.left() + box.right()) * 0.5f;
+        // Get center y normalized coordinate [0.0-1.0]
+        anchor.y = (box.top() + box.bottom()) * 0.5f;
+        // Get center z coordinate [z starts at normalized 1.0 and scales
+        // inversely with box size]. The geometric mean of both axes is robust
+        // to the tracker stretching the box along one of them
+        if (is_new) {
+          sticker = tracked_stickers.emplace(anchor.sticker_id,
+                                             TrackedSticker()).first;
+          sticker->second.box_geometry =
+              GetStickerBoxGeometry(anchor.sticker_id, i);
+          sticker->second.has_box = true;
         }
+        const BoxGeometry& geometry = sticker->second.box_geometry;
+        anchor.z = std::sqrt(geometry.width * geometry.height /
+                             ((box.right() - box.left()) *
+                              (box.bottom() - box.top())));
+        if (is_new) {
+          sticker->second.motion_filter.Reset(anchor.x, anchor.y, anchor.z,
+                                              time_seconds);
+        } else {
+          sticker->second.motion_filter.Update(anchor.x, anchor.y, anchor.z,
+                                               time_seconds);
+        }
+        sticker->second.frames_since_measurement = 0;
       }
-      // If anchor position was not updated from tracker, create new tracking box
-      // at last recorded anchor coordinates. This will allow all current stickers
-      // to be tracked at approximately last location even if re-acquisitioning
-      // in the BoxTrackingSubgraph encounters errors
-      if (!updated_from_tracker) {
-        for (Anchor prev_anchor : previous_anchor_data) {
-          if (anchor.sticker_id == prev_anchor.sticker_id) {
-            anchor = prev_anchor;
-            TimedBoxProto* box = pos_boxes->add_box();
-            box->set_left(anchor.x - kBoxEdgeSize * 0.5f);
-            box->set_right(anchor.x + kBoxEdgeSize * 0.5f);
-            box->set_top(anchor.y - kBoxEdgeSize * 0.5f);
-            box->set_bottom(anchor.y + kBoxEdgeSize * 0.5f);
-            box->set_id(anchor.sticker_id);
-            box->set_time_msec((timestamp++).Microseconds() / kUsToMs);
-            // Default value for normalized z (scale factor)
-            anchor.z = 1.0;
-            break;
-          }
+      // If anchor position was not updated from tracker, follow the motion
+      // filter. A lost box is predicted to stay on screen, where it will be
+      // re-acquired once the scheduler hands it a new box, while parked
+      // stickers, and all stickers on skipped frames, are extrapolated freely
+      // until their velocity goes stale
+      else if (!is_new) {
+        AnchorMotionFilter& motion_filter = sticker->second.motion_filter;
+        if (sticker->second.has_box && has_box_list) {
+          motion_filter.Predict(time_seconds);
+          sticker->second.has_box = false;
+        } else if (sticker->second.frames_since_measurement >=
+                   kMaxExtrapolatedFrames) {
+          motion_filter.Coast(time_seconds);
+        } else {
+          motion_filter.Extrapolate(time_seconds);
         }
+        ++sticker->second.frames_since_measurement;
+        anchor.x = motion_filter.x();
+        anchor.y = motion_filter.y();
+        anchor.z = motion_filter.scale();
       }
     }
+
+    auto sticker = tracked_stickers.find(anchor.sticker_id);
+    if (sticker != tracked_stickers.end()) {
+      const BoxGeometry& geometry = sticker->second.box_geometry;
+      const float half_width = geometry.width * 0.5f / anchor.z;
+      const float half_height = geometry.height * 0.5f / anchor.z;
+      const bool visible = std::abs(anchor.x - 0.5f) < 0.5f + half_width &&
+                           std::abs(anchor.y - 0.5f) < 0.5f + half_height;
+      const AnchorMotionFilter& motion_filter = sticker->second.motion_filter;
+      const float speed =
+          std::hypot(motion_filter.x_velocity(), motion_filter.y_velocity()) +
+          std::abs(motion_filter.log_scale_velocity());
+      scheduler.AddSticker(anchor.sticker_id, visible,
+                           4.0f * half_width * half_height, speed,
+                           sticker->second.frames_since_measurement,
+                           sticker->second.has_box,
+                           sticker_sentinel == anchor.sticker_id);
+    }
     tracked_scaled_anchor_data.emplace_back(anchor);
   }
-  // Set anchor data for next iteration
-  previous_anchor_data = tracked_scaled_anchor_data;
 
-  cc->Outputs().Tag(kAnchorsTag).AddPacket(MakePacket<std::vector<Anchor>>(tracked_scaled_anchor_data).At(cc->InputTimestamp()));
-  cc->Outputs().Tag(kBoxesOutputTag).Add(pos_boxes.release(), cc->InputTimestamp());
+  // Hand out boxes to the scheduled stickers that have none, seeding them where
+  // the motion filter expects them, and park all others. New boxes pick up any
+  // change in the sticker's footprint
+  const absl::flat_hash_set<int> scheduled_ids = scheduler.Schedule();
+  for (int i = 0; i < num_anchors; ++i) {
+    const int sticker_id = current_anchor_data[i].sticker_id;
+    auto sticker = tracked_stickers.find(sticker_id);
+    if (sticker == tracked_stickers.end()) {
+      continue;
+    }
+    TrackedSticker& state = sticker->second;
+    if (scheduled_ids.contains(sticker_id)) {
+      if (!state.has_box) {
+        const Anchor& anchor = tracked_scaled_anchor_data[i];
+        state.box_geometry = GetStickerBoxGeometry(sticker_id, i);
+        AddTrackingBox(anchor, state.box_geometry, time_msec, pos_boxes.get());
+        state.has_box = true;
+      }
+    } else if (state.has_box) {
+      cancel_ids->push_back(sticker_id);
+      state.has_box = false;
+    }
+  }
+  // Stop following removed stickers
+  for (auto it = tracked_stickers.begin(); it != tracked_stickers.end();) {
+    if (!anchor_ids.contains(it->first)) {
+      tracked_stickers.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+
+  cc->Outputs().Tag(kAnchorsTag).Add(
+      new std::vector<Anchor>(std::move(tracked_scaled_anchor_data)),
+      timestamp);
+  cc->Outputs().Tag(kBoxesOutputTag).Add(pos_boxes.release(), timestamp);
+  if (cc->Outputs().HasTag(kCancelTag) && !cancel_ids->empty()) {
+    cc->Outputs().Tag(kCancelTag).Add(cancel_ids.release(), timestamp);
+  }
 
   return ::mediapipe::OkStatus();
 }
+
+void TrackedAnchorManagerCalculator::CompensateImuRotation(
+    const Eigen::Matrix3f& imu_rotation) {
+  if (has_previous_imu_rotation) {
+    for (auto& sticker : tracked_stickers) {
+      AnchorMotionFilter& filter = sticker.second.motion_filter;
+      float x = filter.x();
+      float y = filter.y();
+      if (RotateScreenPoint(previous_imu_rotation, imu_rotation, tan_half_fov_x,
+                            tan_half_fov_y, &x, &y)) {
+        filter.Translate(x - filter.x(), y - filter.y());
+      }
+    }
+  }
+  previous_imu_rotation = imu_rotation;
+  has_previous_imu_rotation = true;
+}
+
+BoxGeometry TrackedAnchorManagerCalculator::GetStickerBoxGeometry(
+    int sticker_id, int anchor_index) const {
+  auto user_scale_factor = user_scale_factors.find(sticker_id);
+  const float scale_factor = user_scale_factor != user_scale_factors.end()
+                                 ? user_scale_factor->second
+                                 : 1.0f;
+  // Only GIF stickers (render ID 0) are stretched to their image aspect ratio
+  const bool is_gif = anchor_index < static_cast<int>(render_data.size()) &&
+                      render_data[anchor_index] == 0;
+  return GetBoxGeometry(scale_factor, is_gif ? gif_aspect_ratio : 1.0f,
+                        screen_aspect_ratio);
+}
 }
@@ -0,0 +1,246 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <deque>
+#include <utility>
+
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/util/tracking/camera_motion.pb.h"
+
+namespace mediapipe {
+
+constexpr char kVideoTag[] = "VIDEO";
+constexpr char kCameraMotionTag[] = "CAMERA";
+constexpr char kReadbackTag[] = "READBACK";
+constexpr char kOutputDimensionsTag[] = "OUTPUT_DIMENSIONS";
+constexpr char kLatencyBudgetSidePacketTag[] = "LATENCY_BUDGET_MS";
+
+// Analysis resolutions to choose from, in increasing order
+constexpr int kNumTiers = 3;
+constexpr int kTierWidths[kNumTiers] = {160, 240, 360};
+constexpr int kTierHeights[kNumTiers] = {213, 320, 480};
+// Tier of the first stream, matching the former fixed resolution
+constexpr int kInitialTier = 1;
+// Latency from a frame being read back to its camera motion being estimated,
+// unless LATENCY_BUDGET_MS says otherwise
+constexpr float kDefaultLatencyBudgetMs = 50.0f;
+// Resolution is raised while latency stays below this fraction of the budget
+constexpr float kUpgradeLatencyFraction = 0.6f;
+// Resolution is lowered past this fraction of the budget even if tracking
+// quality is poor already
+constexpr float kForcedDowngradeLatencyFraction = 1.5f;
+// Below this fraction of inliers, tracking quality is considered poor
+constexpr float kMinInlierRatio = 0.3f;
+// Smoothing factor of the exponential moving averages, per frame
+constexpr float kSmoothing = 0.1f;
+// Number of frames to measure a tier for before recommending another one
+constexpr int kMinFramesPerTier = 30;
+
+// Tier recommended from the measurements of the last stream, which the next
+// stream in this process starts at
+std::atomic<int>& RecommendedTier() {
+  static std::atomic<int> recommended_tier(kInitialTier);
+  return recommended_tier;
+}
+
+// This calculator picks the resolution of the frames analyzed for tracking
+// among a few preset tiers, from the measured tracking latency and quality.
+// A lower resolution is recommended when frames take longer than the latency
+// budget to be analyzed, unless tracking already struggles with too few
+// inliers, and a higher one while there is plenty of headroom. Both
+// measurements are smoothed, and taken over a minimum number of frames.
+//
+// The resolution never changes within a stream: MotionAnalysisCalculator sizes
+// itself from the first frame it analyzes, and ImuSeedHomographyCalculator
+// expects consecutive frames of the same size. The tier is thus picked once,
+// before the first frame, from the recommendation of the previous stream in
+// the same process, and moves by at most one tier per stream. Streams started
+// after the app is brought back, or the graph is restarted, adapt to the
+// device that way.
+//
+// Latency is measured from the arrival of each frame on READBACK when given,
+// so that it only covers the analysis itself. Frames delivered late by an
+// asynchronous readback would otherwise count the time to the next frame as
+// latency, which grows as the frame rate drops regardless of the resolution.
+//
+// Input:
+//  VIDEO - Frames entering the tracking subgraph, of any type. Only their
+//  timestamps, and arrival times unless READBACK is given, are used [REQUIRED]
+//  CAMERA - CameraMotion estimated for each analyzed frame, used for the
+//  latency and the inlier ratio [REQUIRED - back edge]
+//  READBACK - Frames as handed to motion analysis, of any type. Only their
+//  timestamps and arrival times are used [OPTIONAL - back edge]
+// Input Side Packets:
+//  LATENCY_BUDGET_MS - Budget for the analysis latency, in milliseconds
+//  (default 50) [OPTIONAL]
+// Output:
+//  OUTPUT_DIMENSIONS - std::pair<int, int> of width and height to scale each
+//  frame to, the same for the whole stream [REQUIRED]
+//
+// Example config:
+// node {
+//   calculator: "TrackingResolutionControllerCalculator"
+//   input_stream: "VIDEO:input_video"
+//   input_stream: "CAMERA:camera_motion"
+//   input_stream: "READBACK:input_video_gray"
+//   input_stream_info: {
+//     tag_index: 'CAMERA'
+//     back_edge: true
+//   }
+//   input_stream_info: {
+//     tag_index: 'READBACK'
+//     back_edge: true
+//   }
+//   input_stream_handler {
+//     input_stream_handler: "ImmediateInputStreamHandler"
+//   }
+//   output_stream: "OUTPUT_DIMENSIONS:tracking_dimensions"
+// }
+
+class TrackingResolutionControllerCalculator : public CalculatorBase {
+private:
+  float latency_budget_ms = kDefaultLatencyBudgetMs;
+  // Tier of this stream, picked in Open()
+  int tier = kInitialTier;
+  int frames_at_tier = 0;
+  // Smoothed measurements of this stream, valid once measured
+  float latency_ms = 0.0f;
+  float inlier_ratio = 0.0f;
+  bool has_measurements = false;
+  // True if latency is measured from READBACK rather than VIDEO
+  bool has_readback = false;
+  // Timestamps and arrival times of frames still being analyzed
+  std::deque<std::pair<Timestamp, absl::Time>> frame_arrivals;
+
+  // Folds the camera motion of an analyzed frame into the measurements
+  void AddMeasurement(const CameraMotion& camera_motion, Timestamp timestamp);
+  // Recommends the tier the measurements call for to the next stream
+  void UpdateRecommendedTier();
+
+public:
+  static ::mediapipe::Status GetContract(CalculatorContract* cc) {
+    RET_CHECK(cc->Inputs().HasTag(kVideoTag)
+      && cc->Inputs().HasTag(kCameraMotionTag));
+    RET_CHECK(cc->Outputs().HasTag(kOutputDimensionsTag));
+
+    cc->Inputs().Tag(kVideoTag).SetAny();
+    cc->Inputs().Tag(kCameraMotionTag).Set<CameraMotion>();
+    if (cc->Inputs().HasTag(kReadbackTag)) {
+      cc->Inputs().Tag(kReadbackTag).SetAny();
+    }
+    if (cc->InputSidePackets().HasTag(kLatencyBudgetSidePacketTag)) {
+      cc->InputSidePackets().Tag(kLatencyBudgetSidePacketTag).Set<float>();
+    }
+    cc->Outputs().Tag(kOutputDimensionsTag).Set<std::pair<int, int>>();
+
+    return ::mediapipe::OkStatus();
+  }
+
+  ::mediapipe::Status Open(CalculatorContext* cc) override {
+    has_readback = cc->Inputs().HasTag(kReadbackTag);
+    if (cc->InputSidePackets().HasTag(kLatencyBudgetSidePacketTag)) {
+      latency_budget_ms =
+          cc->InputSidePackets().Tag(kLatencyBudgetSidePacketTag).Get<float>();
+      RET_CHECK_GT(latency_budget_ms, 0.0f);
+    }
+    tier = RecommendedTier().load();
+    VLOG(1) << "Tracking at " << kTierWidths[tier] << "x"
+            << kTierHeights[tier];
+    return ::mediapipe::OkStatus();
+  }
+
+  ::mediapipe::Status Process(CalculatorContext* cc) override;
+};
+REGISTER_CALCULATOR(TrackingResolutionControllerCalculator);
+
+::mediapipe::Status TrackingResolutionControllerCalculator::Process(
+    CalculatorContext* cc) {
+  // A frame's readback is recorded before its camera motion, in case both
+  // come in together
+  if (has_readback && !cc->Inputs().Tag(kReadbackTag).IsEmpty()) {
+    frame_arrivals.emplace_back(
+        cc->Inputs().Tag(kReadbackTag).Value().Timestamp(), absl::Now());
+  }
+
+  if (!cc->Inputs().Tag(kCameraMotionTag).IsEmpty()) {
+    AddMeasurement(cc->Inputs().Tag(kCameraMotionTag).Get<CameraMotion>(),
+                   cc->Inputs().Tag(kCameraMotionTag).Value().Timestamp());
+  }
+
+  if (!cc->Inputs().Tag(kVideoTag).IsEmpty()) {
+    const Timestamp timestamp = cc->Inputs().Tag(kVideoTag).Value().Timestamp();
+    if (!has_readback) {
+      frame_arrivals.emplace_back(timestamp, absl::Now());
+    }
+    UpdateRecommendedTier();
+    cc->Outputs().Tag(kOutputDimensionsTag).Add(
+        new std::pair<int, int>(kTierWidths[tier], kTierHeights[tier]),
+        timestamp);
+  }
+
+  return ::mediapipe::OkStatus();
+}
+
+void TrackingResolutionControllerCalculator::AddMeasurement(
+    const CameraMotion& camera_motion, Timestamp timestamp) {
+  // Frames without camera motion were dropped along the way
+  while (!frame_arrivals.empty() && frame_arrivals.front().first < timestamp) {
+    frame_arrivals.pop_front();
+  }
+  if (frame_arrivals.empty() || frame_arrivals.front().first != timestamp) {
+    return;
+  }
+  const float frame_latency_ms = absl::ToDoubleMilliseconds(
+      absl::Now() - frame_arrivals.front().second);
+  frame_arrivals.pop_front();
+
+  const float frame_inlier_ratio = camera_motion.similarity_inlier_ratio();
+  if (!has_measurements) {
+    latency_ms = frame_latency_ms;
+    inlier_ratio = frame_inlier_ratio;
+    has_measurements = true;
+  } else {
+    latency_ms += kSmoothing * (frame_latency_ms - latency_ms);
+    inlier_ratio += kSmoothing * (frame_inlier_ratio - inlier_ratio);
+  }
+}
+
+void TrackingResolutionControllerCalculator::UpdateRecommendedTier() {
+  ++frames_at_tier;
+  if (!has_measurements || frames_at_tier < kMinFramesPerTier) {
+    return;
+  }
+
+  int new_tier = tier;
+  if (latency_ms > latency_budget_ms && tier > 0 &&
+      (inlier_ratio >= kMinInlierRatio ||
+       latency_ms > kForcedDowngradeLatencyFraction * latency_budget_ms)) {
+    new_tier = tier - 1;
+  } else if (latency_ms < kUpgradeLatencyFraction * latency_budget_ms &&
+             tier < kNumTiers - 1) {
+    new_tier = tier + 1;
+  }
+  if (RecommendedTier().exchange(new_tier) != new_tier) {
+    VLOG(1) << "Recommending tracking resolution " << kTierWidths[new_tier]
+            << "x" << kTierHeights[new_tier] << " at " << latency_ms
+            << " ms latency and " << inlier_ratio << " inlier ratio";
+  }
+}
+}
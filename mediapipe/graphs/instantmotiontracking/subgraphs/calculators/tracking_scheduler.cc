@@ -0,0 +1,94 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/graphs/instantmotiontracking/subgraphs/calculators/tracking_scheduler.h"
+
+#include <algorithm>
+
+namespace mediapipe {
+
+namespace {
+
+// Cadences, in frames between measurements
+constexpr int kMovingCadence = 1;
+constexpr int kStaticCadence = 4;
+constexpr int kOffscreenCadence = 8;
+// Stickers slower than this, in normalized screen (or log scale) units per
+// second, are considered static
+constexpr float kStaticSpeed = 0.05f;
+// Stickers with a tracking box smaller than this normalized area hardly move
+// on screen in absolute terms, so they are measured as rarely as static ones
+constexpr float kSmallScreenArea = 0.01f;
+
+}  // namespace
+
+// static
+int TrackingScheduler::GetCadence(bool visible, float screen_area,
+                                  float speed) {
+  if (!visible) {
+    return kOffscreenCadence;
+  }
+  if (speed < kStaticSpeed || screen_area < kSmallScreenArea) {
+    return kStaticCadence;
+  }
+  return kMovingCadence;
+}
+
+void TrackingScheduler::AddSticker(int sticker_id, bool visible,
+                                   float screen_area, float speed,
+                                   int frames_since_measurement, bool has_box,
+                                   bool forced) {
+  Candidate candidate;
+  candidate.sticker_id = sticker_id;
+  candidate.visible = visible;
+  candidate.screen_area = screen_area;
+  candidate.has_box = has_box;
+  candidate.forced = forced;
+  candidate.urgency = static_cast<float>(frames_since_measurement + 1) /
+                      GetCadence(visible, screen_area, speed);
+  candidates_.push_back(candidate);
+}
+
+absl::flat_hash_set<int> TrackingScheduler::Schedule() {
+  // Forced stickers first, then all others by decreasing urgency. Among
+  // equally urgent ones, stickers that already hold a box go first, as they
+  // need no new box, then visible and larger ones
+  std::sort(candidates_.begin(), candidates_.end(),
+            [](const Candidate& a, const Candidate& b) {
+              if (a.forced != b.forced) return a.forced;
+              if (a.urgency != b.urgency) return a.urgency > b.urgency;
+              if (a.has_box != b.has_box) return a.has_box;
+              if (a.visible != b.visible) return a.visible;
+              return a.screen_area > b.screen_area;
+            });
+  absl::flat_hash_set<int> tracked_ids;
+  for (const Candidate& candidate : candidates_) {
+    if (!candidate.forced) {
+      // Stickers that are not due only keep the box they hold, if visible
+      if (candidate.urgency < 1.0f &&
+          !(candidate.has_box && candidate.visible)) {
+        continue;
+      }
+      if (max_tracked_boxes_ > 0 &&
+          static_cast<int>(tracked_ids.size()) >= max_tracked_boxes_) {
+        break;
+      }
+    }
+    tracked_ids.insert(candidate.sticker_id);
+  }
+  candidates_.clear();
+  return tracked_ids;
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,78 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_SUBGRAPHS_CALCULATORS_TRACKING_SCHEDULER_H_
+#define MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_SUBGRAPHS_CALCULATORS_TRACKING_SCHEDULER_H_
+
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+
+namespace mediapipe {
+
+// Decides, once per frame, which stickers hold a box in the box tracker until
+// the next frame. Every sticker is given a cadence, the number of frames
+// between two measurements, from its visibility, screen size and motion:
+// visible, moving stickers are measured every frame, while static, tiny or
+// off-screen stickers are only measured every few frames, and extrapolated in
+// between. Tracking cost grows with the number of boxes being tracked, so at
+// most max_tracked_boxes boxes are handed out per frame.
+//
+// Boxes go to stickers by decreasing urgency, so a sticker that is kept
+// waiting grows more urgent every frame until it outranks the stickers that
+// were just measured, whether it is visible or not. Visible stickers that
+// already hold a box keep it while there is room, even when not due, so that
+// static stickers keep their track instead of having it canceled and
+// re-initialized every few frames; they only give up their box to more urgent
+// stickers when the budget runs out.
+class TrackingScheduler {
+ public:
+  // A non-positive max_tracked_boxes removes the limit.
+  explicit TrackingScheduler(int max_tracked_boxes)
+      : max_tracked_boxes_(max_tracked_boxes) {}
+
+  // Adds a sticker to schedule for the next frame. screen_area is the
+  // normalized area of its tracking box, and speed combines its normalized
+  // screen and log scale velocities, per second. has_box tells whether the
+  // tracker currently holds a box for the sticker. Forced stickers, such as
+  // those the user just placed, are always tracked.
+  void AddSticker(int sticker_id, bool visible, float screen_area, float speed,
+                  int frames_since_measurement, bool has_box, bool forced);
+
+  // Returns the IDs of the stickers to track until the next frame, and forgets
+  // the stickers added so far.
+  absl::flat_hash_set<int> Schedule();
+
+  // Number of frames between measurements of a sticker
+  static int GetCadence(bool visible, float screen_area, float speed);
+
+ private:
+  struct Candidate {
+    int sticker_id;
+    bool visible;
+    float screen_area;
+    bool has_box;
+    bool forced;
+    // Fraction of the cadence that will have passed since the last
+    // measurement by the next frame, at least 1.0 once the sticker is due
+    float urgency;
+  };
+
+  int max_tracked_boxes_;
+  std::vector<Candidate> candidates_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_GRAPHS_INSTANTMOTIONTRACKING_SUBGRAPHS_CALCULATORS_TRACKING_SCHEDULER_H_
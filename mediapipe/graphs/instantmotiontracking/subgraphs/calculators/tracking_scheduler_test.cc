@@ -0,0 +1,163 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/graphs/instantmotiontracking/subgraphs/calculators/tracking_scheduler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::UnorderedElementsAre;
+
+// Normalized box area and speed of a visible sticker moving across the screen
+constexpr float kLargeArea = 0.04f;
+constexpr float kFastSpeed = 0.5f;
+// Speed of a sticker at rest
+constexpr float kStillSpeed = 0.0f;
+
+// Scheduling state of a sticker across simulated frames
+struct SimulatedSticker {
+  int sticker_id;
+  bool visible;
+  float speed;
+  int frames_since_measurement;
+  bool has_box;
+};
+
+// Schedules one frame of the given stickers, and updates their state as
+// TrackedAnchorManagerCalculator would: scheduled stickers hold a box and are
+// measured, the others are parked. Returns the scheduled sticker IDs.
+absl::flat_hash_set<int> ScheduleFrame(std::vector<SimulatedSticker>* stickers,
+                                       TrackingScheduler* scheduler) {
+  for (const SimulatedSticker& sticker : *stickers) {
+    scheduler->AddSticker(sticker.sticker_id, sticker.visible, kLargeArea,
+                          sticker.speed, sticker.frames_since_measurement,
+                          sticker.has_box, /*forced=*/false);
+  }
+  const absl::flat_hash_set<int> scheduled_ids = scheduler->Schedule();
+  for (SimulatedSticker& sticker : *stickers) {
+    sticker.has_box = scheduled_ids.contains(sticker.sticker_id);
+    if (sticker.has_box) {
+      sticker.frames_since_measurement = 0;
+    } else {
+      ++sticker.frames_since_measurement;
+    }
+  }
+  return scheduled_ids;
+}
+
+TEST(TrackingSchedulerTest, CadenceFollowsVisibilitySizeAndSpeed) {
+  const int moving =
+      TrackingScheduler::GetCadence(true, kLargeArea, kFastSpeed);
+  const int still =
+      TrackingScheduler::GetCadence(true, kLargeArea, kStillSpeed);
+  const int tiny = TrackingScheduler::GetCadence(true, 0.001f, kFastSpeed);
+  const int offscreen =
+      TrackingScheduler::GetCadence(false, kLargeArea, kFastSpeed);
+  EXPECT_EQ(moving, 1);
+  EXPECT_GT(still, moving);
+  EXPECT_EQ(tiny, still);
+  EXPECT_GT(offscreen, still);
+}
+
+TEST(TrackingSchedulerTest, SeedsParkedStickersWhenDue) {
+  const int cadence =
+      TrackingScheduler::GetCadence(true, kLargeArea, kStillSpeed);
+  TrackingScheduler scheduler(0);
+  scheduler.AddSticker(1, true, kLargeArea, kStillSpeed, cadence - 2,
+                       /*has_box=*/false, /*forced=*/false);
+  scheduler.AddSticker(2, true, kLargeArea, kStillSpeed, cadence - 1,
+                       /*has_box=*/false, /*forced=*/false);
+  scheduler.AddSticker(3, false, kLargeArea, kFastSpeed, cadence - 1,
+                       /*has_box=*/false, /*forced=*/false);
+  EXPECT_THAT(scheduler.Schedule(), UnorderedElementsAre(2));
+}
+
+TEST(TrackingSchedulerTest, KeepsBoxesOfVisibleStaticStickers) {
+  std::vector<SimulatedSticker> stickers = {
+      {1, true, kStillSpeed, 0, true},
+      {2, false, kFastSpeed, 0, true},
+  };
+  TrackingScheduler scheduler(0);
+  for (int frame = 0; frame < 10; ++frame) {
+    ScheduleFrame(&stickers, &scheduler);
+    // The static sticker is never canceled and re-seeded
+    EXPECT_TRUE(stickers[0].has_box) << "frame " << frame;
+  }
+  // The off-screen sticker was parked
+  EXPECT_FALSE(stickers[1].has_box);
+}
+
+TEST(TrackingSchedulerTest, LimitsBoxesToBudget) {
+  TrackingScheduler scheduler(2);
+  for (int sticker_id = 1; sticker_id <= 4; ++sticker_id) {
+    scheduler.AddSticker(sticker_id, true, kLargeArea, kFastSpeed,
+                         sticker_id - 1, /*has_box=*/false, /*forced=*/false);
+  }
+  scheduler.AddSticker(5, true, kLargeArea, kFastSpeed, 0, /*has_box=*/false,
+                       /*forced=*/true);
+  // The forced sticker is tracked first, and the most overdue sticker gets the
+  // remaining box
+  EXPECT_THAT(scheduler.Schedule(), UnorderedElementsAre(5, 4));
+  // Scheduling forgets the stickers added so far
+  EXPECT_TRUE(scheduler.Schedule().empty());
+}
+
+TEST(TrackingSchedulerTest, StaticStickersYieldBoxesToDueOnes) {
+  TrackingScheduler scheduler(1);
+  scheduler.AddSticker(1, true, kLargeArea, kStillSpeed, 0, /*has_box=*/true,
+                       /*forced=*/false);
+  scheduler.AddSticker(2, true, kLargeArea, kFastSpeed, 0, /*has_box=*/false,
+                       /*forced=*/false);
+  EXPECT_THAT(scheduler.Schedule(), UnorderedElementsAre(2));
+}
+
+TEST(TrackingSchedulerTest, DoesNotStarveOffscreenStickers) {
+  // As many visible, moving stickers as there are boxes, all due every frame,
+  // and one off-screen sticker
+  constexpr int kMaxTrackedBoxes = 3;
+  std::vector<SimulatedSticker> stickers = {
+      {1, true, kFastSpeed, 0, true},
+      {2, true, kFastSpeed, 0, true},
+      {3, true, kFastSpeed, 0, true},
+      {4, false, kFastSpeed, 0, false},
+  };
+  const int offscreen_cadence =
+      TrackingScheduler::GetCadence(false, kLargeArea, kFastSpeed);
+  TrackingScheduler scheduler(kMaxTrackedBoxes);
+  int offscreen_measurements = 0;
+  int longest_wait = 0;
+  for (int frame = 0; frame < 10 * offscreen_cadence; ++frame) {
+    const absl::flat_hash_set<int> scheduled_ids =
+        ScheduleFrame(&stickers, &scheduler);
+    EXPECT_EQ(scheduled_ids.size(), static_cast<size_t>(kMaxTrackedBoxes));
+    if (scheduled_ids.contains(4)) {
+      ++offscreen_measurements;
+    }
+    for (const SimulatedSticker& sticker : stickers) {
+      longest_wait = std::max(longest_wait, sticker.frames_since_measurement);
+    }
+  }
+  EXPECT_GE(offscreen_measurements, 7);
+  // Nobody waits much longer than the off-screen cadence
+  EXPECT_LE(longest_wait, offscreen_cadence + 1);
+}
+
+}  // namespace
+}  // namespace mediapipe